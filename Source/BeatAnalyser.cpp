@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.cpp
+    Created: 25 Oct 2026 10:14:52am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "BeatAnalyser.h"
+
+namespace
+{
+    constexpr double framesPerSecond = 100.0;
+    constexpr double bassCutoffHz = 150.0;
+
+    // Subtract the mean of the surrounding frames and keep only what stands out of it
+    void removeLocalMean(std::vector<float>& values, int radius)
+    {
+        const size_t numValues = values.size();
+        std::vector<double> prefix(numValues + 1, 0.0);
+
+        for (size_t n = 0; n < numValues; ++n)
+            prefix[n + 1] = prefix[n] + values[n];
+
+        for (size_t n = 0; n < numValues; ++n)
+        {
+            const size_t first = n > (size_t) radius ? n - (size_t) radius : 0;
+            const size_t last = jmin(numValues, n + (size_t) radius + 1);
+            const double mean = (prefix[last] - prefix[first]) / static_cast<double>(last - first);
+            values[n] = jmax(0.0f, static_cast<float>(values[n] - mean));
+        }
+    }
+
+    double autocorrelation(const std::vector<float>& values, int lag)
+    {
+        const size_t numProducts = values.size() - (size_t) lag;
+        double sum = 0.0;
+
+        for (size_t n = 0; n < numProducts; ++n)
+            sum += values[n] * values[n + (size_t) lag];
+
+        return sum / static_cast<double>(numProducts);
+    }
+
+    // Mean value at every beat of a grid, which peaks when the grid lands on the onsets
+    double combStrength(const std::vector<float>& values, double period, double phase)
+    {
+        const double last = static_cast<double>(values.size()) - 0.5;
+        double sum = 0.0;
+        int count = 0;
+
+        for (double t = phase; t < last; t += period)
+        {
+            sum += values[(size_t) (t + 0.5)];
+            ++count;
+        }
+
+        return count > 0 ? sum / count : 0.0;
+    }
+
+    // Offset of the peak of a parabola through three equally spaced points, in [-0.5, 0.5]
+    double parabolicPeak(double before, double peak, double after)
+    {
+        const double curvature = before - 2.0 * peak + after;
+        return curvature < 0.0 ? jlimit(-0.5, 0.5, 0.5 * (before - after) / curvature) : 0.0;
+    }
+}
+
+//==============================================================================
+BeatAnalyser::BeatAnalyser(double sampleRate, juce::int64 lengthInSamples)
+    : hop(jmax(1, roundToInt(sampleRate / framesPerSecond)))
+{
+    frameRate = sampleRate / hop;
+    strengthEnvelope.reserve(static_cast<size_t>(lengthInSamples / hop) + 1);
+    bassEnvelope.reserve(strengthEnvelope.capacity());
+    bassCoefficient = static_cast<float>(1.0 - std::exp(-MathConstants<double>::twoPi * bassCutoffHz / sampleRate));
+}
+
+BeatAnalyser::~BeatAnalyser()
+{
+}
+
+// Keep only the rise in log energy of every frame
+void BeatAnalyser::process(const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float sample = samples[i];
+        bass += bassCoefficient * (sample - bass);
+        fullEnergy += sample * sample;
+        bassEnergy += bass * bass;
+
+        if (++samplesInFrame < hop)
+            continue;
+
+        // Log compression makes quiet and loud passages rise by comparable amounts
+        const float full = std::log1p(1000.0f * fullEnergy / hop);
+        const float low = std::log1p(1000.0f * bassEnergy / hop);
+        const float bassRise = jmax(0.0f, low - previousBass);
+
+        strengthEnvelope.push_back(jmax(0.0f, full - previousFull) + bassRise);
+        bassEnvelope.push_back(bassRise);
+
+        previousFull = full;
+        previousBass = low;
+        fullEnergy = 0.0f;
+        bassEnergy = 0.0f;
+        samplesInFrame = 0;
+    }
+}
+
+BeatAnalyser::Result BeatAnalyser::getResult()
+{
+    Result result;
+
+    const int minimumLag = jmax(1, static_cast<int>(std::floor(frameRate * 60.0 / maximumBpm)));
+    const int maximumLag = static_cast<int>(std::ceil(frameRate * 60.0 / minimumBpm));
+
+    // At least eight bars at the slowest tempo are needed to trust a periodicity
+    if (strengthEnvelope.size() < (size_t) (32 * maximumLag))
+        return result;
+
+    const int meanRadius = roundToInt(frameRate * 0.25);
+    removeLocalMean(strengthEnvelope, meanRadius);
+    removeLocalMean(bassEnvelope, meanRadius);
+
+    // Coarse tempo: the lag whose autocorrelation, reinforced by its double, is strongest.
+    // A gentle preference for tempos near 120 BPM settles half and double tempo ties.
+    std::vector<double> correlations((size_t) (2 * maximumLag + 1), 0.0);
+
+    for (int lag = minimumLag; lag <= 2 * maximumLag; ++lag)
+        correlations[(size_t) lag] = autocorrelation(strengthEnvelope, lag);
+
+    std::vector<double> scores((size_t) (maximumLag + 1), 0.0);
+    int bestLag = minimumLag;
+
+    for (int lag = minimumLag; lag <= maximumLag; ++lag)
+    {
+        const double octavesFrom120 = std::log2(frameRate * 60.0 / lag / 120.0);
+        const double preference = std::exp(-0.5 * octavesFrom120 * octavesFrom120 / 0.49);
+        scores[(size_t) lag] = (correlations[(size_t) lag] + 0.5 * correlations[(size_t) (2 * lag)]) * preference;
+
+        if (scores[(size_t) lag] > scores[(size_t) bestLag])
+            bestLag = lag;
+    }
+
+    double coarseLag = bestLag;
+
+    if (bestLag > minimumLag && bestLag < maximumLag)
+        coarseLag += parabolicPeak(scores[(size_t) (bestLag - 1)], scores[(size_t) bestLag], scores[(size_t) (bestLag + 1)]);
+
+    // Fine tempo and phase together: slide grids 0.01 BPM apart over the onsets of the whole track
+    const double coarseBpm = frameRate * 60.0 / coarseLag;
+    double bestPeriod = coarseLag;
+    double bestPhase = 0.0;
+    double bestStrength = 0.0;
+
+    for (double bpm = coarseBpm * 0.985; bpm <= coarseBpm * 1.015; bpm += 0.01)
+    {
+        const double period = frameRate * 60.0 / bpm;
+
+        for (int phase = 0; phase < static_cast<int>(period); ++phase)
+        {
+            const double strength = combStrength(strengthEnvelope, period, phase);
+
+            if (strength > bestStrength)
+            {
+                bestStrength = strength;
+                bestPeriod = period;
+                bestPhase = phase;
+            }
+        }
+    }
+
+    // A grid no stronger than the average frame means the track has no steady beat
+    double meanStrength = 0.0;
+
+    for (float value : strengthEnvelope)
+        meanStrength += value;
+
+    meanStrength /= static_cast<double>(strengthEnvelope.size());
+
+    if (bestStrength <= 1.5 * meanStrength)
+        return result;
+
+    auto wrapPhase = [bestPeriod](double phase) { return std::fmod(phase + bestPeriod, bestPeriod); };
+
+    bestPhase = wrapPhase(bestPhase + parabolicPeak(combStrength(strengthEnvelope, bestPeriod, wrapPhase(bestPhase - 1.0)),
+                                                    bestStrength,
+                                                    combStrength(strengthEnvelope, bestPeriod, wrapPhase(bestPhase + 1.0))));
+
+    // The downbeat is the beat of the bar that carries the most bass onsets
+    int downbeat = 0;
+    double downbeatStrength = -1.0;
+
+    for (int beat = 0; beat < 4; ++beat)
+    {
+        const double strength = combStrength(bassEnvelope, 4.0 * bestPeriod, bestPhase + beat * bestPeriod);
+
+        if (strength > downbeatStrength)
+        {
+            downbeatStrength = strength;
+            downbeat = beat;
+        }
+    }
+
+    result.Bpm = frameRate * 60.0 / bestPeriod;
+    result.FirstBeatSeconds = (bestPhase + downbeat * bestPeriod) / frameRate;
+    result.WasAnalysed = true;
+    return result;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    BeatAnalyser.h
+    Created: 25 Oct 2026 10:14:52am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * The BeatAnalyser class estimates the tempo and beat grid of a track from its samples.
+ *
+ * The ContentAnalyser decodes a track once and hands the mono mix to this class block
+ * by block, together with the key and loudness analysers. Every block is reduced to
+ * an onset envelope of 100 frames per second, so memory stays bounded whatever the
+ * track length. The tempo is the strongest periodicity of the envelope between 70 and
+ * 180 BPM, refined together with the beat phase against the onsets of the whole track.
+ * The downbeat is the beat of the bar with the most bass onsets.
+ */
+class BeatAnalyser
+{
+public:
+    /**
+     * The beat grid of a single track. The beat period is 60 / Bpm seconds.
+     */
+    struct Result
+    {
+        double Bpm = 0.0;
+        double FirstBeatSeconds = 0.0;
+        bool WasAnalysed = false;
+    };
+
+    /**
+     * Constructor for BeatAnalyser.
+     *
+     * @param sampleRate      The sample rate of the track.
+     * @param lengthInSamples The length of the track, used to size the envelope up front.
+     */
+    BeatAnalyser(double sampleRate, juce::int64 lengthInSamples);
+
+    /**
+     * Destructor for BeatAnalyser.
+     */
+    ~BeatAnalyser();
+
+    /**
+     * Add the next block of the track to the onset envelope.
+     *
+     * @param samples    The mono mix of the block.
+     * @param numSamples The number of samples in the block.
+     */
+    void process(const float* samples, int numSamples);
+
+    /**
+     * Find the beat grid of everything processed so far. Call once, after the last block.
+     *
+     * @return The tempo and first downbeat, WasAnalysed is false if the track
+     *         is too short or has no steady beat.
+     */
+    Result getResult();
+
+    /**
+     * The tempo range results are folded into.
+     */
+    static constexpr double minimumBpm = 70.0;
+    static constexpr double maximumBpm = 180.0;
+
+private:
+    /**
+     * Onset strength per frame for the whole track, and for the bass band alone.
+     */
+    std::vector<float> strengthEnvelope;
+    std::vector<float> bassEnvelope;
+    double frameRate = 0.0;
+    int hop = 1;
+
+    /**
+     * Running state of the frame being filled.
+     */
+    float bassCoefficient = 0.0f;
+    float bass = 0.0f;
+    float fullEnergy = 0.0f;
+    float bassEnergy = 0.0f;
+    float previousFull = 0.0f;
+    float previousBass = 0.0f;
+    int samplesInFrame = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BeatAnalyser)
+};
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    BeatGrid.h
+    Created: 25 Oct 2026 2:21:08pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cmath>
+
+/**
+ * The BeatGrid struct describes where the beats of a track fall: a tempo and the
+ * time of the first downbeat, with a beat every 60 / bpm seconds from there on.
+ *
+ * Positions on the grid are measured in beats, so beat 0 is the first downbeat
+ * and a fractional part is the phase within a beat.
+ */
+struct BeatGrid
+{
+    double bpm = 0.0;
+    double firstBeatSeconds = 0.0;
+
+    /**
+     * Check whether the grid has been analysed.
+     */
+    bool isValid() const noexcept { return bpm > 0.0; }
+
+    /**
+     * Get the length of one beat in seconds.
+     */
+    double getPeriodSeconds() const noexcept { return 60.0 / bpm; }
+
+    /**
+     * Get the position on the grid of a time in the track, in beats.
+     */
+    double getBeatAt(double seconds) const noexcept { return (seconds - firstBeatSeconds) / getPeriodSeconds(); }
+
+    /**
+     * Get the time in the track of a position on the grid.
+     */
+    double getTimeOfBeat(double beat) const noexcept { return firstBeatSeconds + beat * getPeriodSeconds(); }
+
+    /**
+     * Move a time in the track to the nearest beat.
+     */
+    double snapToNearestBeat(double seconds) const noexcept { return getTimeOfBeat(std::round(getBeatAt(seconds))); }
+};
@@ -0,0 +1,1177 @@
+/*
+  ==============================================================================
+
+    Benchmarks.cpp
+    Created: 18 Oct 2026 11:02:19am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "Benchmarks.h"
+#include "DeckResampler.h"
+#include "TimeStretcher.h"
+#include "ScrollingWaveform.h"
+#include "OtherLookAndFeel.h"
+#include "TrackSearchIndex.h"
+#include "TrackStore.h"
+#include "MixRenderer.h"
+#include "DeckMixer.h"
+#include "DJAudioPlayer.h"
+#include "TrackAnalyser.h"
+#include "ContentAnalyser.h"
+#include "LibraryIndex.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+    constexpr int blockSize = 512;
+    constexpr double sampleRate = 44100.0;
+
+    // Seconds taken by a callable, measured with the high resolution clock
+    template <typename Callable>
+    double timeInSeconds(Callable&& callable)
+    {
+        const int64 start = Time::getHighResolutionTicks();
+        callable();
+        return Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+    }
+
+    // Append one measured value to the report
+    void addMetric(Benchmarks::Metrics& metrics, const juce::String& benchmark, const juce::String& testCase,
+                   const juce::String& name, double value, const juce::String& unit)
+    {
+        metrics.push_back({ benchmark, testCase, name, value, unit });
+    }
+
+    // Write a synthetic stereo track: a chord with a little noise, optionally pulsing twice a second
+    bool writeSyntheticTrack(const File& file, AudioFormat& format, double seconds, double frequency, bool pulsing)
+    {
+        file.deleteFile();
+        std::unique_ptr<AudioFormatWriter> writer(format.createWriterFor(file.createOutputStream().release(), sampleRate, 2, 16, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        Random random(3);
+        AudioBuffer<float> buffer(2, blockSize);
+        const auto totalSamples = static_cast<int64>(seconds * sampleRate);
+
+        for (int64 start = 0; start < totalSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double t = (start + i) / sampleRate;
+                const double envelope = pulsing ? 0.5 + 0.5 * std::sin(MathConstants<double>::twoPi * 2.0 * t) : 1.0;
+                const float sample = static_cast<float>(0.3 * envelope * (std::sin(MathConstants<double>::twoPi * frequency * t)
+                                                                        + 0.5 * std::sin(MathConstants<double>::twoPi * frequency * 1.5 * t)))
+                                   + 0.02f * (random.nextFloat() - 0.5f);
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, static_cast<int>(jmin<int64>(blockSize, totalSamples - start)));
+        }
+
+        return true;
+    }
+
+    // Write a synthetic mono dance track: a kick on every beat, accented on the downbeat,
+    // an off-beat hat and a bass drone, with the first downbeat at firstBeatSeconds
+    bool writeSyntheticBeatTrack(const File& file, AudioFormat& format, double seconds, double bpm, double firstBeatSeconds)
+    {
+        file.deleteFile();
+        std::unique_ptr<AudioFormatWriter> writer(format.createWriterFor(file.createOutputStream().release(), sampleRate, 1, 16, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        Random random(5);
+        AudioBuffer<float> buffer(1, blockSize);
+        const double period = 60.0 / bpm;
+        const auto totalSamples = static_cast<int64>(seconds * sampleRate);
+
+        for (int64 start = 0; start < totalSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double t = (start + i) / sampleRate;
+                double sample = 0.05 * std::sin(MathConstants<double>::twoPi * 55.0 * t) + 0.02 * (random.nextFloat() - 0.5f);
+                const double sinceFirstBeat = t - firstBeatSeconds;
+
+                if (sinceFirstBeat >= 0.0)
+                {
+                    const double beat = std::floor(sinceFirstBeat / period);
+                    const double sinceBeat = sinceFirstBeat - beat * period;
+                    const double level = static_cast<int64>(beat) % 4 == 0 ? 0.7 : 0.45;
+
+                    // The kick sweeps down from 120 Hz to 50 Hz as it decays
+                    const double frequency = 50.0 + 70.0 * std::exp(-sinceBeat / 0.03);
+                    sample += level * std::exp(-sinceBeat / 0.15) * std::sin(MathConstants<double>::twoPi * frequency * sinceBeat);
+
+                    if (sinceBeat >= period * 0.5)
+                        sample += 0.1 * std::exp(-(sinceBeat - period * 0.5) / 0.02) * (random.nextFloat() * 2.0f - 1.0f);
+                }
+
+                buffer.setSample(0, i, static_cast<float>(sample));
+            }
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, static_cast<int>(jmin<int64>(blockSize, totalSamples - start)));
+        }
+
+        return true;
+    }
+
+    // Write a synthetic mono track cycling through the chords Am, Dm, Em and Am, two seconds
+    // each, with a root an octave down and a little noise. Its key is A minor.
+    bool writeSyntheticKeyTrack(const File& file, AudioFormat& format, double seconds)
+    {
+        file.deleteFile();
+        std::unique_ptr<AudioFormatWriter> writer(format.createWriterFor(file.createOutputStream().release(), sampleRate, 1, 16, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        const int chords[4][3] = { { 57, 60, 64 }, { 62, 65, 69 }, { 64, 67, 71 }, { 57, 60, 64 } };
+
+        Random random(7);
+        AudioBuffer<float> buffer(1, blockSize);
+        const auto totalSamples = static_cast<int64>(seconds * sampleRate);
+
+        for (int64 start = 0; start < totalSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double t = (start + i) / sampleRate;
+                const int* chord = chords[static_cast<int64>(t / 2.0) % 4];
+                double sample = 0.02 * (random.nextFloat() - 0.5f);
+
+                for (int note = 0; note < 3; ++note)
+                {
+                    const double frequency = MidiMessage::getMidiNoteInHertz(chord[note]);
+
+                    // Four harmonics, fading like a plucked string
+                    for (int harmonic = 1; harmonic <= 4; ++harmonic)
+                        sample += 0.03 / harmonic * std::sin(MathConstants<double>::twoPi * frequency * harmonic * t);
+                }
+
+                sample += 0.03 * std::sin(MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz(chord[0] - 12) * t);
+                buffer.setSample(0, i, static_cast<float>(sample));
+            }
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, static_cast<int>(jmin<int64>(blockSize, totalSamples - start)));
+        }
+
+        return true;
+    }
+
+    // Write a synthetic stereo sine at the same level in both channels, the EBU R128 reference signal
+    bool writeSineTrack(const File& file, AudioFormat& format, double seconds, double frequency, float amplitude)
+    {
+        file.deleteFile();
+        std::unique_ptr<AudioFormatWriter> writer(format.createWriterFor(file.createOutputStream().release(), sampleRate, 2, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        AudioBuffer<float> buffer(2, blockSize);
+        const auto totalSamples = static_cast<int64>(seconds * sampleRate);
+
+        for (int64 start = 0; start < totalSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const float sample = amplitude * static_cast<float>(std::sin(MathConstants<double>::twoPi * frequency * (start + i) / sampleRate));
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+
+            writer->writeFromAudioSampleBuffer(buffer, 0, static_cast<int>(jmin<int64>(blockSize, totalSamples - start)));
+        }
+
+        return true;
+    }
+}
+
+juce::String Benchmarks::runResamplerBenchmark(Metrics& metrics)
+{
+    const struct { DeckResampler::Mode mode; const char* name; } modes[] = {
+        { DeckResampler::Mode::linear, "linear" },
+        { DeckResampler::Mode::cubic,  "cubic" },
+        { DeckResampler::Mode::sinc,   "sinc" }
+    };
+    const double ratios[] = { 0.5, 1.0, 1.5, 2.0, 5.0 };
+    const int numBlocks = 4000;
+    const double cyclesPerSecond = SystemStats::getCpuSpeedInMegahertz() * 1.0e6;
+
+    juce::String report;
+    report << "DeckResampler, " << blockSize << "-sample stereo blocks at " << sampleRate << " Hz\n";
+    report << "mode    ratio   ns/frame   cycles/frame\n";
+
+    AudioBuffer<float> output(2, blockSize);
+
+    for (const auto& entry : modes)
+    {
+        for (double ratio : ratios)
+        {
+            ToneGeneratorAudioSource tone;
+            tone.setFrequency(440.0);
+
+            DeckResampler resampler(&tone);
+            resampler.prepareToPlay(blockSize, sampleRate);
+            resampler.setMode(entry.mode);
+            resampler.setResamplingRatio(ratio);
+
+            AudioSourceChannelInfo info(&output, 0, blockSize);
+
+            // Warm up caches and branch predictors before timing
+            for (int i = 0; i < 100; ++i)
+                resampler.getNextAudioBlock(info);
+
+            const double seconds = timeInSeconds([&]
+                {
+                    for (int i = 0; i < numBlocks; ++i)
+                        resampler.getNextAudioBlock(info);
+                });
+
+            const double secondsPerFrame = seconds / (static_cast<double>(numBlocks) * blockSize);
+
+            addMetric(metrics, "resampler", juce::String(entry.name) + " x" + juce::String(ratio, 2),
+                      "time_per_frame", secondsPerFrame * 1.0e9, "ns");
+
+            report << juce::String(entry.name).paddedRight(' ', 8)
+                   << juce::String(ratio, 2).paddedRight(' ', 8)
+                   << juce::String(secondsPerFrame * 1.0e9, 2).paddedRight(' ', 11)
+                   << juce::String(secondsPerFrame * cyclesPerSecond, 1) << "\n";
+
+            resampler.releaseResources();
+        }
+    }
+
+    return report;
+}
+
+juce::String Benchmarks::runTimeStretchBenchmark(Metrics& metrics)
+{
+    const int stretchBlockSize = 128;
+    const double stretchSampleRate = 48000.0;
+    const double tempos[] = { 0.5, 0.8, 1.0, 1.25, 2.0 };
+    const int numBlocks = 20000;
+    const double deadline = stretchBlockSize / stretchSampleRate;
+
+    juce::String report;
+    report << "TimeStretcher, two decks, " << stretchBlockSize << "-sample blocks at " << stretchSampleRate << " Hz\n";
+    report << "tempo   mean us   max us    max % of deadline\n";
+
+    AudioBuffer<float> output(2, stretchBlockSize);
+    AudioSourceChannelInfo info(&output, 0, stretchBlockSize);
+
+    for (double tempo : tempos)
+    {
+        ToneGeneratorAudioSource tone1, tone2;
+        tone1.setFrequency(440.0);
+        tone2.setFrequency(523.25);
+
+        TimeStretcher deck1(&tone1), deck2(&tone2);
+        deck1.prepareToPlay(stretchBlockSize, stretchSampleRate);
+        deck2.prepareToPlay(stretchBlockSize, stretchSampleRate);
+        deck1.setTempo(tempo);
+        deck2.setTempo(tempo);
+
+        double total = 0.0, worst = 0.0;
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            const double seconds = timeInSeconds([&]
+                {
+                    deck1.getNextAudioBlock(info);
+                    deck2.getNextAudioBlock(info);
+                });
+
+            total += seconds;
+            worst = jmax(worst, seconds);
+        }
+
+        addMetric(metrics, "time_stretch", "two decks x" + juce::String(tempo, 2), "mean_block_time", total / numBlocks * 1.0e6, "us");
+        addMetric(metrics, "time_stretch", "two decks x" + juce::String(tempo, 2), "max_block_time", worst * 1.0e6, "us");
+
+        report << juce::String(tempo, 2).paddedRight(' ', 8)
+               << juce::String(total / numBlocks * 1.0e6, 2).paddedRight(' ', 10)
+               << juce::String(worst * 1.0e6, 2).paddedRight(' ', 10)
+               << juce::String(worst / deadline * 100.0, 1) << "\n";
+
+        deck1.releaseResources();
+        deck2.releaseResources();
+    }
+
+    return report;
+}
+
+juce::String Benchmarks::runWaveformRenderBenchmark(Metrics& metrics)
+{
+    const double trackSeconds = 180.0;
+    const int numFrames = 600;
+    const double frameSeconds = 1.0 / 60.0;
+
+    juce::String report;
+    report << "Waveform, " << trackSeconds << " s stereo track at " << sampleRate << " Hz
+";
+
+    // Write a synthetic track so the overview is generated through the real decoder
+    TemporaryFile trackFile(".wav");
+
+    {
+        WavAudioFormat wavFormat;
+        std::unique_ptr<AudioFormatWriter> writer(wavFormat.createWriterFor(
+            new FileOutputStream(trackFile.getFile()), sampleRate, 2, 16, {}, 0));
+
+        if (writer == nullptr)
+            return report + "could not write the test track\n";
+
+        ToneGeneratorAudioSource tone;
+        tone.setFrequency(110.0);
+        tone.prepareToPlay(blockSize, sampleRate);
+
+        AudioBuffer<float> block(2, blockSize);
+        Random random(1);
+
+        for (int64 written = 0; written < static_cast<int64>(trackSeconds * sampleRate); written += blockSize)
+        {
+            AudioSourceChannelInfo info(&block, 0, blockSize);
+            tone.getNextAudioBlock(info);
+
+            // Noise bursts give the high band something to show
+            if ((written / 22050) % 2 == 0)
+                for (int i = 0; i < blockSize; ++i)
+                    block.addSample(0, i, (random.nextFloat() - 0.5f) * 0.2f);
+
+            writer->writeFromAudioSampleBuffer(block, 0, blockSize);
+        }
+    }
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    std::shared_ptr<WaveformCache::Overview> overview;
+    const double generateSeconds = timeInSeconds([&]
+        {
+            overview = WaveformCache::generate(formatManager, URL(trackFile.getFile()));
+        });
+
+    if (overview == nullptr)
+        return report + "could not read the test track\n";
+
+    addMetric(metrics, "waveform", "180 s track", "overview_generation", generateSeconds * 1000.0, "ms");
+
+    // Round trip through the disk cache, as when a deck reloads a track it has seen before
+    TemporaryFile peaksFile(".peaks");
+    const double saveSeconds = timeInSeconds([&] { WaveformCache::save(peaksFile.getFile(), *overview); });
+    std::shared_ptr<WaveformCache::Overview> reloaded;
+    const double loadSeconds = timeInSeconds([&] { reloaded = WaveformCache::load(peaksFile.getFile(), overview->contentHash); });
+
+    addMetric(metrics, "waveform", "180 s track", "overview_save", saveSeconds * 1000.0, "ms");
+    addMetric(metrics, "waveform", "180 s track", "overview_load", loadSeconds * 1000.0, "ms");
+
+    report << "overview generation: " << juce::String(generateSeconds * 1000.0, 1) << " ms, "
+           << (int) overview->levels.size() << " levels, cache save " << juce::String(saveSeconds * 1000.0, 2)
+           << " ms, load " << juce::String(loadSeconds * 1000.0, 2) << " ms" << (reloaded == nullptr ? " (failed)" : "") << "\n";
+    report << "800x120 view, 60 fps   mean us   max us\n";
+
+    WaveformCache cache(formatManager, File::getSpecialLocation(File::tempDirectory));
+    ScrollingWaveform view(cache, true);
+    view.setSize(800, 120);
+    view.setOverview(overview);
+
+    Image frame(Image::RGB, view.getWidth(), view.getHeight(), true);
+
+    for (bool cached : { false, true })
+    {
+        double total = 0.0, worst = 0.0;
+        view.invalidateTiles();
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            view.setPlayheadSeconds(30.0 + i * frameSeconds);
+
+            if (!cached)
+                view.invalidateTiles();
+
+            const double seconds = timeInSeconds([&]
+                {
+                    Graphics g(frame);
+                    view.paintEntireComponent(g, true);
+                });
+
+            total += seconds;
+            worst = jmax(worst, seconds);
+        }
+
+        addMetric(metrics, "waveform", cached ? "cached tiles" : "full redraw", "mean_frame_time", total / numFrames * 1.0e6, "us");
+        addMetric(metrics, "waveform", cached ? "cached tiles" : "full redraw", "max_frame_time", worst * 1.0e6, "us");
+
+        report << juce::String(cached ? "cached tiles" : "full redraw").paddedRight(' ', 23)
+               << juce::String(total / numFrames * 1.0e6, 1).paddedRight(' ', 10)
+               << juce::String(worst * 1.0e6, 1) << "\n";
+    }
+
+    return report;
+}
+
+juce::String Benchmarks::runDiscRenderBenchmark(Metrics& metrics)
+{
+    const int numFrames = OtherLookAndFeel::numDiscFrames * 4;
+
+    juce::String report;
+    report << "Platter, 240x240 rotary slider, " << OtherLookAndFeel::numDiscFrames << " sprites\n";
+    report << "pass         mean us   max us\n";
+
+    OtherLookAndFeel lookAndFeel;
+    Slider disc(Slider::Rotary, Slider::NoTextBox);
+    disc.setLookAndFeel(&lookAndFeel);
+    disc.setSize(240, 240);
+
+    Image frame(Image::ARGB, disc.getWidth(), disc.getHeight(), true);
+
+    for (const char* pass : { "first turn", "cached" })
+    {
+        double total = 0.0, worst = 0.0;
+
+        for (int i = 0; i < numFrames; ++i)
+        {
+            lookAndFeel.rotateDisc(i * MathConstants<double>::twoPi / numFrames);
+
+            const double seconds = timeInSeconds([&]
+                {
+                    Graphics g(frame);
+                    disc.paintEntireComponent(g, true);
+                });
+
+            total += seconds;
+            worst = jmax(worst, seconds);
+        }
+
+        addMetric(metrics, "platter", pass, "mean_frame_time", total / numFrames * 1.0e6, "us");
+        addMetric(metrics, "platter", pass, "max_frame_time", worst * 1.0e6, "us");
+
+        report << juce::String(pass).paddedRight(' ', 13)
+               << juce::String(total / numFrames * 1.0e6, 1).paddedRight(' ', 10)
+               << juce::String(worst * 1.0e6, 1) << "\n";
+    }
+
+    disc.setLookAndFeel(nullptr);
+    return report;
+}
+
+juce::String Benchmarks::runSearchBenchmark(Metrics& metrics)
+{
+    const int numTracks = 100000;
+    const char* words[] = { "love", "night", "dance", "summer", "remix", "original", "mix", "heart",
+                            "city", "lights", "fire", "dream", "edit", "extended", "radio", "deep",
+                            "house", "blue", "gold", "feat", "dj", "beat", "soul", "sky" };
+    const int numWords = (int) (sizeof(words) / sizeof(words[0]));
+    const char* queries[] = { "d", "da", "dan", "danc", "dance", "dance nig", "dacne", "summer remix",
+                              "extnded mix", "soul sky 42", "zzz" };
+
+    Random random(7);
+    TrackSearchIndex index;
+
+    const double indexSeconds = timeInSeconds([&]
+        {
+            for (int i = 0; i < numTracks; ++i)
+            {
+                juce::String title;
+
+                for (int w = 0; w < 3 + random.nextInt(3); ++w)
+                    title << words[random.nextInt(numWords)] << " ";
+
+                index.add(static_cast<juce::uint32>(i + 1), title + juce::String(i));
+            }
+        });
+
+    addMetric(metrics, "search", "100k titles", "index_build", indexSeconds * 1000.0, "ms");
+
+    juce::String report;
+    report << "TrackSearchIndex, " << numTracks << " tracks indexed in "
+           << juce::String(indexSeconds * 1000.0, 1) << " ms\n";
+    report << "query          hits     mean us   max us\n";
+
+    for (const char* query : queries)
+    {
+        double total = 0.0, worst = 0.0;
+        size_t hits = 0;
+        const int repeats = 20;
+
+        for (int i = 0; i < repeats; ++i)
+        {
+            const double seconds = timeInSeconds([&] { hits = index.search(query).size(); });
+            total += seconds;
+            worst = jmax(worst, seconds);
+        }
+
+        addMetric(metrics, "search", "\"" + juce::String(query) + "\"", "mean_query_time", total / repeats * 1.0e6, "us");
+
+        report << juce::String(query).paddedRight(' ', 15)
+               << juce::String((int) hits).paddedRight(' ', 9)
+               << juce::String(total / repeats * 1.0e6, 1).paddedRight(' ', 10)
+               << juce::String(worst * 1.0e6, 1) << "\n";
+    }
+
+    return report;
+}
+
+juce::String Benchmarks::runPlaylistScaleBenchmark(Metrics& metrics)
+{
+    const int numTracks = 1000000;
+    const int numFolders = 2000;
+    const int rowsPerPage = 30;
+    const int rowHeight = 22;
+
+    TrackStore store;
+
+    const double fillSeconds = timeInSeconds([&]
+        {
+            store.reserve(numTracks);
+
+            for (int i = 0; i < numTracks; ++i)
+            {
+                const juce::String name = "Track " + juce::String(i);
+                SoundTrack track{ name, "file:///music/Artist%20" + juce::String(i % numFolders) + "/" + name + ".mp3" };
+                track.LengthInSeconds = 120.0 + i % 300;
+                track.IsAnalysed = true;
+                store.add(track);
+            }
+        });
+
+    addMetric(metrics, "playlist", "1M tracks", "fill", fillSeconds * 1000.0, "ms");
+    addMetric(metrics, "playlist", "1M tracks", "memory", store.getMemoryUsage() / (1024.0 * 1024.0), "MB");
+
+    juce::String report;
+    report << "TrackStore, " << numTracks << " tracks added in " << juce::String(fillSeconds * 1000.0, 1)
+           << " ms, " << juce::String(store.getMemoryUsage() / (1024.0 * 1024.0), 1) << " MB\n";
+
+    // Paint the title and length columns of one page, as the table does for every visible row
+    Image page(Image::RGB, 600, rowsPerPage * rowHeight, false);
+    Graphics g(page);
+    Random random(11);
+    double total = 0.0, worst = 0.0;
+    const int frames = 200;
+
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        const int firstRow = random.nextInt(numTracks - rowsPerPage);
+
+        const double seconds = timeInSeconds([&]
+            {
+                g.fillAll(Colours::black);
+                g.setColour(Colours::white);
+
+                for (int row = 0; row < rowsPerPage; ++row)
+                {
+                    const size_t index = static_cast<size_t>(firstRow + row);
+                    const int length = static_cast<int>(store.getLengthInSeconds(index));
+                    g.drawText(store.getName(index), 2, row * rowHeight, 400, rowHeight, Justification::centredLeft, true);
+                    g.drawText(juce::String::formatted("%02d:%02d", length / 60, length % 60),
+                               400, row * rowHeight, 200, rowHeight, Justification::centred, false);
+                }
+            });
+
+        total += seconds;
+        worst = jmax(worst, seconds);
+    }
+
+    addMetric(metrics, "playlist", "1M tracks", "mean_page_paint", total / frames * 1.0e6, "us");
+    addMetric(metrics, "playlist", "1M tracks", "max_page_paint", worst * 1.0e6, "us");
+
+    report << "page of " << rowsPerPage << " rows  mean " << juce::String(total / frames * 1.0e6, 1)
+           << " us  max " << juce::String(worst * 1.0e6, 1) << " us\n";
+
+    // Deleting shifts every column once, ids of the remaining rows do not change
+    total = 0.0;
+    worst = 0.0;
+    const int deletes = 20;
+
+    for (int i = 0; i < deletes; ++i)
+    {
+        const auto id = store.getId(store.size() / 2);
+        const double seconds = timeInSeconds([&] { store.remove(id); });
+        total += seconds;
+        worst = jmax(worst, seconds);
+    }
+
+    addMetric(metrics, "playlist", "1M tracks", "mean_delete", total / deletes * 1.0e3, "ms");
+
+    report << "delete from the middle  mean " << juce::String(total / deletes * 1.0e3, 2)
+           << " ms  max " << juce::String(worst * 1.0e3, 2) << " ms\n";
+
+    return report;
+}
+
+juce::String Benchmarks::runMixRenderBenchmark(Metrics& metrics)
+{
+    const double trackSeconds = 120.0;
+    const double mixSeconds = 90.0;
+
+    TemporaryFile track1(".wav"), track2(".wav"), serialOutput(".wav"), parallelOutput(".wav");
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    // Two synthetic tracks: a chord with noise, and a pulsing bass line
+    WavAudioFormat wav;
+
+    if (!writeSyntheticTrack(track1.getFile(), wav, trackSeconds, 220.0, false)
+        || !writeSyntheticTrack(track2.getFile(), wav, trackSeconds, 55.0, true))
+        return "MixRenderer, could not write the synthetic tracks\n";
+
+    // Both decks play, deck 2 is time-stretched, and the crossfader sweeps across in small steps
+    MixRenderer::Timeline timeline;
+    timeline.lengthInSeconds = mixSeconds;
+
+    auto addEvent = [&timeline](double time, MixRenderer::Event::Type type, int deck, double value)
+    {
+        MixRenderer::Event event;
+        event.timeInSeconds = time;
+        event.type = type;
+        event.deck = deck;
+        event.value = value;
+        timeline.events.push_back(event);
+    };
+
+    MixRenderer::Event load1, load2;
+    load1.type = load2.type = MixRenderer::Event::Type::load;
+    load1.url = URL{ track1.getFile() };
+    load2.deck = 2;
+    load2.url = URL{ track2.getFile() };
+    timeline.events.push_back(load1);
+    timeline.events.push_back(load2);
+
+    addEvent(0.0, MixRenderer::Event::Type::crossfader, 0, 0.0);
+    addEvent(0.0, MixRenderer::Event::Type::crossfaderCurve, 0, static_cast<double>(DeckMixer::CrossfaderCurve::constantPower));
+    addEvent(0.0, MixRenderer::Event::Type::play, 1, 0.0);
+    addEvent(0.0, MixRenderer::Event::Type::keyLock, 2, 1.0);
+    addEvent(0.0, MixRenderer::Event::Type::speed, 2, 1.04);
+    addEvent(10.0, MixRenderer::Event::Type::play, 2, 0.0);
+
+    for (double time = 20.0; time <= 80.0; time += 0.05)
+        addEvent(time, MixRenderer::Event::Type::crossfader, 0, (time - 20.0) / 60.0);
+
+    addEvent(85.0, MixRenderer::Event::Type::pause, 1, 0.0);
+
+    MixRenderer renderer(formatManager);
+    MixRenderer::Settings settings;
+    settings.sampleRate = sampleRate;
+
+    juce::String report;
+    report << "MixRenderer, " << mixSeconds << " s two-deck mix with " << (int) timeline.events.size()
+           << " events, " << settings.blockSize << "-sample blocks\n";
+
+    const struct { bool parallel; const File& output; const char* name; } runs[] = {
+        { false, serialOutput.getFile(),   "serial decks" },
+        { true,  parallelOutput.getFile(), "parallel decks" }
+    };
+
+    for (const auto& run : runs)
+    {
+        settings.renderDecksInParallel = run.parallel;
+        MixRenderer::Report renderReport;
+
+        if (!renderer.render(timeline, run.output, settings, renderReport))
+            return report + "render failed: " + renderReport.errorMessage + "\n";
+
+        addMetric(metrics, "mix_render", run.name, "realtime_factor", renderReport.getRealtimeFactor(), "x");
+        report << juce::String(run.name).paddedRight(' ', 16) << renderReport.toString() << "\n";
+    }
+
+    // The render is deterministic, so the thread layout must not change a single sample
+    const bool identical = MD5(serialOutput.getFile()) == MD5(parallelOutput.getFile());
+    addMetric(metrics, "mix_render", "serial vs parallel", "identical_output", identical ? 1.0 : 0.0, "bool");
+    report << "outputs identical: " << (identical ? "yes" : "NO") << "\n";
+
+    // Many loads per deck: the retire queue holds 16 tracks, so every load past that
+    // is only heard if the render frees replaced tracks as it goes
+    TemporaryFile silence(".wav"), tone1(".wav"), tone2(".wav"), loadsOutput(".wav");
+
+    if (!writeSineTrack(silence.getFile(), wav, 2.0, 440.0, 0.0f)
+        || !writeSineTrack(tone1.getFile(), wav, 2.0, 440.0, 0.25f)
+        || !writeSineTrack(tone2.getFile(), wav, 2.0, 660.0, 0.25f))
+        return report + "could not write the load test tracks\n";
+
+    const int loadsPerDeck = 20;
+    MixRenderer::Timeline loadsTimeline;
+    loadsTimeline.lengthInSeconds = loadsPerDeck * 0.25 + 1.0;
+
+    for (int deck = 1; deck <= 2; ++deck)
+    {
+        // Deck 2 loads half a step later, so its last track starts after deck 1's
+        for (int i = 0; i < loadsPerDeck; ++i)
+        {
+            MixRenderer::Event load;
+            load.timeInSeconds = i * 0.25 + (deck - 1) * 0.125;
+            load.type = MixRenderer::Event::Type::load;
+            load.deck = deck;
+            load.url = URL{ i < loadsPerDeck - 1 ? silence.getFile() : deck == 1 ? tone1.getFile() : tone2.getFile() };
+            loadsTimeline.events.push_back(load);
+
+            MixRenderer::Event play;
+            play.timeInSeconds = load.timeInSeconds;
+            play.type = MixRenderer::Event::Type::play;
+            play.deck = deck;
+            loadsTimeline.events.push_back(play);
+        }
+    }
+
+    MixRenderer::Event centre;
+    centre.type = MixRenderer::Event::Type::crossfader;
+    centre.value = 0.5;
+    loadsTimeline.events.push_back(centre);
+
+    std::stable_sort(loadsTimeline.events.begin(), loadsTimeline.events.end(),
+        [](const MixRenderer::Event& a, const MixRenderer::Event& b) { return a.timeInSeconds < b.timeInSeconds; });
+
+    MixRenderer::Report loadsReport;
+    bool lastLoadsHeard = false;
+
+    if (renderer.render(loadsTimeline, loadsOutput.getFile(), settings, loadsReport))
+    {
+        std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(loadsOutput.getFile()));
+
+        auto getLevel = [&reader](double startSeconds, double endSeconds)
+        {
+            const auto start = static_cast<int64>(startSeconds * sampleRate);
+            const auto numSamples = static_cast<int>((endSeconds - startSeconds) * sampleRate);
+            AudioBuffer<float> buffer(2, numSamples);
+            reader->read(&buffer, 0, numSamples, start, true, true);
+            return buffer.getRMSLevel(0, 0, numSamples);
+        };
+
+        if (reader != nullptr)
+        {
+            // Deck 1's last track alone, then both decks' last tracks together
+            const double lastLoad = (loadsPerDeck - 1) * 0.25;
+            const float deck1Level = getLevel(lastLoad + 0.02, lastLoad + 0.11);
+            const float bothLevel = getLevel(lastLoad + 0.2, lastLoad + 0.8);
+            lastLoadsHeard = deck1Level > 0.01f && bothLevel > 1.2f * deck1Level;
+        }
+    }
+
+    addMetric(metrics, "mix_render", juce::String(loadsPerDeck) + " loads per deck", "last_loads_heard", lastLoadsHeard ? 1.0 : 0.0, "bool");
+    report << loadsPerDeck << " loads per deck, last loads heard: " << (lastLoadsHeard ? "yes" : "NO") << "\n";
+
+    return report;
+}
+
+juce::String Benchmarks::runPlayerBenchmark(Metrics& metrics)
+{
+    const double trackSeconds = 60.0;
+    const int numSeeks = 200;
+    const int numBlocks = 2000;
+    const double ratios[] = { 0.5, 1.0, 1.5, 2.0 };
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    WavAudioFormat wav;
+    FlacAudioFormat flac;
+    TemporaryFile wavFile(".wav"), flacFile(".flac");
+
+    if (!writeSyntheticTrack(wavFile.getFile(), wav, trackSeconds, 220.0, false)
+        || !writeSyntheticTrack(flacFile.getFile(), flac, trackSeconds, 220.0, false))
+        return "DJAudioPlayer, could not write the synthetic tracks\n";
+
+    juce::String report;
+    report << "DJAudioPlayer, " << trackSeconds << " s stereo tracks, " << blockSize << "-sample blocks at " << sampleRate << " Hz\n";
+
+    // Decode each file start to end through its reader, as the sample cache does
+    const struct { const char* name; const File& file; } formats[] = {
+        { "wav",  wavFile.getFile() },
+        { "flac", flacFile.getFile() }
+    };
+
+    for (const auto& format : formats)
+    {
+        std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(format.file));
+
+        if (reader == nullptr)
+            continue;
+
+        const int chunk = 4096;
+        AudioBuffer<float> buffer(2, chunk);
+
+        const double seconds = timeInSeconds([&]
+            {
+                for (int64 position = 0; position < reader->lengthInSamples; position += chunk)
+                    reader->read(&buffer, 0, static_cast<int>(jmin<int64>(chunk, reader->lengthInSamples - position)), position, true, true);
+            });
+
+        addMetric(metrics, "player", format.name, "decode_speed", trackSeconds / seconds, "x realtime");
+        report << "decode " << juce::String(format.name).paddedRight(' ', 7) << juce::String(trackSeconds / seconds, 1) << "x realtime\n";
+    }
+
+    // Load, then seek at random while playing, in each of the ways a deck can read a track
+    SampleCache sampleCache(formatManager, 512 * 1024 * 1024);
+    AudioBuffer<float> output(2, blockSize);
+    AudioSourceChannelInfo info(&output, 0, blockSize);
+
+    const struct { const char* name; const File& file; bool resident; } sources[] = {
+        { "wav mmap",    wavFile.getFile(),  false },
+        { "flac stream", flacFile.getFile(), false },
+        { "flac ram",    flacFile.getFile(), true }
+    };
+
+    report << "source        load ms   seek mean us  seek max us  underruns\n";
+
+    for (const auto& source : sources)
+    {
+        DJAudioPlayer player(formatManager, &sampleCache);
+        player.setRamResident(source.resident);
+        player.prepareToPlay(blockSize, sampleRate);
+
+        const double loadSeconds = timeInSeconds([&] { player.loadURL(URL(source.file)); });
+        player.start();
+        player.getNextAudioBlock(info);
+
+        Random random(5);
+        double total = 0.0, worst = 0.0;
+        const int underrunsBefore = player.getUnderrunCount();
+
+        for (int i = 0; i < numSeeks; ++i)
+        {
+            player.setPosition(random.nextDouble() * (trackSeconds - 1.0));
+
+            // The seek is applied at the start of the block, so this block pays for it
+            const double seconds = timeInSeconds([&] { player.getNextAudioBlock(info); });
+            total += seconds;
+            worst = jmax(worst, seconds);
+
+            for (int block = 0; block < 8; ++block)
+                player.getNextAudioBlock(info);
+        }
+
+        const int underruns = player.getUnderrunCount() - underrunsBefore;
+
+        addMetric(metrics, "player", source.name, "load_time", loadSeconds * 1000.0, "ms");
+        addMetric(metrics, "player", source.name, "mean_seek_block_time", total / numSeeks * 1.0e6, "us");
+        addMetric(metrics, "player", source.name, "max_seek_block_time", worst * 1.0e6, "us");
+        addMetric(metrics, "player", source.name, "seek_underruns", underruns, "blocks");
+
+        report << juce::String(source.name).paddedRight(' ', 14)
+               << juce::String(loadSeconds * 1000.0, 2).paddedRight(' ', 10)
+               << juce::String(total / numSeeks * 1.0e6, 1).paddedRight(' ', 14)
+               << juce::String(worst * 1.0e6, 1).paddedRight(' ', 13)
+               << underruns << "\n";
+
+        player.releaseResources();
+    }
+
+    // Play a RAM-resident track through the speed control at several ratios
+    DJAudioPlayer player(formatManager, &sampleCache);
+    player.setRamResident(true);
+    player.prepareToPlay(blockSize, sampleRate);
+    player.loadURL(URL(wavFile.getFile()));
+    player.start();
+
+    const double deadline = blockSize / sampleRate;
+    report << "speed   mean us   max us    max % of deadline\n";
+
+    for (double ratio : ratios)
+    {
+        player.setSpeed(ratio);
+        player.setPosition(0.0);
+
+        for (int i = 0; i < 50; ++i)
+            player.getNextAudioBlock(info);
+
+        double total = 0.0, worst = 0.0;
+
+        for (int i = 0; i < numBlocks; ++i)
+        {
+            const double seconds = timeInSeconds([&] { player.getNextAudioBlock(info); });
+            total += seconds;
+            worst = jmax(worst, seconds);
+        }
+
+        addMetric(metrics, "player", "x" + juce::String(ratio, 2), "mean_block_time", total / numBlocks * 1.0e6, "us");
+        addMetric(metrics, "player", "x" + juce::String(ratio, 2), "max_block_time", worst * 1.0e6, "us");
+
+        report << juce::String(ratio, 2).paddedRight(' ', 8)
+               << juce::String(total / numBlocks * 1.0e6, 2).paddedRight(' ', 10)
+               << juce::String(worst * 1.0e6, 2).paddedRight(' ', 10)
+               << juce::String(worst / deadline * 100.0, 1) << "\n";
+    }
+
+    player.releaseResources();
+    return report;
+}
+
+juce::String Benchmarks::runLibraryBenchmark(Metrics& metrics)
+{
+    const int numFiles = 200;
+    const int numCopies = 20;
+    const double fileSeconds = 5.0;
+    const int numKeys = 1000000;
+    const int numIndexedTracks = 100000;
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    // A folder of distinct short tracks, plus byte-identical copies under other names
+    const File folder = File::getSpecialLocation(File::tempDirectory).getChildFile("OtoDecksBenchmarkLibrary");
+    folder.deleteRecursively();
+    folder.createDirectory();
+
+    WavAudioFormat wav;
+    StringArray urls;
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        const File file = folder.getChildFile("Track " + juce::String(i) + ".wav");
+
+        if (!writeSyntheticTrack(file, wav, fileSeconds, 55.0 + i * 3.0, i % 2 == 0))
+        {
+            folder.deleteRecursively();
+            return "Library, could not write the synthetic tracks\n";
+        }
+
+        urls.add(URL(file).toString(false));
+    }
+
+    for (int i = 0; i < numCopies; ++i)
+    {
+        const File copy = folder.getChildFile("Copy of Track " + juce::String(i) + ".wav");
+        folder.getChildFile("Track " + juce::String(i) + ".wav").copyFileTo(copy);
+        urls.add(URL(copy).toString(false));
+    }
+
+    juce::String report;
+    report << "Library, " << urls.size() << " synthetic " << fileSeconds << " s files\n";
+
+    // Probe every file one after the other, then on a pool as the folder importer does
+    std::vector<TrackAnalyser::Result> results((size_t) urls.size());
+
+    const double serialSeconds = timeInSeconds([&]
+        {
+            for (int i = 0; i < urls.size(); ++i)
+                results[(size_t) i] = TrackAnalyser::probe(formatManager, urls[i]);
+        });
+
+    const double parallelSeconds = timeInSeconds([&]
+        {
+            ThreadPool pool{ jmax(1, SystemStats::getNumCpus()) };
+
+            for (int i = 0; i < urls.size(); ++i)
+                pool.addJob([&formatManager, &results, &urls, i] { results[(size_t) i] = TrackAnalyser::probe(formatManager, urls[i]); });
+
+            while (pool.getNumJobs() > 0)
+                Thread::sleep(1);
+        });
+
+    // Content hashes must find exactly the copies
+    std::unordered_map<juce::int64, int> byContent;
+    int duplicatesFound = 0;
+
+    for (const auto& result : results)
+        if (result.ContentHash != 0 && !byContent.emplace(result.ContentHash, 0).second)
+            ++duplicatesFound;
+
+    addMetric(metrics, "library", "import", "serial_probe", urls.size() / serialSeconds, "files/s");
+    addMetric(metrics, "library", "import", "parallel_probe", urls.size() / parallelSeconds, "files/s");
+    addMetric(metrics, "library", "import", "duplicates_found", duplicatesFound, "files");
+
+    report << "probe serial   " << juce::String(urls.size() / serialSeconds, 1) << " files/s\n";
+    report << "probe parallel " << juce::String(urls.size() / parallelSeconds, 1) << " files/s, "
+           << duplicatesFound << " of " << numCopies << " copies found by content\n";
+
+    folder.deleteRecursively();
+
+    // Duplicate lookups by normalised path, as the playlist does for every added track
+    std::unordered_map<juce::String, juce::uint32> byPath;
+    byPath.reserve((size_t) numKeys);
+
+    const double insertSeconds = timeInSeconds([&]
+        {
+            for (int i = 0; i < numKeys; ++i)
+                byPath.emplace(("/music/artist " + juce::String(i % 2000) + "/track " + juce::String(i) + ".mp3"), (juce::uint32) i);
+        });
+
+    int hits = 0;
+    const double lookupSeconds = timeInSeconds([&]
+        {
+            for (int i = 0; i < numKeys; ++i)
+                hits += (int) byPath.count(("/music/artist " + juce::String(i % 2000) + "/track " + juce::String(i * 2) + ".mp3"));
+        });
+
+    addMetric(metrics, "library", "dedupe 1M paths", "insert_time", insertSeconds / numKeys * 1.0e9, "ns");
+    addMetric(metrics, "library", "dedupe 1M paths", "lookup_time", lookupSeconds / numKeys * 1.0e9, "ns");
+
+    report << "path dedupe    insert " << juce::String(insertSeconds / numKeys * 1.0e9, 1) << " ns, lookup "
+           << juce::String(lookupSeconds / numKeys * 1.0e9, 1) << " ns (" << hits << " hits)\n";
+
+    // Save and load a large library index
+    TrackStore store;
+    store.reserve((size_t) numIndexedTracks);
+
+    for (int i = 0; i < numIndexedTracks; ++i)
+    {
+        SoundTrack track{ "Track " + juce::String(i), "file:///music/Artist%20" + juce::String(i % 2000) + "/Track%20" + juce::String(i) + ".mp3" };
+        track.LengthInSeconds = 120.0 + i % 300;
+        track.SampleRate = sampleRate;
+        track.NumChannels = 2;
+        track.FileSize = 5000000 + i;
+        track.ModificationTime = 1700000000000 + i;
+        track.ContentHash = juce::String(i).hashCode64();
+        track.IsAnalysed = true;
+        store.add(track);
+    }
+
+    TemporaryFile indexFile(".idx");
+    std::vector<SoundTrack> loaded;
+
+    const double saveSeconds = timeInSeconds([&] { LibraryIndex::save(indexFile.getFile(), store); });
+    const double loadSeconds = timeInSeconds([&] { LibraryIndex::load(indexFile.getFile(), loaded); });
+
+    addMetric(metrics, "library", "100k track index", "save_time", saveSeconds * 1000.0, "ms");
+    addMetric(metrics, "library", "100k track index", "load_time", loadSeconds * 1000.0, "ms");
+    addMetric(metrics, "library", "100k track index", "file_size", indexFile.getFile().getSize() / (1024.0 * 1024.0), "MB");
+
+    report << "library index  save " << juce::String(saveSeconds * 1000.0, 1) << " ms, load "
+           << juce::String(loadSeconds * 1000.0, 1) << " ms, " << (int) loaded.size() << " tracks, "
+           << juce::String(indexFile.getFile().getSize() / (1024.0 * 1024.0), 1) << " MB\n";
+
+    return report;
+}
+
+juce::String Benchmarks::runContentAnalysisBenchmark(Metrics& metrics)
+{
+    const double trackSeconds = 240.0;
+    const double bpm = 124.0;
+    const double firstBeatSeconds = 0.35;
+    const int expectedKey = 21;
+    const double levelDb = -20.0;
+    const int numWorkers = ContentAnalyser::getNumWorkers();
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    // One synthetic track per property, each with a known answer.
+    // A stereo 997 Hz sine measures its level in dBFS as LUFS, and peaks at the same level.
+    WavAudioFormat wav;
+    TemporaryFile beatFile(".wav"), keyFile(".wav"), loudnessFile(".wav");
+
+    if (!writeSyntheticBeatTrack(beatFile.getFile(), wav, trackSeconds, bpm, firstBeatSeconds)
+        || !writeSyntheticKeyTrack(keyFile.getFile(), wav, trackSeconds)
+        || !writeSineTrack(loudnessFile.getFile(), wav, trackSeconds, 997.0, Decibels::decibelsToGain(static_cast<float>(levelDb))))
+        return "ContentAnalyser, could not write the synthetic tracks\n";
+
+    const StringArray urls{ URL(beatFile.getFile()).toString(false),
+                            URL(keyFile.getFile()).toString(false),
+                            URL(loudnessFile.getFile()).toString(false) };
+
+    juce::String report;
+    report << "ContentAnalyser, three " << trackSeconds << " s tracks: beats at " << bpm << " BPM from "
+           << firstBeatSeconds << " s, chords in " << KeyAnalyser::getKeyName(expectedKey)
+           << ", stereo sine at " << levelDb << " dBFS\n";
+
+    // Each track once on one core, every pass finding the beat grid, key and loudness
+    ContentAnalyser::Result beatResult, keyResult, loudnessResult;
+    const double serialSeconds = timeInSeconds([&]
+        {
+            beatResult = ContentAnalyser::analyseTrack(formatManager, urls[0]);
+            keyResult = ContentAnalyser::analyseTrack(formatManager, urls[1]);
+            loudnessResult = ContentAnalyser::analyseTrack(formatManager, urls[2]);
+        });
+
+    const double serialRealtime = urls.size() * trackSeconds / serialSeconds;
+    const double bpmError = std::abs(beatResult.Beats.Bpm - bpm);
+    const double beatError = std::abs(beatResult.Beats.FirstBeatSeconds - firstBeatSeconds) * 1000.0;
+    const bool keyCorrect = keyResult.Key.WasAnalysed && keyResult.Key.Key == expectedKey;
+    const double loudnessError = std::abs(loudnessResult.Loudness.IntegratedLufs - levelDb);
+    const double peakError = std::abs(loudnessResult.Loudness.TruePeakDb - levelDb);
+
+    addMetric(metrics, "content", "4 min track", "realtime_per_core", serialRealtime, "x");
+    addMetric(metrics, "content", "4 min track", "bpm_error", bpmError, "BPM");
+    addMetric(metrics, "content", "4 min track", "downbeat_error", beatError, "ms");
+    addMetric(metrics, "content", "4 min track", "key_correct", keyCorrect ? 1.0 : 0.0, "bool");
+    addMetric(metrics, "content", "4 min track", "loudness_error", loudnessError, "LU");
+    addMetric(metrics, "content", "4 min track", "true_peak_error", peakError, "dB");
+
+    report << "one core  " << juce::String(serialRealtime, 1) << "x realtime\n"
+           << "beats     " << juce::String(beatResult.Beats.Bpm, 2) << " BPM (error " << juce::String(bpmError, 3)
+           << "), downbeat " << juce::String(beatResult.Beats.FirstBeatSeconds, 3) << " s (error "
+           << juce::String(beatError, 1) << " ms)\n"
+           << "key       " << (keyResult.Key.WasAnalysed ? KeyAnalyser::getKeyName(keyResult.Key.Key) : juce::String("no key")) << "\n"
+           << "loudness  " << juce::String(loudnessResult.Loudness.IntegratedLufs, 2) << " LUFS (error "
+           << juce::String(loudnessError, 3) << "), true peak " << juce::String(loudnessResult.Loudness.TruePeakDb, 2)
+           << " dBTP (error " << juce::String(peakError, 3) << ")\n";
+
+    // Two tracks per worker on a pool the size the ContentAnalyser uses, as the playlist analyses a library
+    const int numTracks = 2 * numWorkers;
+    const double parallelSeconds = timeInSeconds([&]
+        {
+            ThreadPool pool{ numWorkers };
+
+            for (int i = 0; i < numTracks; ++i)
+                pool.addJob([&formatManager, url = urls[i % urls.size()]] { ContentAnalyser::analyseTrack(formatManager, url); });
+
+            while (pool.getNumJobs() > 0)
+                Thread::sleep(1);
+        });
+
+    const double totalRealtime = numTracks * trackSeconds / parallelSeconds;
+
+    addMetric(metrics, "content", "library", "realtime_total", totalRealtime, "x");
+    addMetric(metrics, "content", "library", "realtime_per_worker", totalRealtime / numWorkers, "x");
+
+    report << numWorkers << " workers " << juce::String(totalRealtime, 1) << "x realtime over " << numTracks << " tracks, "
+           << juce::String(totalRealtime / numWorkers, 1) << "x per worker\n";
+
+    return report;
+}
+
+juce::String Benchmarks::toJson(const Metrics& metrics)
+{
+    auto* host = new DynamicObject();
+    host->setProperty("os", SystemStats::getOperatingSystemName());
+    host->setProperty("cpu", SystemStats::getCpuModel());
+    host->setProperty("cpuMhz", SystemStats::getCpuSpeedInMegahertz());
+    host->setProperty("cores", SystemStats::getNumCpus());
+    host->setProperty("memoryMb", SystemStats::getMemorySizeInMegabytes());
+
+    Array<var> results;
+
+    for (const auto& metric : metrics)
+    {
+        auto* result = new DynamicObject();
+        result->setProperty("benchmark", metric.benchmark);
+        result->setProperty("case", metric.testCase);
+        result->setProperty("metric", metric.name);
+        result->setProperty("value", metric.value);
+        result->setProperty("unit", metric.unit);
+        results.add(var(result));
+    }
+
+    auto* root = new DynamicObject();
+    root->setProperty("schema", 1);
+    root->setProperty("version", ProjectInfo::versionString);
+    root->setProperty("timestamp", Time::getCurrentTime().toISO8601(true));
+    root->setProperty("host", var(host));
+    root->setProperty("results", results);
+
+    return JSON::toString(var(root));
+}
+
+juce::String Benchmarks::runAll(Metrics& metrics)
+{
+    // One after the other, so the report and the metrics always come out in the same order
+    juce::String report;
+    report << runResamplerBenchmark(metrics) << "\n";
+    report << runTimeStretchBenchmark(metrics) << "\n";
+    report << runPlayerBenchmark(metrics) << "\n";
+    report << runWaveformRenderBenchmark(metrics) << "\n";
+    report << runDiscRenderBenchmark(metrics) << "\n";
+    report << runSearchBenchmark(metrics) << "\n";
+    report << runLibraryBenchmark(metrics) << "\n";
+    report << runContentAnalysisBenchmark(metrics) << "\n";
+    report << runPlaylistScaleBenchmark(metrics) << "\n";
+    report << runMixRenderBenchmark(metrics);
+    return report;
+}
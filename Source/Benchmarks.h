@@ -0,0 +1,136 @@
+/*
+  ==============================================================================
+
+    Benchmarks.h
+    Created: 18 Oct 2026 11:02:19am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * The Benchmarks class measures the audio engine and the library on synthetic input,
+ * without an audio device. Every input is generated on the fly with fixed seeds.
+ *
+ * Run the application with --benchmark to print the results and exit, or with
+ * --benchmark --json [file] to write them as JSON for tracking across releases.
+ */
+class Benchmarks
+{
+public:
+    /**
+     * One measured value of the report.
+     */
+    struct Metric
+    {
+        juce::String benchmark;
+        juce::String testCase;
+        juce::String name;
+        double value = 0.0;
+        juce::String unit;
+    };
+
+    using Metrics = std::vector<Metric>;
+
+    /**
+     * Time every DeckResampler mode at several speed ratios.
+     * @param metrics Receives every measured value.
+     * @return A table of nanoseconds and estimated CPU cycles per output frame.
+     */
+    static juce::String runResamplerBenchmark(Metrics& metrics);
+
+    /**
+     * Time two TimeStretcher decks running together at 48 kHz with 128-sample blocks.
+     * @param metrics Receives every measured value.
+     * @return A table of mean and worst-case CPU time per block against the block deadline.
+     */
+    static juce::String runTimeStretchBenchmark(Metrics& metrics);
+
+    /**
+     * Build the overview of a synthetic three-minute track, then time the scrolling
+     * waveform per frame with cached tiles against re-rendering every frame.
+     * @param metrics Receives every measured value.
+     * @return The generation time and the mean and worst paint time per frame.
+     */
+    static juce::String runWaveformRenderBenchmark(Metrics& metrics);
+
+    /**
+     * Time the rotating platter slider per frame, first while its sprites are
+     * still being rendered and then once every angle is cached.
+     * @param metrics Receives every measured value.
+     * @return The mean and worst paint time per frame.
+     */
+    static juce::String runDiscRenderBenchmark(Metrics& metrics);
+
+    /**
+     * Index 100k synthetic track titles and time search-as-you-type queries against them.
+     * @param metrics Receives every measured value.
+     * @return The indexing time and the mean and worst time per query.
+     */
+    static juce::String runSearchBenchmark(Metrics& metrics);
+
+    /**
+     * Fill a TrackStore with one million synthetic tracks, then time painting a page of
+     * playlist rows at random scroll positions and deleting from the middle.
+     * @param metrics Receives every measured value.
+     * @return The fill time, the memory held and the mean and worst time per page and delete.
+     */
+    static juce::String runPlaylistScaleBenchmark(Metrics& metrics);
+
+    /**
+     * Bounce a scripted two-deck mix of synthetic tracks with the MixRenderer, with the
+     * decks rendered one after the other and in parallel, and check both files match.
+     * Then render 20 loads per deck, more than the retire queue holds, and check the
+     * last track loaded on each deck is heard.
+     * @param metrics Receives every measured value.
+     * @return The realtime factor of each run, whether the outputs are identical and
+     *         whether the last loads were heard.
+     */
+    static juce::String runMixRenderBenchmark(Metrics& metrics);
+
+    /**
+     * Time DJAudioPlayer on synthetic WAV and FLAC tracks: decoding, loading, seeking
+     * while playing, and playing at several speed ratios.
+     * @param metrics Receives every measured value.
+     * @return The decode speed, load times, and the mean and worst block time per case.
+     */
+    static juce::String runPlayerBenchmark(Metrics& metrics);
+
+    /**
+     * Time the library operations behind the playlist: probing imported files serially
+     * and in parallel, duplicate lookups by path and content hash, and saving and
+     * loading the library index.
+     * @param metrics Receives every measured value.
+     * @return The throughput or time of each operation.
+     */
+    static juce::String runLibraryBenchmark(Metrics& metrics);
+
+    /**
+     * Run the ContentAnalyser over three synthetic four-minute tracks with a known beat
+     * grid, key and loudness, checking all three results, then over copies spread on a
+     * pool the size the ContentAnalyser uses.
+     * @param metrics Receives every measured value.
+     * @return The realtime factor on one core and per worker, and the error in tempo,
+     *         downbeat, key, loudness and true peak.
+     */
+    static juce::String runContentAnalysisBenchmark(Metrics& metrics);
+
+    /**
+     * Run every benchmark.
+     * @param metrics Receives every measured value.
+     * @return The combined report.
+     */
+    static juce::String runAll(Metrics& metrics);
+
+    /**
+     * Format measured values as JSON, with the machine they were measured on.
+     * @param metrics The measured values.
+     * @return The JSON document.
+     */
+    static juce::String toJson(const Metrics& metrics);
+};
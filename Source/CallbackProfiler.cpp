@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    CallbackProfiler.cpp
+    Created: 24 Oct 2026 3:47:02pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "CallbackProfiler.h"
+
+CallbackProfiler::CallbackProfiler() :
+    ticksPerMicrosecond(static_cast<double>(Time::getHighResolutionTicksPerSecond()) / 1.0e6)
+{
+    addStage("callback");
+}
+
+int CallbackProfiler::addStage(const juce::String& name)
+{
+    if (numStages >= maxStages)
+    {
+        DBG("CallbackProfiler::addStage no room for " << name);
+        return -1;
+    }
+
+    stages[(size_t) numStages].name = name;
+    return numStages++;
+}
+
+void CallbackProfiler::addCounter(const juce::String& name, std::function<juce::int64()> getValue)
+{
+    counters.emplace_back(name, std::move(getValue));
+}
+
+void CallbackProfiler::record(int stage, juce::int64 ticks) noexcept
+{
+    if (!isPositiveAndBelow(stage, numStages))
+        return;
+
+    auto& s = stages[(size_t) stage];
+
+    // Single writer, so plain loads and stores are enough and nothing ever waits
+    s.count.store(s.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    s.totalTicks.store(s.totalTicks.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+
+    if (ticks < s.minimumTicks.load(std::memory_order_relaxed))
+        s.minimumTicks.store(ticks, std::memory_order_relaxed);
+
+    if (ticks > s.maximumTicks.load(std::memory_order_relaxed))
+        s.maximumTicks.store(ticks, std::memory_order_relaxed);
+
+    const int bin = jlimit(0, numBins - 1, static_cast<int>(ticks / ticksPerMicrosecond / binMicroseconds));
+    s.bins[(size_t) bin].store(s.bins[(size_t) bin].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void CallbackProfiler::recordCallback(juce::int64 ticks, int numSamples, double sampleRate) noexcept
+{
+    record(callbackStage, ticks);
+
+    if (numSamples > 0 && sampleRate > 0.0)
+    {
+        const double deadlineMicroseconds = numSamples / sampleRate * 1.0e6;
+        const double load = ticks / ticksPerMicrosecond / deadlineMicroseconds;
+
+        totalLoad.store(totalLoad.load(std::memory_order_relaxed) + load, std::memory_order_relaxed);
+
+        if (load > 1.0)
+            overrunCount.store(overrunCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // The message thread only asks, the audio thread clears, so every stage keeps a single writer
+    if (resetRequested.exchange(false, std::memory_order_acq_rel))
+        clearStages();
+}
+
+void CallbackProfiler::clearStages() noexcept
+{
+    for (auto& s : stages)
+    {
+        s.count.store(0, std::memory_order_relaxed);
+        s.totalTicks.store(0, std::memory_order_relaxed);
+        s.minimumTicks.store(std::numeric_limits<juce::int64>::max(), std::memory_order_relaxed);
+        s.maximumTicks.store(0, std::memory_order_relaxed);
+
+        for (auto& bin : s.bins)
+            bin.store(0, std::memory_order_relaxed);
+    }
+
+    overrunCount.store(0, std::memory_order_relaxed);
+    totalLoad.store(0.0, std::memory_order_relaxed);
+}
+
+std::vector<CallbackProfiler::Summary> CallbackProfiler::getSummaries() const
+{
+    std::vector<Summary> summaries;
+
+    for (int i = 0; i < numStages; ++i)
+    {
+        const auto& s = stages[(size_t) i];
+        Summary summary;
+        summary.name = s.name;
+        summary.count = s.count.load(std::memory_order_relaxed);
+
+        if (summary.count > 0)
+        {
+            summary.minimum = s.minimumTicks.load(std::memory_order_relaxed) / ticksPerMicrosecond;
+            summary.maximum = s.maximumTicks.load(std::memory_order_relaxed) / ticksPerMicrosecond;
+            summary.mean = s.totalTicks.load(std::memory_order_relaxed) / ticksPerMicrosecond / summary.count;
+
+            // The upper edge of the bin holding the 99th percentile, never above the true maximum
+            juce::int64 binTotal = 0;
+
+            for (const auto& bin : s.bins)
+                binTotal += bin.load(std::memory_order_relaxed);
+
+            const auto target = static_cast<juce::int64>(std::ceil(binTotal * 0.99));
+            juce::int64 seen = 0;
+
+            for (int bin = 0; bin < numBins; ++bin)
+            {
+                seen += s.bins[(size_t) bin].load(std::memory_order_relaxed);
+
+                if (seen >= target)
+                {
+                    summary.percentile99 = jmin(summary.maximum, (bin + 1) * binMicroseconds);
+                    break;
+                }
+            }
+        }
+
+        summaries.push_back(summary);
+    }
+
+    return summaries;
+}
+
+juce::int64 CallbackProfiler::getOverrunCount() const
+{
+    return overrunCount.load(std::memory_order_relaxed);
+}
+
+double CallbackProfiler::getAverageLoad() const
+{
+    const juce::int64 callbacks = stages[callbackStage].count.load(std::memory_order_relaxed);
+    return callbacks > 0 ? totalLoad.load(std::memory_order_relaxed) / callbacks : 0.0;
+}
+
+void CallbackProfiler::reset()
+{
+    resetRequested = true;
+}
+
+juce::String CallbackProfiler::getReport() const
+{
+    juce::String report;
+    report << "callbacks " << stages[callbackStage].count.load(std::memory_order_relaxed)
+           << ", deadline overruns " << getOverrunCount()
+           << ", mean load " << juce::String(getAverageLoad() * 100.0, 1) << "%\n";
+    report << "stage              count      min us   mean us   p99 us    max us\n";
+
+    for (const auto& summary : getSummaries())
+    {
+        report << summary.name.paddedRight(' ', 19)
+               << juce::String(summary.count).paddedRight(' ', 11)
+               << juce::String(summary.minimum, 1).paddedRight(' ', 10)
+               << juce::String(summary.mean, 1).paddedRight(' ', 10)
+               << juce::String(summary.percentile99, 1).paddedRight(' ', 10)
+               << juce::String(summary.maximum, 1) << "\n";
+    }
+
+    for (const auto& counter : counters)
+    {
+        report << counter.first.paddedRight(' ', 30) << counter.second() << "\n";
+    }
+
+    return report;
+}
+
+bool CallbackProfiler::dumpToFile(const juce::File& file) const
+{
+    return file.replaceWithText("Audio callback profile, " + Time::getCurrentTime().toString(true, true) + "\n" + getReport());
+}
@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    CallbackProfiler.h
+    Created: 24 Oct 2026 3:47:02pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/**
+ * The CallbackProfiler class records how long each stage of the audio callback takes.
+ *
+ * Stages are registered on the message thread before the audio device starts.
+ * The audio thread then records one duration per stage and block. Every stage
+ * keeps its count, minimum, maximum and total, plus a fixed histogram from which
+ * the 99th percentile is read, all in atomics written by a single thread. Nothing
+ * on the recording path allocates or locks.
+ *
+ * The whole callback is recorded through recordCallback(), which also counts the
+ * blocks that took longer than their deadline. Counters owned by other objects,
+ * such as read-ahead underruns, are read on the message thread when a report is made.
+ */
+class CallbackProfiler
+{
+public:
+    /**
+     * Statistics of one stage, in microseconds.
+     */
+    struct Summary
+    {
+        juce::String name;
+        juce::int64 count = 0;
+        double minimum = 0.0;
+        double mean = 0.0;
+        double percentile99 = 0.0;
+        double maximum = 0.0;
+    };
+
+    /**
+     * The stage recordCallback() records into, registered by the constructor.
+     */
+    static constexpr int callbackStage = 0;
+
+    /**
+     * The most stages that can be registered.
+     */
+    static constexpr int maxStages = 16;
+
+    /**
+     * Constructor for CallbackProfiler.
+     */
+    CallbackProfiler();
+
+    /**
+     * Register a stage. Must be called before the audio device starts.
+     *
+     * @param name The name shown in reports.
+     * @return     The stage index to record into, or -1 if there is no room.
+     */
+    int addStage(const juce::String& name);
+
+    /**
+     * Register a counter to show in reports. Must be called before the audio device starts.
+     *
+     * @param name     The name shown in reports.
+     * @param getValue Reads the counter. Called on the message thread.
+     */
+    void addCounter(const juce::String& name, std::function<juce::int64()> getValue);
+
+    /**
+     * Get the current time in high resolution ticks.
+     */
+    static juce::int64 getTicks() noexcept { return Time::getHighResolutionTicks(); }
+
+    /**
+     * Record the duration of a stage. Called on the audio thread, never allocates or locks.
+     *
+     * @param stage The stage index returned by addStage().
+     * @param ticks The duration in high resolution ticks.
+     */
+    void record(int stage, juce::int64 ticks) noexcept;
+
+    /**
+     * Record the duration of a whole callback and check it against the block deadline.
+     * Called on the audio thread at the end of every callback.
+     *
+     * @param ticks      The duration in high resolution ticks.
+     * @param numSamples The number of samples in the block.
+     * @param sampleRate The sample rate of the device.
+     */
+    void recordCallback(juce::int64 ticks, int numSamples, double sampleRate) noexcept;
+
+    /**
+     * Get the statistics of every stage. Called on the message thread.
+     */
+    std::vector<Summary> getSummaries() const;
+
+    /**
+     * Get the number of callbacks that took longer than their deadline.
+     */
+    juce::int64 getOverrunCount() const;
+
+    /**
+     * Get the mean callback duration as a fraction of the block deadline.
+     */
+    double getAverageLoad() const;
+
+    /**
+     * Clear every statistic. The audio thread clears them at the end of its next callback.
+     */
+    void reset();
+
+    /**
+     * Describe every stage and counter as a text table.
+     */
+    juce::String getReport() const;
+
+    /**
+     * Write the report to a file.
+     *
+     * @param file The file to write, replaced if it exists.
+     * @return     True if the file was written.
+     */
+    bool dumpToFile(const juce::File& file) const;
+
+    /**
+     * Times a stage from construction to destruction. Does nothing without a profiler.
+     */
+    class ScopedTimer
+    {
+    public:
+        ScopedTimer(CallbackProfiler* _profiler, int _stage) noexcept
+            : profiler(_profiler), stage(_stage), start(_profiler != nullptr ? getTicks() : 0) {}
+
+        ~ScopedTimer()
+        {
+            if (profiler != nullptr)
+                profiler->record(stage, getTicks() - start);
+        }
+
+    private:
+        CallbackProfiler* profiler;
+        int stage;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedTimer)
+    };
+
+private:
+    /**
+     * Histogram resolution: 20 us bins up to 20 ms, the last bin holds everything longer.
+     */
+    static constexpr int numBins = 1000;
+    static constexpr double binMicroseconds = 20.0;
+
+    /**
+     * Lock-free statistics of one stage. Only the audio thread writes them.
+     */
+    struct Stage
+    {
+        juce::String name;
+        std::atomic<juce::int64> count{ 0 };
+        std::atomic<juce::int64> totalTicks{ 0 };
+        std::atomic<juce::int64> minimumTicks{ std::numeric_limits<juce::int64>::max() };
+        std::atomic<juce::int64> maximumTicks{ 0 };
+        std::array<std::atomic<juce::uint32>, numBins> bins{};
+    };
+
+    /**
+     * Clear every stage. Called on the audio thread.
+     */
+    void clearStages() noexcept;
+
+    std::array<Stage, maxStages> stages;
+    int numStages = 0;
+
+    std::vector<std::pair<juce::String, std::function<juce::int64()>>> counters;
+
+    /**
+     * Overrun count and the sum of callback durations over their deadlines, for the load.
+     */
+    std::atomic<juce::int64> overrunCount{ 0 };
+    std::atomic<double> totalLoad{ 0.0 };
+
+    std::atomic<bool> resetRequested{ false };
+
+    const double ticksPerMicrosecond;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CallbackProfiler)
+};
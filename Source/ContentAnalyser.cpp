@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+    ContentAnalyser.cpp
+    Created: 27 Oct 2026 11:08:46am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "ContentAnalyser.h"
+
+namespace
+{
+    constexpr int readBlockSize = 65536;
+
+    bool shouldStop()
+    {
+        auto* job = ThreadPoolJob::getCurrentThreadPoolJob();
+        return job != nullptr && job->shouldExit();
+    }
+}
+
+//==============================================================================
+class ContentAnalyser::AnalyseJob : public ThreadPoolJob
+{
+public:
+    AnalyseJob(ContentAnalyser& _owner, const juce::String& _musicUrl)
+        : ThreadPoolJob("Analyse " + _musicUrl),
+          owner(_owner),
+          musicUrl(_musicUrl)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (shouldExit())
+            return jobHasFinished;
+
+        Result result = ContentAnalyser::analyseTrack(owner.formatManager, musicUrl);
+
+        // A cancelled job has found nothing, and nobody is waiting for it
+        if (!shouldExit())
+            owner.addResult(result);
+
+        return jobHasFinished;
+    }
+
+private:
+    ContentAnalyser& owner;
+    juce::String musicUrl;
+};
+
+//==============================================================================
+ContentAnalyser::ContentAnalyser(AudioFormatManager& _formatManager, Listener& _listener)
+    : formatManager(_formatManager),
+      listener(_listener),
+      pool(getNumWorkers())
+{
+}
+
+ContentAnalyser::~ContentAnalyser()
+{
+    pool.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+}
+
+void ContentAnalyser::analyse(const juce::String& musicUrl)
+{
+    pool.addJob(new AnalyseJob(*this, musicUrl), true);
+}
+
+void ContentAnalyser::cancelAll()
+{
+    pool.removeAllJobs(true, 5000);
+
+    const ScopedLock sl(resultLock);
+    finishedResults.clear();
+}
+
+ContentAnalyser::Result ContentAnalyser::analyseTrack(AudioFormatManager& formatManager, const juce::String& musicUrl)
+{
+    Result result;
+    result.MusicUrl = musicUrl;
+
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(
+        juce::URL{ musicUrl }.createInputStream(false)));
+
+    if (reader == nullptr || reader->sampleRate <= 0 || reader->lengthInSamples <= 0)
+        return result;
+
+    BeatAnalyser beatAnalyser(reader->sampleRate, reader->lengthInSamples);
+    KeyAnalyser keyAnalyser(reader->sampleRate);
+    LoudnessAnalyser loudnessAnalyser(reader->sampleRate, reader->lengthInSamples);
+
+    // A mono track is read into both channels, as the decks play it on both speakers
+    AudioBuffer<float> buffer(2, readBlockSize);
+    AudioBuffer<float> monoBuffer(1, readBlockSize);
+
+    for (juce::int64 start = 0; start < reader->lengthInSamples; start += readBlockSize)
+    {
+        if (shouldStop())
+            return result;
+
+        const int numSamples = static_cast<int>(jmin<juce::int64>(readBlockSize, reader->lengthInSamples - start));
+
+        if (!reader->read(&buffer, 0, numSamples, start, true, true))
+            return result;
+
+        const float* left = buffer.getReadPointer(0);
+        const float* right = buffer.getReadPointer(1);
+        loudnessAnalyser.process(left, right, numSamples);
+
+        // The beats and the key are both found in the mono mix
+        const float* mono = left;
+
+        if (reader->numChannels > 1)
+        {
+            float* mix = monoBuffer.getWritePointer(0);
+            FloatVectorOperations::add(mix, left, right, numSamples);
+            FloatVectorOperations::multiply(mix, 0.5f, numSamples);
+            mono = mix;
+        }
+
+        beatAnalyser.process(mono, numSamples);
+        keyAnalyser.process(mono, numSamples);
+    }
+
+    result.Beats = beatAnalyser.getResult();
+    result.Key = keyAnalyser.getResult();
+    result.Loudness = loudnessAnalyser.getResult();
+    return result;
+}
+
+int ContentAnalyser::getNumWorkers()
+{
+    return jmax(1, SystemStats::getNumCpus() - 2);
+}
+
+void ContentAnalyser::addResult(const Result& result)
+{
+    {
+        const ScopedLock sl(resultLock);
+        finishedResults.add(result);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void ContentAnalyser::handleAsyncUpdate()
+{
+    Array<Result> results;
+
+    {
+        const ScopedLock sl(resultLock);
+        results.swapWith(finishedResults);
+    }
+
+    if (!results.isEmpty())
+        listener.contentAnalysed(results);
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    ContentAnalyser.h
+    Created: 27 Oct 2026 11:08:46am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BeatAnalyser.h"
+#include "KeyAnalyser.h"
+#include "LoudnessAnalyser.h"
+
+/**
+ * The ContentAnalyser class analyses the audio of tracks in the background:
+ * their beat grid, their musical key and their loudness.
+ *
+ * Every call to analyse() becomes one job on a shared ThreadPool. A job decodes
+ * its file once, streaming it through the reader in fixed blocks, and hands every
+ * block to a BeatAnalyser, a KeyAnalyser and a LoudnessAnalyser, so a track is
+ * never decoded twice.
+ * The pool leaves two cores free, so the audio and message threads are never
+ * starved while a library is analysed.
+ *
+ * Finished results are handed to the Listener in batches on the message thread.
+ */
+class ContentAnalyser : private AsyncUpdater
+{
+public:
+    /**
+     * Everything found in the audio of a single track.
+     */
+    struct Result
+    {
+        juce::String MusicUrl;
+        BeatAnalyser::Result Beats;
+        KeyAnalyser::Result Key;
+        LoudnessAnalyser::Result Loudness;
+    };
+
+    /**
+     * Receives finished results on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called with every result that finished since the previous call.
+         *
+         * @param results The finished results, in completion order.
+         */
+        virtual void contentAnalysed(const Array<Result>& results) = 0;
+    };
+
+    /**
+     * Constructor for ContentAnalyser.
+     *
+     * @param _formatManager Reference to the AudioFormatManager used to open the files.
+     * @param _listener      The listener that receives the results.
+     */
+    ContentAnalyser(AudioFormatManager& _formatManager, Listener& _listener);
+
+    /**
+     * Destructor for ContentAnalyser. Stops running jobs and drops pending ones.
+     */
+    ~ContentAnalyser() override;
+
+    /**
+     * Queue a track to be analysed on a worker thread.
+     *
+     * @param musicUrl The URL of the audio file to analyse.
+     */
+    void analyse(const juce::String& musicUrl);
+
+    /**
+     * Drop every job that has not finished yet and discard undelivered results.
+     */
+    void cancelAll();
+
+    /**
+     * Analyse a track on the calling thread, decoding it once. Returns early, with
+     * nothing analysed, when called from a ThreadPoolJob that has been asked to exit.
+     *
+     * @param formatManager The AudioFormatManager used to open the file.
+     * @param musicUrl      The URL of the audio file to analyse.
+     * @return              The results, each WasAnalysed is false if the file could
+     *                      not be read or that part could not be found.
+     */
+    static Result analyseTrack(AudioFormatManager& formatManager, const juce::String& musicUrl);
+
+    /**
+     * Get the number of workers in the pool: one per CPU, less one each for the audio and message threads.
+     *
+     * @return The number of workers, at least one.
+     */
+    static int getNumWorkers();
+
+private:
+    class AnalyseJob;
+
+    /**
+     * Store a finished result and schedule its delivery. Called from worker threads.
+     *
+     * @param result The finished result.
+     */
+    void addResult(const Result& result);
+
+    /**
+     * Deliver the collected results to the listener on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    AudioFormatManager& formatManager;
+    Listener& listener;
+
+    /**
+     * Worker pool shared by every analysis, sized by getNumWorkers().
+     */
+    ThreadPool pool;
+
+    /**
+     * Results waiting to be delivered, guarded by resultLock.
+     */
+    CriticalSection resultLock;
+    Array<Result> finishedResults;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ContentAnalyser)
+};
@@ -1,106 +1,863 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.cpp
-    Created: 31 Jan 2024 12:05:59pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#include "DJAudioPlayer.h"
-
-DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager) : 
-    formatManager(_formatManager)
-{
-}
-
-DJAudioPlayer::~DJAudioPlayer() {}
-
-void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
-{
-    transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-}
-
-void DJAudioPlayer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) 
-{
-    resampleSource.getNextAudioBlock(bufferToFill);
-}
-
-void DJAudioPlayer::releaseResources() 
-{
-    transportSource.releaseResources();
-    resampleSource.releaseResources();
-}
-
-void DJAudioPlayer::loadURL(URL audioURL)
-{
-    auto* reader = formatManager.createReaderFor(audioURL.createInputStream(false));
-    if (reader != nullptr) // good file!
-    {
-        std::unique_ptr<AudioFormatReaderSource> newSource(new AudioFormatReaderSource(reader, true));
-        transportSource.setSource(newSource.get(), 0, nullptr, reader->sampleRate);
-        readerSource.reset(newSource.release());
-    }
-}
-
-void DJAudioPlayer::setGain(double gain)
-{
-    if (gain < 0 || gain > 1.0) 
-    {
-        DBG("DJAudioPlayer::setGain gain should be between 0 and 1");
-    }
-    else
-    {
-        transportSource.setGain(gain);
-    }
-}
-
-// changed the ratio to be <= 0 to prevent breakpoint activation
-void DJAudioPlayer::setSpeed(double ratio)
-{
-    if (ratio <= 0 || ratio > 5.0) {
-        DBG("DJAudioPlayer::setSpeed ratio should be between 0 and 5");
-    }
-    else {
-        resampleSource.setResamplingRatio(ratio);
-    }
-}
-
-void DJAudioPlayer::setPosition(double posInSec)
-{
-    transportSource.setPosition(posInSec);
-}
-
-void DJAudioPlayer::start()
-{
-    transportSource.start();
-}
-
-void DJAudioPlayer::pause()
-{
-    transportSource.stop();
-}
-
-// Get the relative position of the playback
-double DJAudioPlayer::getPositionRelative()
-{
-    return transportSource.getCurrentPosition() / transportSource.getLengthInSeconds();
-}
-
-// Set the playback position based on a relative value
-void DJAudioPlayer::setPositionRelative(double pos)
-{
-    if (pos < 0 || pos > 1.0)
-    {
-        // Print a warning if the relative position is out of bounds
-        std::cout << "DJAudioPlayer::setPositionRelative: Relative pos should be between 0 and 1." << std::endl;
-    }
-    else
-    {
-        // Convert relative position to absolute seconds and set the position
-        double posInSecs = transportSource.getLengthInSeconds() * pos;
-        setPosition(posInSecs);
-    }
+/*
+  ==============================================================================
+
+    DJAudioPlayer.cpp
+    Created: 31 Jan 2024 12:05:59pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "DJAudioPlayer.h"
+#include "ContentAnalyser.h"
+
+namespace
+{
+    // SYNC closes this fraction of the phase error every block...
+    constexpr double phaseCorrectionPerBlock = 0.1;
+
+    // ...without bending the tempo by more than this fraction
+    constexpr double maxPhaseNudge = 0.03;
+}
+
+DJAudioPlayer::DJAudioPlayer(AudioFormatManager& _formatManager, SampleCache* _sampleCache) : 
+    formatManager(_formatManager),
+    sampleCache(_sampleCache)
+{
+    readAheadThread.startThread();
+    startTimer(500);
+}
+
+DJAudioPlayer::~DJAudioPlayer()
+{
+    stopTimer();
+    loaderPool.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+    readAheadThread.stopThread(2000);
+}
+
+void DJAudioPlayer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    // Both speed stages prepare the looping source, and the handoff source behind it, with the larger block they will request
+    timeStretcher.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    resampleSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+
+    gainSmoother.reset(sampleRate, 0.02);
+    gainSmoother.setCurrentAndTargetValue(targetGain.load());
+
+    // Every deck restarts its sample count here, so an old master position would look current
+    outputSampleRate = sampleRate;
+    renderedSamples = 0;
+    pendingStartSample = -1;
+
+    if (syncClock != nullptr)
+        syncClock->release(deckId);
+}
+
+void DJAudioPlayer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) 
+{
+    // Swap in a newly loaded track first so queued commands act on it
+    handoffSource.beginBlock();
+    DeckTrack* track = handoffSource.getRenderingTrack();
+
+    // A start waiting for the beat, the tempo and phase SYNC held and a loop crossfade belong to the previous track
+    if (track != previousTrack)
+    {
+        previousTrack = track;
+        pendingStartSample = -1;
+        lastSyncedSpeed = 0.0;
+        syncEngaged = false;
+        loopingSource.reset();
+    }
+
+    applyPendingCommands(track);
+    updateLoop(track);
+
+    const bool shouldLockKey = keyLock.load(std::memory_order_relaxed);
+
+    // The stage being switched to holds stale input from the last time it ran
+    if (shouldLockKey != keyLockActive)
+    {
+        keyLockActive = shouldLockKey;
+
+        if (keyLockActive)
+            timeStretcher.reset();
+        else
+            resampleSource.reset();
+    }
+
+    updateSpeed(track, bufferToFill.numSamples);
+
+    const juce::int64 speedStart = CallbackProfiler::getTicks();
+    const juce::int64 endSample = renderedSamples + bufferToFill.numSamples;
+
+    // A quantised start falls in this block: render up to the beat stopped and the rest playing
+    if (track != nullptr && pendingStartSample >= 0 && pendingStartSample < endSample)
+    {
+        const int offset = static_cast<int>(jlimit<juce::int64>(0, bufferToFill.numSamples, pendingStartSample - renderedSamples));
+
+        if (offset > 0)
+            renderSpeedStage(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample, offset));
+
+        track->transportSource.start();
+        pendingStartSample = -1;
+
+        if (offset < bufferToFill.numSamples)
+            renderSpeedStage(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample + offset, bufferToFill.numSamples - offset));
+    }
+    else
+    {
+        renderSpeedStage(bufferToFill);
+    }
+
+    // The speed stage pulls from the track itself, so its reads are split out of its time
+    const juce::int64 readTicks = handoffSource.takeReadTicks();
+
+    if (profiler != nullptr)
+    {
+        profiler->record(readStage, readTicks);
+        profiler->record(resampleStage, CallbackProfiler::getTicks() - speedStart - readTicks);
+    }
+
+    // Ramp the gain across the block rather than jumping to the new value
+    gainSmoother.setTargetValue(targetGain.load(std::memory_order_relaxed));
+    const float startGain = gainSmoother.getCurrentValue();
+    const float endGain = gainSmoother.skip(bufferToFill.numSamples);
+
+    for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+    {
+        bufferToFill.buffer->applyGainRamp(channel, bufferToFill.startSample, bufferToFill.numSamples, startGain, endGain);
+    }
+
+    if (track != nullptr)
+    {
+        auto& transport = track->transportSource;
+
+        // A track that played to its end without a loop goes back to the start, ready to play again
+        if (transport.hasStreamFinished() && !transport.isPlaying()
+            && transport.getNextReadPosition() >= transport.getTotalLength())
+        {
+            transport.setPosition(0.0);
+        }
+
+        // Publish the playhead and the loop for the message thread
+        playheadSeconds.store(transport.getCurrentPosition(), std::memory_order_relaxed);
+        lengthInSeconds.store(transport.getLengthInSeconds(), std::memory_order_relaxed);
+        loopEngaged.store(track->loopEngaged, std::memory_order_relaxed);
+        loopStartSeconds.store(track->loopInSeconds, std::memory_order_relaxed);
+        loopEndSeconds.store(track->loopOutSeconds, std::memory_order_relaxed);
+    }
+
+    // A deck playing on its own grid is master material, any other deck lets go of the clock
+    if (syncClock != nullptr)
+    {
+        if (track != nullptr && track->transportSource.isPlaying() && track->beatGrid.isValid()
+            && !sync.load(std::memory_order_relaxed) && outputSampleRate > 0.0)
+        {
+            const BeatGrid& grid = track->beatGrid;
+            syncClock->publish(deckId, renderedSamples, endSample,
+                grid.getBeatAt(getAudiblePosition(*track)),
+                appliedSpeed.load(std::memory_order_relaxed) * grid.bpm / 60.0 / outputSampleRate);
+        }
+        else
+        {
+            syncClock->release(deckId);
+        }
+    }
+
+    renderedSamples = endSample;
+
+    // Nothing below here touches the track, tracks retired before now may be deleted
+    handoffSource.endBlock();
+}
+
+void DJAudioPlayer::renderSpeedStage(const AudioSourceChannelInfo& info)
+{
+    if (keyLockActive)
+        timeStretcher.getNextAudioBlock(info);
+    else
+        resampleSource.getNextAudioBlock(info);
+}
+
+void DJAudioPlayer::updateSpeed(DeckTrack* track, int numSamples)
+{
+    double speed = userSpeed.load(std::memory_order_relaxed);
+    double bpm = 0.0;
+
+    if (!sync.load(std::memory_order_relaxed))
+    {
+        syncEngaged = false;
+        lastSyncedSpeed = 0.0;
+    }
+
+    if (track != nullptr && track->beatGrid.isValid() && outputSampleRate > 0.0 && numSamples > 0)
+    {
+        const BeatGrid& grid = track->beatGrid;
+        auto& transport = track->transportSource;
+        const double beatsPerSampleAtUnity = grid.bpm / 60.0 / outputSampleRate;
+        double masterBeat = 0.0;
+        double masterBeatsPerSample = 0.0;
+
+        if (sync.load(std::memory_order_relaxed) && syncClock != nullptr
+            && syncClock->getMasterBeat(deckId, renderedSamples, masterBeat, masterBeatsPerSample))
+        {
+            // Match the master's tempo exactly, then look at how far apart the beats are
+            speed = masterBeatsPerSample / beatsPerSampleAtUnity;
+
+            // The master publishes what it plays, so compare it with what this deck plays, not what it reads
+            double phaseError = masterBeat - grid.getBeatAt(getAudiblePosition(*track));
+            phaseError -= std::round(phaseError);
+
+            if (transport.isPlaying())
+            {
+                if (!syncEngaged)
+                {
+                    // Turning SYNC on jumps straight into phase, drift after that is only nudged
+                    transport.setPosition(jmax(0.0, transport.getCurrentPosition() + phaseError * grid.getPeriodSeconds()));
+                }
+                else
+                {
+                    const double nudge = phaseCorrectionPerBlock * phaseError / (beatsPerSampleAtUnity * numSamples);
+                    speed += jlimit(-maxPhaseNudge * speed, maxPhaseNudge * speed, nudge);
+                }
+            }
+
+            syncEngaged = true;
+            lastSyncedSpeed = speed;
+        }
+        else if (lastSyncedSpeed > 0.0)
+        {
+            // The master stopped, hold the tempo it left this deck at
+            speed = lastSyncedSpeed;
+        }
+
+        bpm = grid.bpm * speed;
+    }
+
+    resampleSource.setResamplingRatio(speed);
+    timeStretcher.setTempo(speed);
+
+    appliedSpeed.store(speed, std::memory_order_relaxed);
+    appliedBpm.store(bpm, std::memory_order_relaxed);
+}
+
+void DJAudioPlayer::releaseResources() 
+{
+    timeStretcher.releaseResources();
+    resampleSource.releaseResources();
+}
+
+void DJAudioPlayer::loadURL(URL audioURL)
+{
+    auto track = createTrack(audioURL);
+    if (track != nullptr) // good file!
+    {
+        publishTrack(std::move(track));
+    }
+}
+
+void DJAudioPlayer::loadURLAsync(URL audioURL, std::function<void(bool)> onLoaded, const BeatGrid& beatGrid, float trimGain)
+{
+    const int generation = ++loadGeneration;
+    loadCallback = std::move(onLoaded);
+
+    // The previous load is superseded, so stop analysing it rather than queue behind it
+    loaderPool.removeAllJobs(true, 0);
+
+    loaderPool.addJob([this, audioURL, beatGrid, trimGain, generation]
+        {
+            auto track = createTrack(audioURL);
+
+            // A newer load was requested while this one was opening the file
+            if (generation != loadGeneration.load())
+                return;
+
+            const bool loaded = track != nullptr;
+
+            if (loaded)
+            {
+                track->beatGrid = beatGrid;
+
+                // The transport applies the trim before the deck gain, from its very first block
+                track->transportSource.setGain(trimGain > 0.0f ? trimGain : 1.0f);
+            }
+
+            {
+                const ScopedLock sl(loadLock);
+
+                // A newer load may have started since the check above, its result must not be replaced
+                if (generation != loadGeneration.load())
+                    return;
+
+                loadedTrack = std::move(track);
+                loadedGeneration = generation;
+                loadFinished = true;
+            }
+
+            triggerAsyncUpdate();
+
+            if (!loaded)
+                return;
+
+            // Tracks from outside the library are analysed while they already play, in a single decode
+            if ((trimGain > 0.0f && beatGrid.isValid()) || generation != loadGeneration.load())
+                return;
+
+            const auto analysis = ContentAnalyser::analyseTrack(formatManager, audioURL.toString(false));
+
+            if (generation != loadGeneration.load())
+                return;
+
+            {
+                const ScopedLock sl(loadLock);
+
+                if (trimGain <= 0.0f && analysis.Loudness.WasAnalysed)
+                {
+                    analysedTrimGain = LoudnessAnalyser::getTrimGain(analysis.Loudness.IntegratedLufs, analysis.Loudness.TruePeakDb);
+                    trimFinished = true;
+                }
+
+                if (!beatGrid.isValid() && analysis.Beats.WasAnalysed)
+                {
+                    analysedGrid = BeatGrid{ analysis.Beats.Bpm, analysis.Beats.FirstBeatSeconds };
+                    gridFinished = true;
+                }
+
+                analysedGeneration = generation;
+            }
+
+            triggerAsyncUpdate();
+        });
+}
+
+void DJAudioPlayer::handleAsyncUpdate()
+{
+    std::unique_ptr<DeckTrack> track;
+    bool hasLoad = false;
+    bool hasGrid = false;
+    BeatGrid grid;
+    bool hasTrim = false;
+    float trimGain = 1.0f;
+
+    {
+        const ScopedLock sl(loadLock);
+
+        // loadURLAsync runs on this thread too, so the generation cannot move during the handoff
+        hasLoad = loadFinished && loadedGeneration == loadGeneration.load();
+        track = std::move(loadedTrack);
+        loadFinished = false;
+
+        hasGrid = gridFinished && analysedGeneration == loadGeneration.load();
+        grid = analysedGrid;
+        gridFinished = false;
+
+        hasTrim = trimFinished && analysedGeneration == loadGeneration.load();
+        trimGain = analysedTrimGain;
+        trimFinished = false;
+    }
+
+    // Analysis commands are queued after the track is published, so they land on the new track
+    if (!hasLoad)
+    {
+        if (hasTrim)
+            setTrimGain(trimGain);
+
+        if (hasGrid)
+            setBeatGrid(grid);
+
+        return;
+    }
+
+    const bool loaded = track != nullptr;
+
+    if (loaded)
+    {
+        publishTrack(std::move(track));
+    }
+
+    if (hasTrim)
+        setTrimGain(trimGain);
+
+    if (hasGrid)
+        setBeatGrid(grid);
+
+    if (loadCallback != nullptr)
+    {
+        auto callback = std::move(loadCallback);
+        loadCallback = nullptr;
+        callback(loaded);
+    }
+}
+
+void DJAudioPlayer::timerCallback()
+{
+    collectRetiredTracks();
+}
+
+void DJAudioPlayer::collectRetiredTracks()
+{
+    handoffSource.collectGarbage();
+}
+
+std::unique_ptr<DeckTrack> DJAudioPlayer::createTrack(const URL& audioURL)
+{
+    if (ramResident && sampleCache != nullptr)
+    {
+        if (auto sample = sampleCache->getOrDecode(audioURL))
+        {
+            DBG("SampleCache hit rate: " << sampleCache->getHitRate()
+                << ", resident bytes: " << sampleCache->getResidentBytes());
+            return DeckTrack::createResident(audioURL, std::move(sample));
+        }
+
+        DBG("DJAudioPlayer::createTrack could not keep the track in RAM, streaming it instead");
+    }
+
+    return DeckTrack::create(formatManager, audioURL, readAheadThread, readAheadBufferSize, underrunCount);
+}
+
+void DJAudioPlayer::publishTrack(std::unique_ptr<DeckTrack> track)
+{
+    handoffSource.publish(std::move(track));
+}
+
+void DJAudioPlayer::pushCommand(Command::Type type, double value, double secondValue)
+{
+    const auto scope = commandFifo.write(1);
+
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        DBG("DJAudioPlayer::pushCommand command queue is full, dropping command");
+        return;
+    }
+
+    commands[(size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = Command{ type, value, secondValue };
+}
+
+void DJAudioPlayer::applyPendingCommands(DeckTrack* track)
+{
+    const auto scope = commandFifo.read(commandFifo.getNumReady());
+
+    auto apply = [this, track](const Command& command)
+    {
+        if (track == nullptr)
+            return;
+
+        auto& transport = track->transportSource;
+
+        switch (command.type)
+        {
+            case Command::Type::start:
+                startQuantised(*track);
+                break;
+
+            case Command::Type::stop:
+                pendingStartSample = -1;
+                transport.stop();
+                break;
+
+            case Command::Type::seekSeconds:
+                transport.setPosition(quantiseSeek(*track, command.value));
+                break;
+
+            case Command::Type::seekRelative:
+                transport.setPosition(quantiseSeek(*track, transport.getLengthInSeconds() * command.value));
+                break;
+
+            case Command::Type::cue:
+                if (transport.isPlaying() || pendingStartSample >= 0)
+                {
+                    // Back to the cue point, ready to play from it again
+                    pendingStartSample = -1;
+                    transport.stop();
+                }
+                else
+                {
+                    const double position = transport.getCurrentPosition();
+                    track->cuePointSeconds = track->beatGrid.isValid() ? jmax(0.0, track->beatGrid.snapToNearestBeat(position)) : position;
+                }
+
+                transport.setPosition(track->cuePointSeconds);
+                break;
+
+            case Command::Type::setBeatGrid:
+                track->beatGrid = BeatGrid{ command.value, command.secondValue };
+                break;
+
+            case Command::Type::setTrimGain:
+                // The transport ramps from its previous gain over the block
+                transport.setGain(static_cast<float>(command.value));
+                break;
+
+            case Command::Type::loopIn:
+                track->loopInSeconds = quantiseLoopPoint(*track, transport.getCurrentPosition());
+                track->loopOutSeconds = -1.0;
+                track->loopEngaged = false;
+                break;
+
+            case Command::Type::loopOut:
+                if (track->loopEngaged)
+                {
+                    track->loopEngaged = false;
+                }
+                else if (track->loopInSeconds >= 0.0)
+                {
+                    double outSeconds = quantiseLoopPoint(*track, transport.getCurrentPosition());
+
+                    // Snapping can land back on the in point, the shortest loop on a grid is one beat
+                    if (track->beatGrid.isValid() && outSeconds <= track->loopInSeconds)
+                        outSeconds = track->loopInSeconds + track->beatGrid.getPeriodSeconds();
+
+                    if (outSeconds > track->loopInSeconds)
+                    {
+                        track->loopOutSeconds = outSeconds;
+                        track->loopEngaged = true;
+                    }
+                }
+                break;
+
+            case Command::Type::beatLoop:
+                if (track->beatGrid.isValid() && command.value > 0.0)
+                {
+                    // Loops shorter than a beat start on the matching fraction of the beat
+                    const BeatGrid& grid = track->beatGrid;
+                    const double step = jmin(1.0, command.value);
+                    const double startBeat = std::floor(grid.getBeatAt(transport.getCurrentPosition()) / step) * step;
+
+                    track->loopInSeconds = jmax(0.0, grid.getTimeOfBeat(startBeat));
+                    track->loopOutSeconds = grid.getTimeOfBeat(startBeat + command.value);
+                    track->loopEngaged = track->loopOutSeconds > track->loopInSeconds;
+                }
+                break;
+
+            case Command::Type::exitLoop:
+                track->loopEngaged = false;
+                break;
+        }
+    };
+
+    for (int i = 0; i < scope.blockSize1; ++i)
+        apply(commands[(size_t) (scope.startIndex1 + i)]);
+
+    for (int i = 0; i < scope.blockSize2; ++i)
+        apply(commands[(size_t) (scope.startIndex2 + i)]);
+}
+
+void DJAudioPlayer::startQuantised(DeckTrack& track)
+{
+    auto& transport = track.transportSource;
+    double masterBeat = 0.0;
+    double masterBeatsPerSample = 0.0;
+
+    if (transport.isPlaying() || !sync.load(std::memory_order_relaxed) || !track.beatGrid.isValid()
+        || syncClock == nullptr || !syncClock->getMasterBeat(deckId, renderedSamples, masterBeat, masterBeatsPerSample)
+        || masterBeatsPerSample <= 0.0)
+    {
+        transport.start();
+        return;
+    }
+
+    // Start from a beat of this track exactly when the master reaches its next beat. The first
+    // samples take the speed stage's latency to come out, so the transport starts that much earlier.
+    transport.setPosition(jmax(0.0, track.beatGrid.snapToNearestBeat(transport.getCurrentPosition())));
+
+    const double latency = getSpeedStageLatency() / jmax(0.0001, appliedSpeed.load(std::memory_order_relaxed));
+    double samplesToBeat = (std::ceil(masterBeat) - masterBeat) / masterBeatsPerSample;
+
+    while (samplesToBeat < latency)
+        samplesToBeat += 1.0 / masterBeatsPerSample;
+
+    pendingStartSample = renderedSamples + static_cast<juce::int64>(std::round(samplesToBeat - latency));
+}
+
+double DJAudioPlayer::quantiseSeek(const DeckTrack& track, double targetSeconds) const
+{
+    const BeatGrid& grid = track.beatGrid;
+
+    if (!sync.load(std::memory_order_relaxed) || !grid.isValid() || !track.transportSource.isPlaying())
+        return targetSeconds;
+
+    // Land on the beat nearest the target with the phase the deck is playing at now
+    const double currentBeat = grid.getBeatAt(track.transportSource.getCurrentPosition());
+    const double phase = currentBeat - std::floor(currentBeat);
+    return jmax(0.0, grid.getTimeOfBeat(std::round(grid.getBeatAt(targetSeconds) - phase) + phase));
+}
+
+double DJAudioPlayer::getSpeedStageLatency() const noexcept
+{
+    return keyLockActive ? timeStretcher.getLatencySamples() : resampleSource.getLatencySamples();
+}
+
+double DJAudioPlayer::getAudiblePosition(const DeckTrack& track) const noexcept
+{
+    if (outputSampleRate <= 0.0)
+        return track.transportSource.getCurrentPosition();
+
+    return jmax(0.0, track.transportSource.getCurrentPosition() - getSpeedStageLatency() / outputSampleRate);
+}
+
+double DJAudioPlayer::quantiseLoopPoint(const DeckTrack& track, double seconds) const
+{
+    return track.beatGrid.isValid() ? jmax(0.0, track.beatGrid.snapToNearestBeat(seconds)) : seconds;
+}
+
+void DJAudioPlayer::updateLoop(DeckTrack* track)
+{
+    // A streamed track starts caching its loop start as soon as the loop in point is set
+    if (track != nullptr && track->loopStartCache != nullptr)
+    {
+        if (track->loopInSeconds >= 0.0)
+            track->loopStartCache->setLoopStart(track->loopInSeconds);
+        else if (loopTrack.load(std::memory_order_relaxed))
+            track->loopStartCache->setLoopStart(0.0);
+    }
+
+    // A loop of the deck's own takes over from looping the whole track
+    if (track != nullptr && track->loopEngaged)
+        loopingSource.setLoop(track->loopInSeconds, track->loopOutSeconds);
+    else if (track != nullptr && loopTrack.load(std::memory_order_relaxed))
+        loopingSource.setLoop(0.0, track->transportSource.getLengthInSeconds());
+    else
+        loopingSource.clearLoop();
+}
+
+void DJAudioPlayer::setGain(double gain)
+{
+    if (gain < 0 || gain > 1.0) 
+    {
+        DBG("DJAudioPlayer::setGain gain should be between 0 and 1");
+    }
+    else
+    {
+        targetGain = static_cast<float>(gain);
+    }
+}
+
+void DJAudioPlayer::setTrimGain(float trimGain)
+{
+    if (trimGain <= 0.0f)
+    {
+        DBG("DJAudioPlayer::setTrimGain trim gain should be positive");
+        return;
+    }
+
+    // The trim belongs to the track, so it is set by the audio thread on the track being rendered
+    pushCommand(Command::Type::setTrimGain, trimGain);
+}
+
+// changed the ratio to be <= 0 to prevent breakpoint activation
+void DJAudioPlayer::setSpeed(double ratio)
+{
+    if (ratio <= 0 || ratio > 5.0) {
+        DBG("DJAudioPlayer::setSpeed ratio should be between 0 and 5");
+    }
+    else {
+        // The audio thread applies it at the next block, unless SYNC sets the speed
+        userSpeed = ratio;
+    }
+}
+
+double DJAudioPlayer::getSpeed() const
+{
+    return appliedSpeed.load(std::memory_order_relaxed);
+}
+
+void DJAudioPlayer::setBeatGrid(const BeatGrid& beatGrid)
+{
+    pushCommand(Command::Type::setBeatGrid, beatGrid.bpm, beatGrid.firstBeatSeconds);
+}
+
+double DJAudioPlayer::getBpm() const
+{
+    return appliedBpm.load(std::memory_order_relaxed);
+}
+
+void DJAudioPlayer::setSync(bool shouldSync)
+{
+    sync = shouldSync;
+}
+
+bool DJAudioPlayer::isSynced() const
+{
+    return sync;
+}
+
+bool DJAudioPlayer::isSyncMaster() const
+{
+    return syncClock != nullptr && syncClock->getMasterDeck() == deckId;
+}
+
+void DJAudioPlayer::setSyncClock(SyncClock* _syncClock, int _deckId)
+{
+    syncClock = _syncClock;
+    deckId = _deckId;
+}
+
+void DJAudioPlayer::setResamplingMode(DeckResampler::Mode mode)
+{
+    resampleSource.setMode(mode);
+}
+
+DeckResampler::Mode DJAudioPlayer::getResamplingMode() const
+{
+    return resampleSource.getMode();
+}
+
+void DJAudioPlayer::setKeyLock(bool shouldLockKey)
+{
+    keyLock = shouldLockKey;
+}
+
+bool DJAudioPlayer::isKeyLocked() const
+{
+    return keyLock;
+}
+
+void DJAudioPlayer::setPosition(double posInSec)
+{
+    pushCommand(Command::Type::seekSeconds, posInSec);
+}
+
+void DJAudioPlayer::start()
+{
+    pushCommand(Command::Type::start);
+}
+
+void DJAudioPlayer::pause()
+{
+    pushCommand(Command::Type::stop);
+}
+
+void DJAudioPlayer::cue()
+{
+    pushCommand(Command::Type::cue);
+}
+
+void DJAudioPlayer::setLoopTrack(bool shouldLoop)
+{
+    loopTrack = shouldLoop;
+}
+
+bool DJAudioPlayer::isLoopingTrack() const
+{
+    return loopTrack;
+}
+
+void DJAudioPlayer::setLoopIn()
+{
+    pushCommand(Command::Type::loopIn);
+}
+
+void DJAudioPlayer::setLoopOut()
+{
+    pushCommand(Command::Type::loopOut);
+}
+
+void DJAudioPlayer::setBeatLoop(double numBeats)
+{
+    if (numBeats <= 0.0)
+    {
+        DBG("DJAudioPlayer::setBeatLoop number of beats should be positive");
+        return;
+    }
+
+    // The beat grid belongs to the track, so the audio thread places the loop on it
+    pushCommand(Command::Type::beatLoop, numBeats);
+}
+
+void DJAudioPlayer::exitLoop()
+{
+    pushCommand(Command::Type::exitLoop);
+}
+
+bool DJAudioPlayer::isLooping() const
+{
+    return loopEngaged.load(std::memory_order_relaxed);
+}
+
+double DJAudioPlayer::getLoopStartSeconds() const
+{
+    return loopStartSeconds.load(std::memory_order_relaxed);
+}
+
+double DJAudioPlayer::getLoopEndSeconds() const
+{
+    return loopEndSeconds.load(std::memory_order_relaxed);
+}
+
+// Get the relative position of the playback
+double DJAudioPlayer::getPositionRelative()
+{
+    const double length = lengthInSeconds.load(std::memory_order_relaxed);
+
+    if (length <= 0.0)
+    {
+        return 0.0;
+    }
+
+    return playheadSeconds.load(std::memory_order_relaxed) / length;
+}
+
+double DJAudioPlayer::getPositionInSeconds() const
+{
+    return playheadSeconds.load(std::memory_order_relaxed);
+}
+
+double DJAudioPlayer::getLengthInSeconds() const
+{
+    return lengthInSeconds.load(std::memory_order_relaxed);
+}
+
+// Set the playback position based on a relative value
+void DJAudioPlayer::setPositionRelative(double pos)
+{
+    if (pos < 0 || pos > 1.0)
+    {
+        // Print a warning if the relative position is out of bounds
+        std::cout << "DJAudioPlayer::setPositionRelative: Relative pos should be between 0 and 1." << std::endl;
+    }
+    else
+    {
+        // The audio thread converts the relative position to seconds using the track it is playing
+        pushCommand(Command::Type::seekRelative, pos);
+    }
+}
+
+void DJAudioPlayer::setReadAheadBufferSize(int numSamples)
+{
+    if (numSamples <= 0)
+    {
+        DBG("DJAudioPlayer::setReadAheadBufferSize buffer size should be positive");
+    }
+    else
+    {
+        readAheadBufferSize = numSamples;
+    }
+}
+
+int DJAudioPlayer::getReadAheadBufferSize() const
+{
+    return readAheadBufferSize;
+}
+
+int DJAudioPlayer::getUnderrunCount() const
+{
+    return underrunCount.load(std::memory_order_relaxed);
+}
+
+void DJAudioPlayer::setRamResident(bool shouldBeResident)
+{
+    ramResident = shouldBeResident;
+}
+
+bool DJAudioPlayer::isRamResident() const
+{
+    return ramResident;
+}
+
+void DJAudioPlayer::setProfiler(CallbackProfiler* _profiler, int _readStage, int _resampleStage)
+{
+    profiler = _profiler;
+    readStage = _readStage;
+    resampleStage = _resampleStage;
 }
\ No newline at end of file
@@ -1,120 +1,632 @@
-/*
-  ==============================================================================
-
-    DJAudioPlayer.h
-    Created: 31 Jan 2024 12:05:59pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#pragma once
-// Include juce library
-#include <JuceHeader.h>
-
-/**
- * The DJAudioPlayer class is responsible for audio playback.
- * It implements the AudioSource interface and provides methods for loading
- * audio files, controlling playback parameters, and managing audio resources.
- */
-class DJAudioPlayer : public AudioSource
-{
-public:
-    /**
-     * Constructor for DJAudioPlayer.
-     * @param _formatManager Reference to the AudioFormatManager.
-     */
-    DJAudioPlayer(AudioFormatManager& _formatManager);
-
-    /**
-     * Destructor for DJAudioPlayer.
-     */
-    ~DJAudioPlayer();
-
-    /**
-     * Called to signal that the audio device is ready to start processing audio.
-     * @param samplesPerBlockExpected The number of samples in each block of audio.
-     * @param sampleRate The sample rate of the audio stream.
-     */
-    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
-    
-    /**
-     * Override of the getNextAudioBlock method to provide the next audio block.
-     * @param bufferToFill The buffer that will be filled with audio data.
-     */
-    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
-    
-    /**
-     * Override of the releaseResources method to release audio resources.
-     */
-    void releaseResources() override;
-
-    // Audio playback control functions
-    /**
-     * Load a new audio file from the specified URL.
-     * @param audioURL The URL of the audio file to load.
-     */
-    void loadURL(URL audioURL);
-
-    /**
-     * Set the gain (volume) of the audio player.
-     * @param gain The desired gain value (between 0.0 and 1.0).
-     */
-    void setGain(double gain);
-
-    /**
-     * Set the speed (resampling ratio) of the audio player.
-     * @param ratio The desired resampling ratio (positive value, typically between 0 and 5).
-     */
-    void setSpeed(double ratio);
-
-    /**
-     * Set the playback position in seconds.
-     * @param posInSec The desired playback position in seconds.
-     */
-    void setPosition(double posInSec);
-
-    /**
-     * Set the playback position based on a relative value.
-     * @param pos The relative playback position (between 0 and 1).
-     */
-    void setPositionRelative(double pos);
-
-    /**
-     * Start audio playback.
-     */
-    void start();
-
-    /**
-     * Pause audio playback.
-     */
-    void pause();
-
-    /**
-     * Get the relative position of the playback.
-     * @return The relative position of the playback.
-     */
-    double getPositionRelative();
-
-private:
-    // & make it reference
-    /**
-     * Reference to the AudioFormatManager.
-     */
-    AudioFormatManager& formatManager;
-
-    /**
-     * Unique pointer to manage the AudioFormatReaderSource's lifecycle.
-     */
-    std::unique_ptr<AudioFormatReaderSource> readerSource;
-
-    /**
-     * AudioTransportSource for managing audio playback.
-     */
-    AudioTransportSource transportSource;
-
-    /**
-     * ResamplingAudioSource with transportSource as the input, no interpolation, and a resampling ratio of 2.
-     */
-    ResamplingAudioSource resampleSource{ &transportSource, false, 2 };
+/*
+  ==============================================================================
+
+    DJAudioPlayer.h
+    Created: 31 Jan 2024 12:05:59pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+// Include juce library
+#include <JuceHeader.h>
+#include "DeckTrack.h"
+#include "TrackHandoffSource.h"
+#include "LoopingSource.h"
+#include "SampleCache.h"
+#include "DeckResampler.h"
+#include "TimeStretcher.h"
+#include "CallbackProfiler.h"
+#include "SyncClock.h"
+#include "BeatGrid.h"
+
+/**
+ * The DJAudioPlayer class is responsible for audio playback.
+ * It implements the AudioSource interface and provides methods for loading
+ * audio files, controlling playback parameters, and managing audio resources.
+ *
+ * Tracks are opened on a background loader thread and handed to the audio
+ * thread through a TrackHandoffSource, so loading never blocks the audio callback.
+ *
+ * The control methods never touch objects the audio thread is using. Gain and
+ * speed are stored in atomics and ramped by the audio thread; start, pause and
+ * seeks go through a lock-free single-producer single-consumer command queue and
+ * are applied at the start of the next block. The playhead is published back
+ * through atomics after every block.
+ *
+ * Every track carries a beat grid. With SYNC on, the audio thread sets the speed
+ * ratio at the start of every block so the deck's tempo matches the master deck on
+ * the shared SyncClock, and bends it slightly to pull the beats into phase. Starts
+ * are then quantised to the master's next beat at sample precision, and seeks keep
+ * the deck's phase.
+ *
+ * Every track also carries an auto-gain trim from its loudness analysis, applied by
+ * its own transport before the deck's gain, so every track plays equally loud.
+ *
+ * Loops are played by the audio thread too. In and out points and beat loops are
+ * set through the command queue, snapped to the beat grid, and a LoopingSource in
+ * front of the speed stages wraps around them at sample precision with a short
+ * crossfade. The whole track loops the same way when track looping is on. A track
+ * that plays to its end without a loop goes back to the start, paused.
+ */
+class DJAudioPlayer : public AudioSource,
+                      private AsyncUpdater,
+                      private Timer
+{
+public:
+    /**
+     * Constructor for DJAudioPlayer.
+     * @param _formatManager Reference to the AudioFormatManager.
+     * @param _sampleCache Cache of decoded tracks shared between players, or nullptr to disable RAM-resident mode.
+     */
+    DJAudioPlayer(AudioFormatManager& _formatManager, SampleCache* _sampleCache = nullptr);
+
+    /**
+     * Destructor for DJAudioPlayer.
+     */
+    ~DJAudioPlayer();
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+    
+    /**
+     * Override of the getNextAudioBlock method to provide the next audio block.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+    
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Delete the tracks the audio thread has retired and finished with. The timer does this
+     * every half second; code that loads tracks without a message loop, such as an offline
+     * render, must call it itself between blocks, or the retire queue fills and loads are dropped.
+     * Call on the thread that loads tracks.
+     */
+    void collectRetiredTracks();
+
+    // Audio playback control functions
+    /**
+     * Load a new audio file from the specified URL on the calling thread.
+     * @param audioURL The URL of the audio file to load.
+     */
+    void loadURL(URL audioURL);
+
+    /**
+     * Load a new audio file from the specified URL on the background loader thread.
+     * If another load is requested before this one finishes, only the newest one is used.
+     * A track without a known loudness or beat grid is analysed on the loader thread
+     * after it has been handed over, so the deck can play straight away.
+     * @param audioURL The URL of the audio file to load.
+     * @param onLoaded Called on the message thread once the track has been handed
+     *                 to the audio thread, with false if the file could not be opened.
+     * @param beatGrid The beat grid from the library, or an empty grid if it is unknown.
+     * @param trimGain The auto-gain trim from the library, or 0 if the loudness is unknown.
+     */
+    void loadURLAsync(URL audioURL, std::function<void(bool)> onLoaded, const BeatGrid& beatGrid = {}, float trimGain = 0.0f);
+
+    /**
+     * Set the gain (volume) of the audio player.
+     * @param gain The desired gain value (between 0.0 and 1.0).
+     */
+    void setGain(double gain);
+
+    /**
+     * Set the auto-gain trim of the loaded track, applied before the gain and ramped
+     * over the next block.
+     * @param trimGain The linear trim gain (positive value).
+     */
+    void setTrimGain(float trimGain);
+
+    /**
+     * Set the speed (resampling ratio) of the audio player. Ignored while SYNC is on.
+     * @param ratio The desired resampling ratio (positive value, typically between 0 and 5).
+     */
+    void setSpeed(double ratio);
+
+    /**
+     * Get the speed ratio the audio thread applied to the last block, including SYNC.
+     * @return The resampling ratio in use.
+     */
+    double getSpeed() const;
+
+    /**
+     * Replace the beat grid of the loaded track.
+     * @param beatGrid The new beat grid.
+     */
+    void setBeatGrid(const BeatGrid& beatGrid);
+
+    /**
+     * Get the tempo of the loaded track at the current speed, as of the last audio block.
+     * @return The tempo in BPM, or 0 if the track has no beat grid.
+     */
+    double getBpm() const;
+
+    /**
+     * Follow the tempo and phase of the master deck, and quantise starts and seeks to its beats.
+     * @param shouldSync True to sync to the master deck.
+     */
+    void setSync(bool shouldSync);
+
+    /**
+     * Check whether SYNC is on.
+     * @return True if the deck follows the master deck.
+     */
+    bool isSynced() const;
+
+    /**
+     * Check whether this deck is the master the synced decks follow.
+     * @return True if this deck holds the master role on the SyncClock.
+     */
+    bool isSyncMaster() const;
+
+    /**
+     * Share a master clock with the other decks. Must be called before the audio device starts.
+     * @param _syncClock The clock shared by every deck, or nullptr to disable SYNC.
+     * @param _deckId A number that identifies this deck on the clock.
+     */
+    void setSyncClock(SyncClock* _syncClock, int _deckId);
+
+    /**
+     * Select the interpolation kernel used by the speed control.
+     * @param mode The kernel to use.
+     */
+    void setResamplingMode(DeckResampler::Mode mode);
+
+    /**
+     * Get the interpolation kernel used by the speed control.
+     * @return The kernel in use.
+     */
+    DeckResampler::Mode getResamplingMode() const;
+
+    /**
+     * Enable or disable key lock. With key lock on, the speed control changes the
+     * tempo through the TimeStretcher and leaves the pitch alone.
+     * @param shouldLockKey True to keep the pitch when the speed changes.
+     */
+    void setKeyLock(bool shouldLockKey);
+
+    /**
+     * Check whether key lock is enabled.
+     * @return True if the speed control keeps the pitch.
+     */
+    bool isKeyLocked() const;
+
+    /**
+     * Set the playback position in seconds.
+     * @param posInSec The desired playback position in seconds.
+     */
+    void setPosition(double posInSec);
+
+    /**
+     * Set the playback position based on a relative value.
+     * @param pos The relative playback position (between 0 and 1).
+     */
+    void setPositionRelative(double pos);
+
+    /**
+     * Start audio playback. With SYNC on, playback starts on the master's next beat.
+     */
+    void start();
+
+    /**
+     * Cue button: while playing, jump back to the cue point and pause; while paused,
+     * set the cue point at the playhead, moved to the nearest beat if the track has a grid.
+     */
+    void cue();
+
+    /**
+     * Pause audio playback.
+     */
+    void pause();
+
+    /**
+     * Loop the whole track: the end wraps straight back to the start instead of stopping.
+     * @param shouldLoop True to loop the track.
+     */
+    void setLoopTrack(bool shouldLoop);
+
+    /**
+     * Check whether the whole track loops.
+     * @return True if the end of the track wraps back to its start.
+     */
+    bool isLoopingTrack() const;
+
+    /**
+     * Loop in button: set the loop in point at the playhead, moved to the nearest beat if
+     * the track has a grid. Leaves a loop the deck is playing.
+     */
+    void setLoopIn();
+
+    /**
+     * Loop out button: set the loop out point at the playhead, moved to the nearest beat if
+     * the track has a grid, and start looping from the in point. Leaves the loop if the deck
+     * is already looping.
+     */
+    void setLoopOut();
+
+    /**
+     * Loop a number of beats, starting from the beat the playhead is in.
+     * Needs a beat grid, ignored without one.
+     * @param numBeats The length of the loop in beats, for instance 0.5, 1, 4 or 16.
+     */
+    void setBeatLoop(double numBeats);
+
+    /**
+     * Leave the loop the deck is playing and play on past its out point.
+     */
+    void exitLoop();
+
+    /**
+     * Check whether the deck is playing a loop, as of the last audio block.
+     * @return True if an in/out loop or a beat loop is engaged.
+     */
+    bool isLooping() const;
+
+    /**
+     * Get the loop in point, as of the last audio block.
+     * @return The loop start in seconds, or -1 if it is unset.
+     */
+    double getLoopStartSeconds() const;
+
+    /**
+     * Get the loop out point, as of the last audio block.
+     * @return The loop end in seconds, or -1 if it is unset.
+     */
+    double getLoopEndSeconds() const;
+
+    /**
+     * Get the relative position of the playback, as of the last audio block.
+     * @return The relative position of the playback.
+     */
+    double getPositionRelative();
+
+    /**
+     * Get the playback position, as of the last audio block.
+     * @return The position in seconds.
+     */
+    double getPositionInSeconds() const;
+
+    /**
+     * Get the length of the loaded track, as of the last audio block.
+     * @return The length in seconds, or 0 if no track has been played yet.
+     */
+    double getLengthInSeconds() const;
+
+    /**
+     * Set the size of the read-ahead buffer used for compressed formats.
+     * Takes effect the next time a track is loaded.
+     * @param numSamples The number of samples to buffer ahead of the playhead.
+     */
+    void setReadAheadBufferSize(int numSamples);
+
+    /**
+     * Get the size of the read-ahead buffer used for compressed formats.
+     * @return The number of samples buffered ahead of the playhead.
+     */
+    int getReadAheadBufferSize() const;
+
+    /**
+     * Get the number of audio blocks that were played before the read-ahead
+     * thread had buffered them, since this player was created.
+     * @return The underrun count.
+     */
+    int getUnderrunCount() const;
+
+    /**
+     * Enable or disable RAM-resident mode. When enabled, tracks loaded afterwards
+     * are decoded fully into the shared SampleCache so seeking never touches the disk.
+     * Tracks that do not fit in the cache budget are streamed as usual.
+     * @param shouldBeResident True to decode tracks into RAM.
+     */
+    void setRamResident(bool shouldBeResident);
+
+    /**
+     * Check whether RAM-resident mode is enabled.
+     * @return True if tracks are decoded into RAM.
+     */
+    bool isRamResident() const;
+
+    /**
+     * Time every block of this player in a profiler. Must be called before the audio device starts.
+     * @param _profiler The profiler to record into, or nullptr to stop recording.
+     * @param _readStage The stage that receives the time spent reading the track.
+     * @param _resampleStage The stage that receives the time spent in the speed control, excluding reads.
+     */
+    void setProfiler(CallbackProfiler* _profiler, int _readStage, int _resampleStage);
+
+private:
+    /**
+     * A transport change queued by the message thread for the audio thread.
+     */
+    struct Command
+    {
+        enum class Type
+        {
+            start,
+            stop,
+            seekSeconds,
+            seekRelative,
+            cue,
+            setBeatGrid,
+            setTrimGain,
+            loopIn,
+            loopOut,
+            beatLoop,
+            exitLoop
+        };
+
+        Type type = Type::stop;
+        double value = 0.0;
+        double secondValue = 0.0;
+    };
+
+    /**
+     * Queue a command for the audio thread. Called on the message thread.
+     * @param type The kind of command.
+     * @param value The position for seek commands, the tempo for beat grid commands,
+     *              the gain for trim commands, the number of beats for beat loop commands.
+     * @param secondValue The first downbeat for beat grid commands.
+     */
+    void pushCommand(Command::Type type, double value = 0.0, double secondValue = 0.0);
+
+    /**
+     * Apply every queued command to the rendered track. Called on the audio thread.
+     * @param track The track being rendered, or nullptr.
+     */
+    void applyPendingCommands(DeckTrack* track);
+
+    /**
+     * Start the transport, on the master's next beat when SYNC is on. Called on the audio thread.
+     * @param track The track being rendered.
+     */
+    void startQuantised(DeckTrack& track);
+
+    /**
+     * Move a seek target so the deck keeps its beat phase while synced. Called on the audio thread.
+     * @param track The track being rendered.
+     * @param targetSeconds The requested position.
+     * @return The position to seek to.
+     */
+    double quantiseSeek(const DeckTrack& track, double targetSeconds) const;
+
+    /**
+     * Get the input latency of the active speed stage, in output samples of the track. Called on the audio thread.
+     * @return The number of samples the transport has read ahead of what the deck is playing.
+     */
+    double getSpeedStageLatency() const noexcept;
+
+    /**
+     * Get the position in the track the deck is playing now, which trails the transport by the
+     * latency of the speed stage. Called on the audio thread.
+     * @param track The track being rendered.
+     * @return The audible position in seconds.
+     */
+    double getAudiblePosition(const DeckTrack& track) const noexcept;
+
+    /**
+     * Move a loop point to the nearest beat if the track has a grid. Called on the audio thread.
+     * @param track The track being rendered.
+     * @param seconds The position of the loop point.
+     * @return The position to loop at.
+     */
+    double quantiseLoopPoint(const DeckTrack& track, double seconds) const;
+
+    /**
+     * Tell the LoopingSource which loop to play in the next block. Called on the audio thread.
+     * @param track The track being rendered, or nullptr.
+     */
+    void updateLoop(DeckTrack* track);
+
+    /**
+     * Set the speed ratio of the next block from the speed control or the master deck.
+     * Called on the audio thread before the block is rendered.
+     * @param track The track being rendered, or nullptr.
+     * @param numSamples The number of samples in the block.
+     */
+    void updateSpeed(DeckTrack* track, int numSamples);
+
+    /**
+     * Render part of a block through the active speed stage. Called on the audio thread.
+     * @param info The part of the buffer to fill.
+     */
+    void renderSpeedStage(const AudioSourceChannelInfo& info);
+
+    /**
+     * Publish the track built by the loader thread and notify the caller. Runs on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    /**
+     * Reclaim tracks retired by the audio thread. Runs on the message thread.
+     */
+    void timerCallback() override;
+
+    /**
+     * Build a track with the current read-ahead settings.
+     * @param audioURL The URL of the audio file to open.
+     * @return The new track, or nullptr if the file could not be opened.
+     */
+    std::unique_ptr<DeckTrack> createTrack(const URL& audioURL);
+
+    /**
+     * Hand a track to the audio thread, carrying over the current gain.
+     * @param track The track to hand over.
+     */
+    void publishTrack(std::unique_ptr<DeckTrack> track);
+
+    // & make it reference
+    /**
+     * Reference to the AudioFormatManager.
+     */
+    AudioFormatManager& formatManager;
+
+    /**
+     * Background thread that decodes compressed formats ahead of the playhead.
+     */
+    TimeSliceThread readAheadThread{ "Deck Read-Ahead" };
+
+    /**
+     * Size of the read-ahead buffer in samples, a little under a second at 44.1 kHz by default.
+     */
+    std::atomic<int> readAheadBufferSize{ 32768 };
+
+    /**
+     * Number of blocks played before they were buffered.
+     */
+    std::atomic<int> underrunCount{ 0 };
+
+    /**
+     * Cache of decoded tracks shared between players. Not owned, may be null.
+     */
+    SampleCache* sampleCache;
+
+    /**
+     * Whether new tracks are decoded into the sample cache.
+     */
+    std::atomic<bool> ramResident{ false };
+
+    /**
+     * Gain requested by the message thread, ramped over 20 ms by the audio thread.
+     */
+    std::atomic<float> targetGain{ 1.0f };
+    SmoothedValue<float> gainSmoother{ 1.0f };
+
+    /**
+     * Speed set by the speed control, and the ratio and tempo the audio thread applied last.
+     */
+    std::atomic<double> userSpeed{ 1.0 };
+    std::atomic<double> appliedSpeed{ 1.0 };
+    std::atomic<double> appliedBpm{ 0.0 };
+
+    /**
+     * Master clock shared with the other decks. Not owned, may be null.
+     */
+    SyncClock* syncClock = nullptr;
+    int deckId = 0;
+    std::atomic<bool> sync{ false };
+
+    /**
+     * Output samples rendered since prepareToPlay(), the time base of the SyncClock.
+     */
+    juce::int64 renderedSamples = 0;
+    double outputSampleRate = 0.0;
+
+    /**
+     * Sample time of a start waiting for the master's next beat, or -1. Audio thread only.
+     */
+    juce::int64 pendingStartSample = -1;
+
+    /**
+     * The track rendered in the previous block and the last ratio SYNC applied to it. Audio thread only.
+     */
+    DeckTrack* previousTrack = nullptr;
+    double lastSyncedSpeed = 0.0;
+
+    /**
+     * Whether SYNC has already pulled the deck into phase since it was turned on. Audio thread only.
+     */
+    bool syncEngaged = false;
+
+    /**
+     * Lock-free queue of transport commands from the message thread.
+     */
+    static constexpr int commandQueueSize = 64;
+    AbstractFifo commandFifo{ commandQueueSize };
+    std::array<Command, commandQueueSize> commands;
+
+    /**
+     * Playhead and track length published by the audio thread after every block.
+     */
+    std::atomic<double> playheadSeconds{ 0.0 };
+    std::atomic<double> lengthInSeconds{ 0.0 };
+
+    /**
+     * Whether the whole track loops, as requested by the message thread.
+     */
+    std::atomic<bool> loopTrack{ false };
+
+    /**
+     * Loop state published by the audio thread after every block.
+     */
+    std::atomic<bool> loopEngaged{ false };
+    std::atomic<double> loopStartSeconds{ -1.0 };
+    std::atomic<double> loopEndSeconds{ -1.0 };
+
+    /**
+     * Plays the active track and swaps in newly loaded ones without locking.
+     */
+    TrackHandoffSource handoffSource;
+
+    /**
+     * Plays handoffSource and wraps around the loop, ahead of the speed stages.
+     */
+    LoopingSource loopingSource{ handoffSource };
+
+    /**
+     * DeckResampler with loopingSource as the input, applying the speed control.
+     */
+    DeckResampler resampleSource{ &loopingSource };
+
+    /**
+     * TimeStretcher with loopingSource as the input, applying the speed control when key lock is on.
+     */
+    TimeStretcher timeStretcher{ &loopingSource };
+
+    /**
+     * Key lock as requested by the message thread, and as last seen by the audio thread.
+     */
+    std::atomic<bool> keyLock{ false };
+    bool keyLockActive = false;
+
+    /**
+     * Single background thread that opens tracks for loadURLAsync.
+     */
+    ThreadPool loaderPool{ 1 };
+
+    /**
+     * Incremented for every asynchronous load so stale loads can be dropped.
+     */
+    std::atomic<int> loadGeneration{ 0 };
+
+    /**
+     * Result of the latest asynchronous load and the load it belongs to, guarded by loadLock.
+     */
+    CriticalSection loadLock;
+    std::unique_ptr<DeckTrack> loadedTrack;
+    int loadedGeneration = 0;
+    bool loadFinished = false;
+
+    /**
+     * Beat grid analysed after the latest asynchronous load, guarded by loadLock.
+     */
+    BeatGrid analysedGrid;
+    int analysedGeneration = 0;
+    bool gridFinished = false;
+
+    /**
+     * Trim gain measured after the latest asynchronous load, guarded by loadLock.
+     */
+    float analysedTrimGain = 1.0f;
+    bool trimFinished = false;
+
+    /**
+     * Callback of the latest asynchronous load. Only touched on the message thread.
+     */
+    std::function<void(bool)> loadCallback;
+
+    /**
+     * Profiler and stages the audio thread records into. Not owned, may be null.
+     */
+    CallbackProfiler* profiler = nullptr;
+    int readStage = -1;
+    int resampleStage = -1;
 };
\ No newline at end of file
@@ -1,302 +1,443 @@
-/*
-  ==============================================================================
-
-    DeckGUI.cpp
-    Created: 31 Jan 2024 1:20:40pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "DeckGUI.h"
-
-//==============================================================================
-DeckGUI::DeckGUI(DJAudioPlayer* _player,
-                 AudioFormatManager & formatManagerToUse,
-                 AudioThumbnailCache & cacheToUse,
-                 bool isDeck1) 
-    : player(_player),
-      waveformDisplay(formatManagerToUse, cacheToUse, isDeck1),
-      isDeck1(isDeck1)
-{
-    // Output the music name and waveform
-    initializeComponents();
-
-    // Output the buttons
-    initializeButtons();
-
-    // slider
-    initializeSliders();
-
-    // configure vol speed position and dj slider
-    configureSlider(volSlider, 0.0, 1.0, 0.5, Slider::LinearBarVertical, Slider::NoTextBox, true, 0.5);
-    configureSlider(speedSlider, 0.0, 5.0, 1.0, Slider::Rotary, Slider::TextBoxBelow, true, 1.0);
-    configureSlider(posSlider, 0.0, 1.0, 0.0, Slider::LinearBar, Slider::NoTextBox, false, 0.0);
-    configureSlider(djSlider, 0.0, 1.0, 0.0, Slider::Rotary, Slider::NoTextBox, false, 0.0);
-
-    // Listeners for the buttons
-    addAndMakeVisible(loopToggleBtn);
-    loopToggleBtn.addListener(this);
-
-    startTimer(100);    
-}
-
-DeckGUI::~DeckGUI()
-{
-    stopTimer();
-}
-
-void DeckGUI::paint (juce::Graphics& g)
-{
-    g.fillAll(getLookAndFeel().findColour(
-        juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::grey);
-    g.drawRect (getLocalBounds(), 1);   // draw an outline around the component
-
-}
-
-void DeckGUI::resized()
-{
-    float height = getHeight() * 0.1;
-    float width = getWidth() * 0.2;
-
-    musicNameLabel.setBounds(0, height * 0.25, getWidth(), height);
-
-    // set where the waveformdisplay is located
-    posSlider.setBounds(0, height * 1.5, getWidth(), height * 2);
-    waveformDisplay.setBounds(0, height * 1.5, getWidth(), height * 2);
-
-    if (isDeck1)
-    {
-        // Set bounds for components in Deck 1
-        djSlider.setBounds(width * 2.45, height * 3.9, width * 2.15, width * 2.15);
-        loadBtn.setBounds(width * 0.7, height * 7.6, height, height);
-        playBtn.setBounds(width * 1.2, height * 7.3, height * 1.5, height * 1.5);
-        pauseBtn.setBounds(width * 1.9, height * 7.6, height, height);
-        loopToggleBtn.setBounds(width * 1.1, height * 8.9, width, height);
-        volSlider.setBounds(width * 0.1, height * 3.75, width * 0.4, height * 6);
-        speedSlider.setBounds(width * 0.88, height * 4.5, width * 1.2, width * 0.8);
-    }
-    else
-    {
-        // Set bounds for components in Deck 2
-        djSlider.setBounds(width * 0.4, height * 3.9, width * 2.15, width * 2.15);
-        loadBtn.setBounds(width * 2.7, height * 7.6, height, height);
-        playBtn.setBounds(width * 3.2, height * 7.3, height * 1.5, height * 1.5);
-        pauseBtn.setBounds(width * 3.9, height * 7.6, height, height);
-        loopToggleBtn.setBounds(width * 3.1, height * 8.9, width, height);
-        volSlider.setBounds(width * 4.5, height * 3.75, width * 0.4, height * 6);
-        speedSlider.setBounds(width * 2.88, height * 4.5, width * 1.2, width * 0.8);
-    }
-}
-
-
-void DeckGUI::buttonClicked(Button* button) {
-    // Play
-    if (button == &playBtn) {
-        DBG("Play button was clicked.");
-        player->start();
-    }
-    // Pause
-    if (button == &pauseBtn) {
-        DBG("Pause button was clicked.");
-        player->pause();
-    }
-    // Load file
-    // Load file
-    if (button == &loadBtn) {
-        DBG("Load button was clicked.");
-        auto fileChooserFlags = FileBrowserComponent::canSelectFiles;
-        fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
-            {
-                auto chosenFile = chooser.getResult();
-                if (chosenFile.exists()) {
-                    DBG("Chosen file exists: " << chosenFile.getFullPathName());
-
-                    // Construct a URL from the chosen file
-                    juce::URL chosenUrl(chosenFile);
-                    DBG("Constructed URL: " << chosenUrl.toString(true));
-
-                    // Load the URL into the player and waveform display
-                    player->loadURL(chosenUrl);
-                    waveformDisplay.loadURL(chosenUrl);
-
-                    // Update the musicNameLabel content                    
-                    updateLabels(chosenUrl);
-
-                    DBG("Music Name Label Text: " << musicNameLabel.getText());
-                }
-            });
-    }
-}
-
-void DeckGUI::sliderValueChanged(Slider* slider) {
-    if (slider == &volSlider) {
-        DBG("vol slider moved." << volSlider.getValue());
-        player->setGain(slider->getValue());
-    }
-    if (slider == &speedSlider) {
-        DBG("speed slider moved." << speedSlider.getValue());
-        player->setSpeed(slider->getValue());
-    }
-    if (slider == &posSlider) {
-        DBG("pos slider moved." << posSlider.getValue());
-        player->setPositionRelative(slider->getValue());
-    }
-    if (slider == &djSlider) {
-        player->setPositionRelative(slider->getValue());
-    }
-}
-
-
-bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
-{
-    DBG("DeckGUI::isInterestedInFileDrag");
-    return true;
-}
-
-void DeckGUI::filesDropped(const StringArray& files, int x, int y)
-{
-    DBG("DeckGUI::filesDropped");
-    if (files.size() == 1)
-    {
-        // Load the URL into the player and waveform display
-        juce::URL musicUrl = juce::URL{ juce::File{files[0]} };
-        loadMusicFileToApplication(musicUrl);
-    }
-}
-
-// Added music looping feature
-void DeckGUI::timerCallback()
-{
-    // Update the waveform display position
-    double currentPos = player->getPositionRelative();
-
-    if (currentPos > 0.0 && currentPos < 1.0)
-    {
-        waveformDisplay.setPositionRelative(currentPos);
-        posSlider.setValue(currentPos);
-        djSlider.setValue(currentPos);
-
-        auto angle = currentPos * 360.0;
-
-        otherLookAndFeel.rotateDisc(angle);
-
-        repaint();
-    }
-    // Check if the audio playback has reached the end
-    if (player->getPositionRelative() >= 1)
-    {
-        // Set position back to the start
-        player->setPositionRelative(0);
-
-        // Check if loop toggle button is enabled
-        bool isLoopEnabled = loopToggleBtn.getToggleState();
-        if (isLoopEnabled)
-        {
-            DBG("Loop button is enabled.");
-            // Start playing the audio file
-            player->start();
-        }
-        else
-        {
-            DBG("Loop button is disabled.");
-            // Stop the audio file
-            player->pause();
-        }
-    }
-    
-}
-
-// Load an audio file from a URL as input into the player and waveform display for visualization
-void DeckGUI::loadMusicFileToApplication(const juce::URL& musicUrl)
-{
-    player->loadURL(musicUrl);
-    waveformDisplay.loadURL(musicUrl);
-
-    // Update the musicNameLabel content
-    updateLabels(musicUrl);
-}
-
-void DeckGUI::updateLabels(const juce::URL& musicUrl)
-{
-    // Update the musicNameLabel content
-    juce::File musicFile(musicUrl.getLocalFile());
-    String musicName = musicFile.getFileNameWithoutExtension();
-    musicNameLabel.setText("< Now Playing >\n  <  " + musicName + "  >", dontSendNotification);
-}
-
-void DeckGUI::initializeComponents()
-{
-    addAndMakeVisible(waveformDisplay);
-    addAndMakeVisible(musicNameLabel);
-    musicNameLabel.setJustificationType(Justification::centred);
-    musicNameLabel.setFont(Font(16.0f).boldened());
-}
-
-void DeckGUI::initializeButtons()
-{
-    Image playImage = ImageCache::getFromMemory(BinaryData::play_png, BinaryData::play_pngSize);
-    Image pauseImage = ImageCache::getFromMemory(BinaryData::pause_png, BinaryData::pause_pngSize);
-    Image loadImage = ImageCache::getFromMemory(BinaryData::upload_png, BinaryData::upload_pngSize);
-
-    addAndMakeVisible(playBtn);
-    addAndMakeVisible(pauseBtn);
-    addAndMakeVisible(loadBtn);
-
-    playBtn.addListener(this);
-    pauseBtn.addListener(this);
-    loadBtn.addListener(this);
-
-    playBtn.setImages(true, true, true, playImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
-        playImage, 1.0f, Colours::yellow,
-        playImage, 1.0f, Colours::orange);
-
-    pauseBtn.setImages(true, true, true, pauseImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
-        pauseImage, 1.0f, Colours::yellow,
-        pauseImage, 1.0f, Colours::orange);
-
-    loadBtn.setImages(true, true, true, loadImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
-        loadImage, 1.0f, Colours::yellow,
-        loadImage, 1.0f, Colours::orange);
-
-    musicNameLabel.setColour(Label::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
-    volSlider.setColour(Slider::trackColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
-
-    otherLookAndFeel2.setSlider(speedSlider, isDeck1);
-    speedLabel.setColour(Label::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
-    loopToggleBtn.setColour(ToggleButton::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
-}
-
-void DeckGUI::initializeSliders()
-{
-    // Volume Slider
-    addAndMakeVisible(volSlider);
-   
-
-    // Speed Slider
-    addAndMakeVisible(speedSlider);
-    speedSlider.setNumDecimalPlacesToDisplay(2);
-
-    // Position Slider
-    addAndMakeVisible(posSlider);
-    posSlider.setColour(Slider::trackColourId, Colours::grey.withAlpha(0.3f));
-
-    // DJ Slider
-    addAndMakeVisible(djSlider);
-    djSlider.setLookAndFeel(&otherLookAndFeel);
-}
-
-void DeckGUI::configureSlider(Slider& slider, double minValue, double maxValue, double startValue,
-    Slider::SliderStyle style, Slider::TextEntryBoxPosition textBoxPos,
-    bool doubleClickReturnValue, double interval)
-{
-    slider.setRange(minValue, maxValue);
-    slider.setValue(startValue);
-    slider.setSliderStyle(style);
-    slider.setTextBoxStyle(textBoxPos, false, 60, 20);
-    slider.setDoubleClickReturnValue(doubleClickReturnValue, interval);
-    slider.addListener(this);
+/*
+  ==============================================================================
+
+    DeckGUI.cpp
+    Created: 31 Jan 2024 1:20:40pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "DeckGUI.h"
+
+//==============================================================================
+DeckGUI::DeckGUI(DJAudioPlayer* _player,
+                 WaveformCache & cacheToUse,
+                 bool isDeck1) 
+    : player(_player),
+      waveformDisplay(cacheToUse, isDeck1),
+      scrollingWaveform(cacheToUse, isDeck1),
+      isDeck1(isDeck1)
+{
+    // Output the music name and waveform
+    initializeComponents();
+
+    // Output the buttons
+    initializeButtons();
+
+    // slider
+    initializeSliders();
+
+    // configure vol speed position and dj slider
+    configureSlider(volSlider, 0.0, 1.0, 0.5, Slider::LinearBarVertical, Slider::NoTextBox, true, 0.5);
+    configureSlider(speedSlider, 0.0, 5.0, 1.0, Slider::Rotary, Slider::TextBoxBelow, true, 1.0);
+    configureSlider(posSlider, 0.0, 1.0, 0.0, Slider::LinearBar, Slider::NoTextBox, false, 0.0);
+    configureSlider(djSlider, 0.0, 1.0, 0.0, Slider::Rotary, Slider::NoTextBox, false, 0.0);
+
+    // Listeners for the buttons
+    addAndMakeVisible(loopToggleBtn);
+    loopToggleBtn.addListener(this);
+    addAndMakeVisible(ramToggleBtn);
+    ramToggleBtn.addListener(this);
+    addAndMakeVisible(keyLockToggleBtn);
+    keyLockToggleBtn.addListener(this);
+    addAndMakeVisible(cueBtn);
+    cueBtn.addListener(this);
+    addAndMakeVisible(syncBtn);
+    syncBtn.setClickingTogglesState(true);
+    syncBtn.addListener(this);
+    addAndMakeVisible(bpmLabel);
+    bpmLabel.setJustificationType(Justification::centred);
+    bpmLabel.setFont(Font(13.0f).boldened());
+    addAndMakeVisible(loopInBtn);
+    loopInBtn.addListener(this);
+    addAndMakeVisible(loopOutBtn);
+    loopOutBtn.addListener(this);
+
+    // Beat loop lengths, ids index beatLoopLengths + 1
+    addAndMakeVisible(beatLoopBox);
+    beatLoopBox.setTextWhenNothingSelected("BEATS");
+    beatLoopBox.addItemList({ "1/2", "1", "2", "4", "8", "16" }, 1);
+    beatLoopBox.addListener(this);
+
+    // Resampling quality of the speed control, ids follow DeckResampler::Mode + 1
+    addAndMakeVisible(resamplingModeBox);
+    resamplingModeBox.addItem("Linear", static_cast<int>(DeckResampler::Mode::linear) + 1);
+    resamplingModeBox.addItem("Cubic", static_cast<int>(DeckResampler::Mode::cubic) + 1);
+    resamplingModeBox.addItem("Sinc", static_cast<int>(DeckResampler::Mode::sinc) + 1);
+    resamplingModeBox.setSelectedId(static_cast<int>(player->getResamplingMode()) + 1, dontSendNotification);
+    resamplingModeBox.addListener(this);
+}
+
+DeckGUI::~DeckGUI()
+{
+}
+
+void DeckGUI::paint (juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(
+        juce::ResizableWindow::backgroundColourId));
+
+    g.setColour (juce::Colours::grey);
+    g.drawRect (getLocalBounds(), 1);   // draw an outline around the component
+
+}
+
+void DeckGUI::resized()
+{
+    float height = getHeight() * 0.1;
+    float width = getWidth() * 0.2;
+
+    musicNameLabel.setBounds(0, height * 0.25, getWidth(), height);
+
+    // set where the waveformdisplay is located
+    posSlider.setBounds(0, height * 1.5, getWidth(), height * 0.8);
+    waveformDisplay.setBounds(0, height * 1.5, getWidth(), height * 0.8);
+    scrollingWaveform.setBounds(0, height * 2.35, getWidth(), height * 1.3);
+
+    if (isDeck1)
+    {
+        // Set bounds for components in Deck 1
+        djSlider.setBounds(width * 2.45, height * 3.9, width * 2.15, width * 2.15);
+        loadBtn.setBounds(width * 0.7, height * 7.6, height, height);
+        playBtn.setBounds(width * 1.2, height * 7.3, height * 1.5, height * 1.5);
+        pauseBtn.setBounds(width * 1.9, height * 7.6, height, height);
+        cueBtn.setBounds(width * 0.5, height * 9.05, width * 0.4, height * 0.7);
+        keyLockToggleBtn.setBounds(width * 0.95, height * 8.9, width * 0.5, height);
+        loopToggleBtn.setBounds(width * 1.45, height * 8.9, width * 0.5, height);
+        ramToggleBtn.setBounds(width * 1.95, height * 8.9, width * 0.5, height);
+        volSlider.setBounds(width * 0.1, height * 3.75, width * 0.4, height * 6);
+        speedSlider.setBounds(width * 0.88, height * 4.5, width * 1.2, width * 0.8);
+        bpmLabel.setBounds(width * 0.5, height * 3.75, width * 0.48, height * 0.6);
+        resamplingModeBox.setBounds(width * 0.98, height * 3.75, width, height * 0.6);
+        syncBtn.setBounds(width * 2.0, height * 3.75, width * 0.43, height * 0.6);
+        loopInBtn.setBounds(width * 0.5, height * 6.55, width * 0.4, height * 0.6);
+        loopOutBtn.setBounds(width * 0.95, height * 6.55, width * 0.4, height * 0.6);
+        beatLoopBox.setBounds(width * 1.4, height * 6.55, width * 0.8, height * 0.6);
+    }
+    else
+    {
+        // Set bounds for components in Deck 2
+        djSlider.setBounds(width * 0.4, height * 3.9, width * 2.15, width * 2.15);
+        loadBtn.setBounds(width * 2.7, height * 7.6, height, height);
+        playBtn.setBounds(width * 3.2, height * 7.3, height * 1.5, height * 1.5);
+        pauseBtn.setBounds(width * 3.9, height * 7.6, height, height);
+        cueBtn.setBounds(width * 2.55, height * 9.05, width * 0.4, height * 0.7);
+        keyLockToggleBtn.setBounds(width * 3.0, height * 8.9, width * 0.5, height);
+        loopToggleBtn.setBounds(width * 3.5, height * 8.9, width * 0.5, height);
+        ramToggleBtn.setBounds(width * 4.0, height * 8.9, width * 0.5, height);
+        volSlider.setBounds(width * 4.5, height * 3.75, width * 0.4, height * 6);
+        speedSlider.setBounds(width * 2.88, height * 4.5, width * 1.2, width * 0.8);
+        syncBtn.setBounds(width * 2.55, height * 3.75, width * 0.43, height * 0.6);
+        resamplingModeBox.setBounds(width * 2.98, height * 3.75, width, height * 0.6);
+        bpmLabel.setBounds(width * 3.98, height * 3.75, width * 0.5, height * 0.6);
+        loopInBtn.setBounds(width * 2.55, height * 6.55, width * 0.4, height * 0.6);
+        loopOutBtn.setBounds(width * 3.0, height * 6.55, width * 0.4, height * 0.6);
+        beatLoopBox.setBounds(width * 3.45, height * 6.55, width * 0.8, height * 0.6);
+    }
+}
+
+
+void DeckGUI::buttonClicked(Button* button) {
+    // Play
+    if (button == &playBtn) {
+        DBG("Play button was clicked.");
+        player->start();
+    }
+    // Pause
+    if (button == &pauseBtn) {
+        DBG("Pause button was clicked.");
+        player->pause();
+    }
+    // Jump back to the cue point, or set it while paused
+    if (button == &cueBtn) {
+        DBG("Cue button was clicked.");
+        player->cue();
+    }
+    // Follow the master deck's tempo and beats
+    if (button == &syncBtn) {
+        DBG("Sync button was clicked.");
+        player->setSync(syncBtn.getToggleState());
+    }
+    // Set the loop in point, or the out point and start looping
+    if (button == &loopInBtn) {
+        DBG("Loop in button was clicked.");
+        player->setLoopIn();
+    }
+    if (button == &loopOutBtn) {
+        DBG("Loop out button was clicked.");
+        player->setLoopOut();
+    }
+    // Wrap from the end of the track back to its start
+    if (button == &loopToggleBtn) {
+        DBG("Loop toggle was clicked.");
+        player->setLoopTrack(loopToggleBtn.getToggleState());
+    }
+    // Keep the pitch when the speed changes
+    if (button == &keyLockToggleBtn) {
+        DBG("Key lock toggle was clicked.");
+        player->setKeyLock(keyLockToggleBtn.getToggleState());
+    }
+    // Decode tracks loaded from now on into RAM
+    if (button == &ramToggleBtn) {
+        DBG("RAM toggle was clicked.");
+        player->setRamResident(ramToggleBtn.getToggleState());
+    }
+    // Load file
+    if (button == &loadBtn) {
+        DBG("Load button was clicked.");
+        auto fileChooserFlags = FileBrowserComponent::canSelectFiles;
+        fChooser.launchAsync(fileChooserFlags, [this](const FileChooser& chooser)
+            {
+                auto chosenFile = chooser.getResult();
+                if (chosenFile.exists()) {
+                    DBG("Chosen file exists: " << chosenFile.getFullPathName());
+
+                    // Construct a URL from the chosen file
+                    juce::URL chosenUrl(chosenFile);
+                    DBG("Constructed URL: " << chosenUrl.toString(true));
+
+                    // Load the URL into the player and waveform display
+                    loadMusicFileToApplication(chosenUrl);
+                }
+            });
+    }
+}
+
+void DeckGUI::sliderValueChanged(Slider* slider) {
+    if (slider == &volSlider) {
+        DBG("vol slider moved." << volSlider.getValue());
+        player->setGain(slider->getValue());
+    }
+    if (slider == &speedSlider) {
+        DBG("speed slider moved." << speedSlider.getValue());
+        player->setSpeed(slider->getValue());
+    }
+    if (slider == &posSlider) {
+        DBG("pos slider moved." << posSlider.getValue());
+        player->setPositionRelative(slider->getValue());
+    }
+    if (slider == &djSlider) {
+        player->setPositionRelative(slider->getValue());
+    }
+}
+
+
+void DeckGUI::comboBoxChanged(ComboBox* comboBox)
+{
+    if (comboBox == &resamplingModeBox) {
+        DBG("resampling mode changed." << resamplingModeBox.getText());
+        player->setResamplingMode(static_cast<DeckResampler::Mode>(resamplingModeBox.getSelectedId() - 1));
+    }
+    if (comboBox == &beatLoopBox && beatLoopBox.getSelectedId() > 0) {
+        static constexpr double beatLoopLengths[] = { 0.5, 1.0, 2.0, 4.0, 8.0, 16.0 };
+        DBG("beat loop selected." << beatLoopBox.getText());
+        player->setBeatLoop(beatLoopLengths[beatLoopBox.getSelectedId() - 1]);
+    }
+}
+
+bool DeckGUI::isInterestedInFileDrag(const StringArray& files)
+{
+    DBG("DeckGUI::isInterestedInFileDrag");
+    return true;
+}
+
+void DeckGUI::filesDropped(const StringArray& files, int x, int y)
+{
+    DBG("DeckGUI::filesDropped");
+    if (files.size() == 1)
+    {
+        // Load the URL into the player and waveform display
+        juce::URL musicUrl = juce::URL{ juce::File{files[0]} };
+        loadMusicFileToApplication(musicUrl);
+    }
+}
+
+void DeckGUI::frameCallback()
+{
+    // Displays refreshing faster than 60 Hz skip frames
+    const double now = Time::getMillisecondCounterHiRes();
+
+    if (now - lastFrameTime < 1000.0 / 60.0 - 1.0)
+        return;
+
+    lastFrameTime = now;
+
+    // Update the waveform display position
+    double currentPos = jlimit(0.0, 1.0, player->getPositionRelative());
+
+    if (currentPos != lastFramePosition)
+    {
+        lastFramePosition = currentPos;
+
+        // Each display invalidates only what moved, and the sliders must not
+        // notify their listeners or every frame would seek the transport
+        waveformDisplay.setPositionRelative(currentPos);
+        scrollingWaveform.setPlayheadSeconds(player->getPositionInSeconds());
+
+        if (!posSlider.isMouseButtonDown())
+            posSlider.setValue(currentPos, dontSendNotification);
+
+        if (!djSlider.isMouseButtonDown())
+        {
+            djSlider.setValue(currentPos, dontSendNotification);
+
+            auto angle = currentPos * 360.0;
+
+            otherLookAndFeel.rotateDisc(angle);
+            djSlider.repaint();
+        }
+    }
+
+    // SYNC drives the speed from the audio thread, so the speed slider follows it
+    if (player->isSynced() && !speedSlider.isMouseButtonDown())
+        speedSlider.setValue(player->getSpeed(), dontSendNotification);
+
+    // Only repaint the tempo when its text changes
+    const double bpm = player->getBpm();
+    juce::String bpmText = bpm > 0.0 ? juce::String(bpm, 1) + (player->isSyncMaster() ? " M" : "") : "--";
+
+    if (bpmText != lastBpmText)
+    {
+        lastBpmText = bpmText;
+        bpmLabel.setText(bpmText, dontSendNotification);
+    }
+
+    // The audio thread plays the loop, the deck only shows it
+    const bool looping = player->isLooping();
+    const double length = player->getLengthInSeconds();
+
+    if (looping && length > 0.0)
+        waveformDisplay.setLoopRelative(player->getLoopStartSeconds() / length, player->getLoopEndSeconds() / length);
+    else
+        waveformDisplay.setLoopRelative(0.0, 0.0);
+
+    if (looping != lastLooping)
+    {
+        lastLooping = looping;
+        loopOutBtn.setToggleState(looping, dontSendNotification);
+
+        // A beat loop that was left can be picked again
+        if (!looping)
+            beatLoopBox.setSelectedId(0, dontSendNotification);
+    }
+}
+
+// Load an audio file from a URL as input into the player and waveform display for visualization
+void DeckGUI::loadMusicFileToApplication(const juce::URL& musicUrl, const BeatGrid& beatGrid, float trimGain)
+{
+    // The player opens the file in the background, the rest of the deck follows once it is ready
+    Component::SafePointer<DeckGUI> safeThis{ this };
+
+    player->loadURLAsync(musicUrl, [safeThis, musicUrl](bool loaded)
+        {
+            if (safeThis == nullptr || !loaded)
+            {
+                DBG("DeckGUI::loadMusicFileToApplication could not load " << musicUrl.toString(false));
+                return;
+            }
+
+            safeThis->waveformDisplay.loadURL(musicUrl);
+            safeThis->scrollingWaveform.loadURL(musicUrl);
+
+            // Update the musicNameLabel content
+            safeThis->updateLabels(musicUrl);
+        }, beatGrid, trimGain);
+}
+
+void DeckGUI::updateLabels(const juce::URL& musicUrl)
+{
+    // Update the musicNameLabel content
+    juce::File musicFile(musicUrl.getLocalFile());
+    String musicName = musicFile.getFileNameWithoutExtension();
+    musicNameLabel.setText("< Now Playing >\n  <  " + musicName + "  >", dontSendNotification);
+}
+
+bool DeckGUI::isRamResident() const
+{
+    return player->isRamResident();
+}
+
+void DeckGUI::initializeComponents()
+{
+    addAndMakeVisible(waveformDisplay);
+    addAndMakeVisible(scrollingWaveform);
+    addAndMakeVisible(musicNameLabel);
+    musicNameLabel.setJustificationType(Justification::centred);
+    musicNameLabel.setFont(Font(16.0f).boldened());
+}
+
+void DeckGUI::initializeButtons()
+{
+    Image playImage = ImageCache::getFromMemory(BinaryData::play_png, BinaryData::play_pngSize);
+    Image pauseImage = ImageCache::getFromMemory(BinaryData::pause_png, BinaryData::pause_pngSize);
+    Image loadImage = ImageCache::getFromMemory(BinaryData::upload_png, BinaryData::upload_pngSize);
+
+    addAndMakeVisible(playBtn);
+    addAndMakeVisible(pauseBtn);
+    addAndMakeVisible(loadBtn);
+
+    playBtn.addListener(this);
+    pauseBtn.addListener(this);
+    loadBtn.addListener(this);
+
+    playBtn.setImages(true, true, true, playImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
+        playImage, 1.0f, Colours::yellow,
+        playImage, 1.0f, Colours::orange);
+
+    pauseBtn.setImages(true, true, true, pauseImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
+        pauseImage, 1.0f, Colours::yellow,
+        pauseImage, 1.0f, Colours::orange);
+
+    loadBtn.setImages(true, true, true, loadImage, 1.0f, isDeck1 ? Colours::orange : Colours::deepskyblue,
+        loadImage, 1.0f, Colours::yellow,
+        loadImage, 1.0f, Colours::orange);
+
+    musicNameLabel.setColour(Label::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    volSlider.setColour(Slider::trackColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+
+    otherLookAndFeel2.setSlider(speedSlider, isDeck1);
+    speedLabel.setColour(Label::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    loopToggleBtn.setColour(ToggleButton::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    ramToggleBtn.setColour(ToggleButton::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    keyLockToggleBtn.setColour(ToggleButton::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    cueBtn.setColour(TextButton::textColourOffId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    syncBtn.setColour(TextButton::textColourOffId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    syncBtn.setColour(TextButton::buttonOnColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    loopInBtn.setColour(TextButton::textColourOffId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    loopOutBtn.setColour(TextButton::textColourOffId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    loopOutBtn.setColour(TextButton::buttonOnColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+    bpmLabel.setColour(Label::textColourId, isDeck1 ? Colours::orange : Colours::deepskyblue);
+}
+
+void DeckGUI::initializeSliders()
+{
+    // Volume Slider
+    addAndMakeVisible(volSlider);
+   
+
+    // Speed Slider
+    addAndMakeVisible(speedSlider);
+    speedSlider.setNumDecimalPlacesToDisplay(2);
+
+    // Position Slider
+    addAndMakeVisible(posSlider);
+    posSlider.setColour(Slider::trackColourId, Colours::grey.withAlpha(0.3f));
+
+    // DJ Slider
+    addAndMakeVisible(djSlider);
+    djSlider.setLookAndFeel(&otherLookAndFeel);
+}
+
+void DeckGUI::configureSlider(Slider& slider, double minValue, double maxValue, double startValue,
+    Slider::SliderStyle style, Slider::TextEntryBoxPosition textBoxPos,
+    bool doubleClickReturnValue, double interval)
+{
+    slider.setRange(minValue, maxValue);
+    slider.setValue(startValue);
+    slider.setSliderStyle(style);
+    slider.setTextBoxStyle(textBoxPos, false, 60, 20);
+    slider.setDoubleClickReturnValue(doubleClickReturnValue, interval);
+    slider.addListener(this);
 }
\ No newline at end of file
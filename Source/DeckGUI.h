@@ -1,192 +1,248 @@
-/*
-  ==============================================================================
-
-    DeckGUI.h
-    Created: 31 Jan 2024 1:20:40pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DJAudioPlayer.h"
-#include "WaveformDisplay.h"
-#include "OtherLookAndFeel.h"
-#include "OtherLookAndFeel2.h"
-
-//==============================================================================
-/**
- * The DeckGUI class represents the graphical user interface for a DJ deck.
- * 
- * It handles user interactions, such as button clicks and slider adjustments,
- * and communicates with the DJAudioPlayer for audio playback. The class also
- * incorporates a waveform display for visualizing the audio waveform.
- */
-class DeckGUI  : public juce::Component,
-                 public Button::Listener,
-                 public Slider::Listener,
-                 public FileDragAndDropTarget,
-                 public Timer
-{
-public:
-    /**
-     * Constructor for DeckGUI.
-     *
-     * @param _player Pointer to the associated DJAudioPlayer.
-     * @param formatManagerToUse Reference to the AudioFormatManager.
-     * @param cacheToUse Reference to the AudioThumbnailCache.
-     */
-    DeckGUI(DJAudioPlayer* player,
-        AudioFormatManager& formatManagerToUse,
-        AudioThumbnailCache& cacheToUse,
-        bool isDeck1);
-
-    /**
-     * Destructor for DeckGUI.
-     */
-    ~DeckGUI() override;
-
-    /**
-     * Paints the graphical user interface of the DeckGUI.
-     * @param g The Graphics object used for rendering.
-     */
-    void paint (juce::Graphics&) override;
-
-    /**
-     * Called when the size of the DeckGUI is changed.
-     * Adjusts the size and position of the components to fit the new dimensions.
-     */
-    void resized() override;
-
-    /**
-     * Handles button clicks on the DeckGUI.
-     * @param button Pointer to the button that was clicked.
-     */
-    void buttonClicked(Button*) override;
-
-    /**
-     * Handles slider value changes on the DeckGUI.
-     * @param slider Pointer to the slider that had its value changed.
-     */
-    void sliderValueChanged(Slider* slider) override;
-
-    /**
-     * Checks whether the DeckGUI is interested in file drag events.
-     *
-     * @param files An array of file paths that are being dragged.
-     * @return True if the DeckGUI is interested in the file drag events, false otherwise.
-     */
-    bool isInterestedInFileDrag(const StringArray& file) override;
-
-    /**
-     * Handles the event when files are dropped onto the DeckGUI.
-     *
-     * @param files An array of file paths that have been dropped.
-     * @param x The x-coordinate of the drop location.
-     * @param y The y-coordinate of the drop location.
-     */
-    void filesDropped(const StringArray& files, int x, int y) override;
-
-    /**
-     * Timer callback function.
-     * This function is called at regular intervals to check and update the audio playback status,
-     * and manage features such as looping.
-     */
-    void timerCallback() override;
-
-    /**
-     * Load an audio file from a URL as input into the DJAudioPlayer and WaveformDisplay
-     * for visualization and playback within the DeckGUI.
-     *
-     * @param musicUrl The URL of the audio file to be loaded.
-     */
-    void loadMusicFileToApplication(const juce::URL& musicUrl);
-
-    /**
-     * Update music name label
-     *
-     * @param musicUrl The URL of the audio file name to be displayed.
-     */
-    void updateLabels(const juce::URL& musicUrl);
-
-private:
-
-    /**
-     *  Define ImageButton for play, pause, load, and a ToggleButton for loop
-     */
-    ImageButton playBtn{ "PLAY" }, pauseBtn{ "PAUSE" }, loadBtn{ "LOAD" };
-    ToggleButton loopToggleBtn{ "LOOP" };
-
-    /**
-     *  Define sliders for volume, speed, and position
-     */
-    Slider volSlider, speedSlider, posSlider, djSlider;
-
-    /**
-     *  FileChooser for selecting a file
-     */
-    FileChooser fChooser{ "Select a file..." };
-
-    /**
-     *  Declare pointers for DJAudioPlayer, waveform display, and AudioTransportSource
-     */
-    DJAudioPlayer* player;
-    WaveformDisplay waveformDisplay;
-    AudioTransportSource transportSource;
-
-    /**
-     *  Label for displaying music name and speed
-     */
-    Label musicNameLabel, speedLabel;
-
-    /**
-     * Custom look-and-feel class for defining the appearance of UI components.
-     * Used for general customization.
-     */
-    OtherLookAndFeel otherLookAndFeel;
-
-    /**
-     * 2nd custom look-and-feel class for defining the appearance of rotary sliders.
-     * Used to set specific colors for sliders based on the deck they belong to.
-     */
-    OtherLookAndFeel2 otherLookAndFeel2;
-
-    /**
- * Boolean flag indicating whether the component belongs to Deck 1.
- */
-    bool isDeck1;
-
-    /**
-     * Initialize various components used in the DJ application.
-     */
-    void initializeComponents();
-
-    /**
-     * Initialize buttons used in the DJ application, such as play, pause, and load buttons.
-     */
-    void initializeButtons();
-
-    /**
-     * Initialize sliders used in the DJ application, such as volume, speed, and position sliders.
-     */
-    void initializeSliders();
-
-    /**
-     * Configure a slider with specified parameters.
-     *
-     * @param slider                The Slider object to configure.
-     * @param minValue              The minimum value of the slider.
-     * @param maxValue              The maximum value of the slider.
-     * @param startValue            The initial value of the slider.
-     * @param style                 The style of the slider.
-     * @param textBoxPos            The position of the text box associated with the slider.
-     * @param doubleClickReturnValue   Whether double-clicking the slider returns to a default value.
-     * @param interval              The interval for the slider's double-click return value.
-     */
-    void configureSlider(Slider& slider, double minValue, double maxValue, double startValue,
-        Slider::SliderStyle style, Slider::TextEntryBoxPosition textBoxPos,
-        bool doubleClickReturnValue, double interval);
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
-};
+/*
+  ==============================================================================
+
+    DeckGUI.h
+    Created: 31 Jan 2024 1:20:40pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DJAudioPlayer.h"
+#include "WaveformDisplay.h"
+#include "ScrollingWaveform.h"
+#include "OtherLookAndFeel.h"
+#include "OtherLookAndFeel2.h"
+
+//==============================================================================
+/**
+ * The DeckGUI class represents the graphical user interface for a DJ deck.
+ * 
+ * It handles user interactions, such as button clicks and slider adjustments,
+ * and communicates with the DJAudioPlayer for audio playback. The class also
+ * incorporates a waveform display for visualizing the audio waveform.
+ */
+class DeckGUI  : public juce::Component,
+                 public Button::Listener,
+                 public Slider::Listener,
+                 public ComboBox::Listener,
+                 public FileDragAndDropTarget
+{
+public:
+    /**
+     * Constructor for DeckGUI.
+     *
+     * @param _player Pointer to the associated DJAudioPlayer.
+     * @param cacheToUse Reference to the WaveformCache.
+     */
+    DeckGUI(DJAudioPlayer* player,
+        WaveformCache& cacheToUse,
+        bool isDeck1);
+
+    /**
+     * Destructor for DeckGUI.
+     */
+    ~DeckGUI() override;
+
+    /**
+     * Paints the graphical user interface of the DeckGUI.
+     * @param g The Graphics object used for rendering.
+     */
+    void paint (juce::Graphics&) override;
+
+    /**
+     * Called when the size of the DeckGUI is changed.
+     * Adjusts the size and position of the components to fit the new dimensions.
+     */
+    void resized() override;
+
+    /**
+     * Handles button clicks on the DeckGUI.
+     * @param button Pointer to the button that was clicked.
+     */
+    void buttonClicked(Button*) override;
+
+    /**
+     * Handles slider value changes on the DeckGUI.
+     * @param slider Pointer to the slider that had its value changed.
+     */
+    void sliderValueChanged(Slider* slider) override;
+
+    /**
+     * Handles a new selection in the resampling mode box.
+     * @param comboBox Pointer to the combo box whose selection changed.
+     */
+    void comboBoxChanged(ComboBox* comboBox) override;
+
+    /**
+     * Checks whether the DeckGUI is interested in file drag events.
+     *
+     * @param files An array of file paths that are being dragged.
+     * @return True if the DeckGUI is interested in the file drag events, false otherwise.
+     */
+    bool isInterestedInFileDrag(const StringArray& file) override;
+
+    /**
+     * Handles the event when files are dropped onto the DeckGUI.
+     *
+     * @param files An array of file paths that have been dropped.
+     * @param x The x-coordinate of the drop location.
+     * @param y The y-coordinate of the drop location.
+     */
+    void filesDropped(const StringArray& files, int x, int y) override;
+
+    /**
+     * Frame callback function, driven by the display's vertical blank and capped at 60 fps.
+     * It reads the playhead and loop the audio thread published and moves the displays
+     * without notifying their listeners. Looping and the end of the track are handled
+     * by the audio thread, the deck only shows them.
+     */
+    void frameCallback();
+
+    /**
+     * Load an audio file from a URL as input into the DJAudioPlayer and WaveformDisplay
+     * for visualization and playback within the DeckGUI.
+     * The file is opened on the player's loader thread, the waveform and labels
+     * are updated once the track has been handed to the audio thread.
+     *
+     * @param musicUrl The URL of the audio file to be loaded.
+     * @param beatGrid The beat grid stored in the library, or an empty grid to analyse the track on load.
+     * @param trimGain The auto-gain trim from the library's loudness analysis, or 0 to analyse the track on load.
+     */
+    void loadMusicFileToApplication(const juce::URL& musicUrl, const BeatGrid& beatGrid = {}, float trimGain = 0.0f);
+
+    /**
+     * Update music name label
+     *
+     * @param musicUrl The URL of the audio file name to be displayed.
+     */
+    void updateLabels(const juce::URL& musicUrl);
+
+    /**
+     * Check whether the deck decodes the tracks it loads into RAM.
+     *
+     * @return True if the deck's player is in RAM-resident mode.
+     */
+    bool isRamResident() const;
+
+private:
+
+    /**
+     *  Define ImageButton for play, pause, load, and ToggleButtons for loop, RAM-resident loading and key lock
+     */
+    ImageButton playBtn{ "PLAY" }, pauseBtn{ "PAUSE" }, loadBtn{ "LOAD" };
+    ToggleButton loopToggleBtn{ "LOOP" }, ramToggleBtn{ "RAM" }, keyLockToggleBtn{ "KEY" };
+
+    /**
+     *  Cue button, and the SYNC button that locks the deck to the master deck's tempo and beats
+     */
+    TextButton cueBtn{ "CUE" }, syncBtn{ "SYNC" };
+
+    /**
+     *  Loop in and out buttons, and the box that starts a loop of a number of beats
+     */
+    TextButton loopInBtn{ "IN" }, loopOutBtn{ "OUT" };
+    ComboBox beatLoopBox;
+    bool lastLooping = false;
+
+    /**
+     *  Define sliders for volume, speed, and position
+     */
+    Slider volSlider, speedSlider, posSlider, djSlider;
+
+    /**
+     *  FileChooser for selecting a file
+     */
+    FileChooser fChooser{ "Select a file..." };
+
+    /**
+     *  Declare pointers for DJAudioPlayer, the overview and scrolling waveform displays, and AudioTransportSource
+     */
+    DJAudioPlayer* player;
+    WaveformDisplay waveformDisplay;
+    ScrollingWaveform scrollingWaveform;
+    AudioTransportSource transportSource;
+
+    /**
+     *  Label for displaying music name and speed
+     */
+    Label musicNameLabel, speedLabel;
+
+    /**
+     *  Label showing the tempo at the current speed, and whether this deck is the sync master
+     */
+    Label bpmLabel;
+    juce::String lastBpmText;
+
+    /**
+     *  Selects the interpolation kernel of the speed control
+     */
+    ComboBox resamplingModeBox;
+
+    /**
+     * Custom look-and-feel class for defining the appearance of UI components.
+     * Used for general customization.
+     */
+    OtherLookAndFeel otherLookAndFeel;
+
+    /**
+     * 2nd custom look-and-feel class for defining the appearance of rotary sliders.
+     * Used to set specific colors for sliders based on the deck they belong to.
+     */
+    OtherLookAndFeel2 otherLookAndFeel2;
+
+    /**
+ * Boolean flag indicating whether the component belongs to Deck 1.
+ */
+    bool isDeck1;
+
+    /**
+     * The playhead drawn by the previous frame, nothing is invalidated while it stays put.
+     */
+    double lastFramePosition = -1.0;
+
+    /**
+     * Time of the previous frame in milliseconds, used to cap the frame rate.
+     */
+    double lastFrameTime = 0.0;
+
+    /**
+     * Calls frameCallback() in sync with the display refresh while the deck is on screen.
+     */
+    VBlankAttachment vBlankAttachment{ this, [this] { frameCallback(); } };
+
+    /**
+     * Initialize various components used in the DJ application.
+     */
+    void initializeComponents();
+
+    /**
+     * Initialize buttons used in the DJ application, such as play, pause, and load buttons.
+     */
+    void initializeButtons();
+
+    /**
+     * Initialize sliders used in the DJ application, such as volume, speed, and position sliders.
+     */
+    void initializeSliders();
+
+    /**
+     * Configure a slider with specified parameters.
+     *
+     * @param slider                The Slider object to configure.
+     * @param minValue              The minimum value of the slider.
+     * @param maxValue              The maximum value of the slider.
+     * @param startValue            The initial value of the slider.
+     * @param style                 The style of the slider.
+     * @param textBoxPos            The position of the text box associated with the slider.
+     * @param doubleClickReturnValue   Whether double-clicking the slider returns to a default value.
+     * @param interval              The interval for the slider's double-click return value.
+     */
+    void configureSlider(Slider& slider, double minValue, double maxValue, double startValue,
+        Slider::SliderStyle style, Slider::TextEntryBoxPosition textBoxPos,
+        bool doubleClickReturnValue, double interval);
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckGUI)
+};
@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+    DeckMixer.cpp
+    Created: 19 Oct 2026 10:05:37am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "DeckMixer.h"
+
+DeckMixer::DeckMixer()
+{
+}
+
+DeckMixer::~DeckMixer()
+{
+}
+
+int DeckMixer::addChannel(AudioSource* source, Assignment assignment)
+{
+    jassert(source != nullptr);
+
+    auto channel = std::make_unique<Channel>();
+    channel->source = source;
+    channel->assignment = assignment;
+    channels.push_back(std::move(channel));
+
+    return static_cast<int>(channels.size()) - 1;
+}
+
+int DeckMixer::getNumChannels() const
+{
+    return static_cast<int>(channels.size());
+}
+
+void DeckMixer::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    maxBlockSize = jmax(1, samplesPerBlockExpected);
+    mixBus.setSize(2, maxBlockSize);
+
+    for (auto& channel : channels)
+    {
+        channel->scratch.setSize(2, maxBlockSize);
+        channel->leftGain.reset(sampleRate, 0.02);
+        channel->rightGain.reset(sampleRate, 0.02);
+        channel->source->prepareToPlay(maxBlockSize, sampleRate);
+    }
+}
+
+void DeckMixer::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    auto& output = *bufferToFill.buffer;
+    const int numOutputChannels = jmin(2, output.getNumChannels());
+    const juce::int64 mixStart = CallbackProfiler::getTicks();
+    juce::int64 sourceTicks = 0;
+
+    // Blocks larger than prepared are mixed in pieces so nothing is reallocated
+    for (int done = 0; done < bufferToFill.numSamples; done += maxBlockSize)
+    {
+        const int numSamples = jmin(maxBlockSize, bufferToFill.numSamples - done);
+
+        sourceTicks += mixChunk(numSamples);
+
+        for (int channel = 0; channel < numOutputChannels; ++channel)
+        {
+            output.copyFrom(channel, bufferToFill.startSample + done, mixBus, channel, 0, numSamples);
+        }
+    }
+
+    for (int channel = numOutputChannels; channel < output.getNumChannels(); ++channel)
+    {
+        output.clear(channel, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+
+    if (profiler != nullptr)
+        profiler->record(mixStage, CallbackProfiler::getTicks() - mixStart - sourceTicks);
+}
+
+void DeckMixer::releaseResources()
+{
+    for (auto& channel : channels)
+    {
+        channel->source->releaseResources();
+        channel->scratch.setSize(2, 0);
+    }
+
+    mixBus.setSize(2, 0);
+}
+
+void DeckMixer::setChannelGain(int channel, float gain)
+{
+    if (isPositiveAndBelow(channel, getNumChannels()))
+        channels[(size_t) channel]->gain = jlimit(0.0f, 1.0f, gain);
+}
+
+void DeckMixer::setChannelTrim(int channel, float trim)
+{
+    if (isPositiveAndBelow(channel, getNumChannels()))
+        channels[(size_t) channel]->trim = jlimit(0.0f, 4.0f, trim);
+}
+
+void DeckMixer::setChannelPan(int channel, float pan)
+{
+    if (isPositiveAndBelow(channel, getNumChannels()))
+        channels[(size_t) channel]->pan = jlimit(-1.0f, 1.0f, pan);
+}
+
+void DeckMixer::setCrossfaderPosition(float position)
+{
+    crossfaderPosition = jlimit(0.0f, 1.0f, position);
+}
+
+void DeckMixer::setCrossfaderCurve(CrossfaderCurve curve)
+{
+    crossfaderCurve = static_cast<int>(curve);
+}
+
+DeckMixer::CrossfaderCurve DeckMixer::getCrossfaderCurve() const
+{
+    return static_cast<CrossfaderCurve>(crossfaderCurve.load());
+}
+
+std::pair<float, float> DeckMixer::getCrossfaderGains(CrossfaderCurve curve, float position)
+{
+    switch (curve)
+    {
+        case CrossfaderCurve::constantPower:
+        {
+            // Equal perceived loudness through the middle of the fade
+            const float angle = position * MathConstants<float>::halfPi;
+            return { std::cos(angle), std::sin(angle) };
+        }
+
+        case CrossfaderCurve::cut:
+        {
+            // Both sides at full level except within 5% of either end
+            constexpr float cutWidth = 0.05f;
+            return { jlimit(0.0f, 1.0f, (1.0f - position) / cutWidth),
+                     jlimit(0.0f, 1.0f, position / cutWidth) };
+        }
+
+        case CrossfaderCurve::linear:
+        default:
+            return { 1.0f - position, position };
+    }
+}
+
+void DeckMixer::setProfiler(CallbackProfiler* _profiler, int _mixStage)
+{
+    profiler = _profiler;
+    mixStage = _mixStage;
+}
+
+juce::int64 DeckMixer::mixChunk(int numSamples)
+{
+    mixBus.clear(0, numSamples);
+    juce::int64 sourceTicks = 0;
+
+    const auto crossfader = getCrossfaderGains(getCrossfaderCurve(),
+        crossfaderPosition.load(std::memory_order_relaxed));
+
+    for (auto& channel : channels)
+    {
+        AudioSourceChannelInfo info(&channel->scratch, 0, numSamples);
+        const juce::int64 sourceStart = CallbackProfiler::getTicks();
+        channel->source->getNextAudioBlock(info);
+        sourceTicks += CallbackProfiler::getTicks() - sourceStart;
+
+        float sideGain = 1.0f;
+
+        if (channel->assignment == Assignment::a)
+            sideGain = crossfader.first;
+        else if (channel->assignment == Assignment::b)
+            sideGain = crossfader.second;
+
+        // Balance law: the centre is unity, turning one way only attenuates the other side
+        const float pan = channel->pan.load(std::memory_order_relaxed);
+        const float gain = channel->trim.load(std::memory_order_relaxed)
+                         * channel->gain.load(std::memory_order_relaxed)
+                         * sideGain;
+
+        channel->leftGain.setTargetValue(gain * jmin(1.0f, 1.0f - pan));
+        channel->rightGain.setTargetValue(gain * jmin(1.0f, 1.0f + pan));
+
+        const float leftStart = channel->leftGain.getCurrentValue();
+        const float leftEnd = channel->leftGain.skip(numSamples);
+        const float rightStart = channel->rightGain.getCurrentValue();
+        const float rightEnd = channel->rightGain.skip(numSamples);
+
+        // Constant gains are summed with FloatVectorOperations::addWithMultiply
+        mixBus.addFromWithRamp(0, 0, channel->scratch.getReadPointer(0), numSamples, leftStart, leftEnd);
+        mixBus.addFromWithRamp(1, 0, channel->scratch.getReadPointer(1), numSamples, rightStart, rightEnd);
+    }
+
+    return sourceTicks;
+}
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    DeckMixer.h
+    Created: 19 Oct 2026 10:05:37am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "CallbackProfiler.h"
+
+/**
+ * The DeckMixer class sums any number of deck channels into the output.
+ *
+ * It replaces MixerAudioSource. Every channel strip has a trim, a fader gain, a
+ * balance control and a crossfader assignment. The crossfader has linear,
+ * constant-power and cut curves. All buffers are allocated in prepareToPlay(),
+ * parameters are atomics ramped per block, and channels are summed with the
+ * vectorised FloatVectorOperations, so the audio callback never locks or allocates.
+ *
+ * Channels must be added before the audio device starts.
+ */
+class DeckMixer : public AudioSource
+{
+public:
+    /**
+     * Which side of the crossfader a channel is on.
+     */
+    enum class Assignment
+    {
+        thru = 0,
+        a,
+        b
+    };
+
+    /**
+     * The shape of the crossfader gain curves.
+     */
+    enum class CrossfaderCurve
+    {
+        linear = 0,
+        constantPower,
+        cut
+    };
+
+    /**
+     * Constructor for DeckMixer.
+     */
+    DeckMixer();
+
+    /**
+     * Destructor for DeckMixer.
+     */
+    ~DeckMixer() override;
+
+    /**
+     * Add a channel strip. Must be called before the audio device starts.
+     * @param source The source feeding the channel. Not owned.
+     * @param assignment The crossfader side of the channel.
+     * @return The index of the new channel.
+     */
+    int addChannel(AudioSource* source, Assignment assignment);
+
+    /**
+     * Get the number of channel strips.
+     * @return The number of channels.
+     */
+    int getNumChannels() const;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Override of the getNextAudioBlock method to fill the buffer with the mix of all channels.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Set the fader gain of a channel.
+     * @param channel The channel index.
+     * @param gain The gain, between 0 and 1.
+     */
+    void setChannelGain(int channel, float gain);
+
+    /**
+     * Set the trim of a channel, applied before the fader.
+     * @param channel The channel index.
+     * @param trim The linear trim gain, between 0 and 4.
+     */
+    void setChannelTrim(int channel, float trim);
+
+    /**
+     * Set the balance of a channel.
+     * @param channel The channel index.
+     * @param pan The balance, -1 for left only, 0 for centre, 1 for right only.
+     */
+    void setChannelPan(int channel, float pan);
+
+    /**
+     * Set the crossfader position.
+     * @param position 0 for side A only, 1 for side B only.
+     */
+    void setCrossfaderPosition(float position);
+
+    /**
+     * Select the crossfader curve.
+     * @param curve The curve to use.
+     */
+    void setCrossfaderCurve(CrossfaderCurve curve);
+
+    /**
+     * Get the crossfader curve.
+     * @return The curve in use.
+     */
+    CrossfaderCurve getCrossfaderCurve() const;
+
+    /**
+     * Compute the gains of both crossfader sides.
+     * @param curve The crossfader curve.
+     * @param position The crossfader position, 0 to 1.
+     * @return The gains of side A and side B.
+     */
+    static std::pair<float, float> getCrossfaderGains(CrossfaderCurve curve, float position);
+
+    /**
+     * Time the mixing of every block in a profiler, excluding the channel sources.
+     * Must be called before the audio device starts.
+     * @param _profiler The profiler to record into, or nullptr to stop recording.
+     * @param _mixStage The stage that receives the mixing time.
+     */
+    void setProfiler(CallbackProfiler* _profiler, int _mixStage);
+
+private:
+    /**
+     * One channel strip.
+     */
+    struct Channel
+    {
+        AudioSource* source = nullptr;
+        Assignment assignment = Assignment::thru;
+
+        std::atomic<float> gain{ 1.0f };
+        std::atomic<float> trim{ 1.0f };
+        std::atomic<float> pan{ 0.0f };
+
+        /**
+         * Combined left and right gains, ramped between blocks.
+         */
+        SmoothedValue<float> leftGain{ 1.0f }, rightGain{ 1.0f };
+
+        /**
+         * Preallocated buffer the source renders into.
+         */
+        AudioBuffer<float> scratch;
+    };
+
+    /**
+     * Mix up to one prepared block into the mix bus.
+     * @return The time spent in the channel sources, in high resolution ticks.
+     */
+    juce::int64 mixChunk(int numSamples);
+
+    std::vector<std::unique_ptr<Channel>> channels;
+
+    std::atomic<float> crossfaderPosition{ 0.5f };
+    std::atomic<int> crossfaderCurve{ static_cast<int>(CrossfaderCurve::linear) };
+
+    /**
+     * Preallocated stereo sum of all channels.
+     */
+    AudioBuffer<float> mixBus;
+    int maxBlockSize = 0;
+
+    /**
+     * Profiler and stage the audio thread records into. Not owned, may be null.
+     */
+    CallbackProfiler* profiler = nullptr;
+    int mixStage = -1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckMixer)
+};
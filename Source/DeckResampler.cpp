@@ -0,0 +1,307 @@
+/*
+  ==============================================================================
+
+    DeckResampler.cpp
+    Created: 18 Oct 2026 9:20:44am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "DeckResampler.h"
+
+#if JUCE_USE_SSE_INTRINSICS
+ #include <immintrin.h>
+#elif JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
+namespace
+{
+    static_assert(DeckResampler::maxLeftContext + DeckResampler::maxRightContext + 1 == 16,
+        "The vectorised sinc kernel is written for 16 taps");
+
+    // Dot product of 16 samples with 16 coefficients, the inner loop of the sinc kernel
+    inline float dotProduct16(const float* samples, const float* coefficients) noexcept
+    {
+       #if JUCE_USE_SSE_INTRINSICS && defined (__AVX__)
+        __m256 sum = _mm256_mul_ps(_mm256_loadu_ps(samples), _mm256_loadu_ps(coefficients));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(samples + 8), _mm256_loadu_ps(coefficients + 8)));
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        return _mm_cvtss_f32(half);
+       #elif JUCE_USE_SSE_INTRINSICS
+        __m128 sum = _mm_mul_ps(_mm_loadu_ps(samples), _mm_loadu_ps(coefficients));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 4), _mm_loadu_ps(coefficients + 4)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 8), _mm_loadu_ps(coefficients + 8)));
+        sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(samples + 12), _mm_loadu_ps(coefficients + 12)));
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+       #elif JUCE_USE_ARM_NEON
+        float32x4_t sum = vmulq_f32(vld1q_f32(samples), vld1q_f32(coefficients));
+        sum = vmlaq_f32(sum, vld1q_f32(samples + 4), vld1q_f32(coefficients + 4));
+        sum = vmlaq_f32(sum, vld1q_f32(samples + 8), vld1q_f32(coefficients + 8));
+        sum = vmlaq_f32(sum, vld1q_f32(samples + 12), vld1q_f32(coefficients + 12));
+        float32x2_t pair = vadd_f32(vget_low_f32(sum), vget_high_f32(sum));
+        return vget_lane_f32(vpadd_f32(pair, pair), 0);
+       #else
+        float sum = 0.0f;
+        for (int i = 0; i < 16; ++i)
+            sum += samples[i] * coefficients[i];
+        return sum;
+       #endif
+    }
+}
+
+//==============================================================================
+DeckResampler::DeckResampler(AudioSource* _input)
+    : input(_input)
+{
+    buildSincTables();
+}
+
+DeckResampler::~DeckResampler()
+{
+}
+
+void DeckResampler::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    maxChunkSize = jmax(1, samplesPerBlockExpected);
+
+    // The last output sample of a chunk is at most (maxChunkSize - 1) * maxRatio past the first,
+    // which is less than one sample past the kept history, and needs the right context after it.
+    // Two samples of slack cover the rounding of the ramped read position.
+    maxInputPerChunk = static_cast<int>(std::ceil((maxChunkSize - 1) * maxRatio)) + maxRightContext + 3;
+    input->prepareToPlay(maxInputPerChunk, sampleRate);
+
+    inputBuffer.setSize(2, maxLeftContext + maxInputPerChunk);
+    ratioSmoother.reset(sampleRate, 0.05);
+    reset();
+}
+
+void DeckResampler::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    const int numChannels = jmin(2, bufferToFill.buffer->getNumChannels());
+
+    for (int done = 0; done < bufferToFill.numSamples; done += maxChunkSize)
+    {
+        processChunk(*bufferToFill.buffer, bufferToFill.startSample + done,
+            jmin(maxChunkSize, bufferToFill.numSamples - done), numChannels);
+    }
+
+    for (int channel = numChannels; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+    {
+        bufferToFill.buffer->clear(channel, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+}
+
+void DeckResampler::releaseResources()
+{
+    input->releaseResources();
+    inputBuffer.setSize(2, 0);
+}
+
+void DeckResampler::setResamplingRatio(double newRatio)
+{
+    jassert(newRatio > 0.0);
+    ratio = jlimit(0.0001, maxRatio, newRatio);
+}
+
+double DeckResampler::getResamplingRatio() const
+{
+    return ratio;
+}
+
+void DeckResampler::setMode(Mode newMode)
+{
+    mode = static_cast<int>(newMode);
+}
+
+DeckResampler::Mode DeckResampler::getMode() const
+{
+    return static_cast<Mode>(mode.load());
+}
+
+void DeckResampler::reset() noexcept
+{
+    // Start with silent history so the first output sample has full left context
+    inputBuffer.clear(0, jmin(maxLeftContext, inputBuffer.getNumSamples()));
+    numValidSamples = maxLeftContext;
+    readPos = maxLeftContext;
+    ratioSmoother.setCurrentAndTargetValue(ratio.load(std::memory_order_relaxed));
+}
+
+double DeckResampler::getLatencySamples() const noexcept
+{
+    // Input pulled from the source but not played out yet, measured from the kernel's centre
+    return numValidSamples - readPos;
+}
+
+void DeckResampler::processChunk(AudioBuffer<float>& output, int startSample, int numSamples, int numChannels)
+{
+    ratioSmoother.setTargetValue(ratio.load(std::memory_order_relaxed));
+    const Mode currentMode = static_cast<Mode>(mode.load(std::memory_order_relaxed));
+
+    // Make sure every input sample the last output sample depends on is available,
+    // whichever way the ratio is ramping
+    const double maxStep = jmax(ratioSmoother.getCurrentValue(), ratioSmoother.getTargetValue());
+    const double lastPos = readPos + (numSamples - 1) * maxStep;
+    fillInput(static_cast<int>(lastPos) + maxRightContext + 1);
+
+    const float* in[2] = { inputBuffer.getReadPointer(0), inputBuffer.getReadPointer(1) };
+    float* out[2] = { output.getWritePointer(0, startSample),
+                      numChannels > 1 ? output.getWritePointer(1, startSample) : nullptr };
+
+    float coefficients[sincTaps];
+
+    double pos = readPos;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double step = ratioSmoother.getNextValue();
+        const int base = static_cast<int>(pos);
+        const float t = static_cast<float>(pos - base);
+
+        switch (currentMode)
+        {
+            case Mode::linear:
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const float* x = in[channel] + base;
+                    out[channel][i] = x[0] + t * (x[1] - x[0]);
+                }
+                break;
+
+            case Mode::cubic:
+            {
+                // 4-point, 3rd-order Lagrange over x[-1] .. x[2]
+                const float cm1 = -t * (t - 1.0f) * (t - 2.0f) * (1.0f / 6.0f);
+                const float c0 = (t + 1.0f) * (t - 1.0f) * (t - 2.0f) * 0.5f;
+                const float c1 = -(t + 1.0f) * t * (t - 2.0f) * 0.5f;
+                const float c2 = (t + 1.0f) * t * (t - 1.0f) * (1.0f / 6.0f);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    const float* x = in[channel] + base;
+                    out[channel][i] = cm1 * x[-1] + c0 * x[0] + c1 * x[1] + c2 * x[2];
+                }
+                break;
+            }
+
+            case Mode::sinc:
+            {
+                getSincCoefficients(t, step, coefficients);
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    out[channel][i] = dotProduct16(in[channel] + base - maxLeftContext, coefficients);
+                }
+                break;
+            }
+        }
+
+        pos += step;
+    }
+
+    readPos = pos;
+
+    // Drop consumed input, keeping the left context of the next output sample
+    const int keepFrom = static_cast<int>(readPos) - maxLeftContext;
+
+    if (keepFrom > 0)
+    {
+        const int numToKeep = numValidSamples - keepFrom;
+
+        for (int channel = 0; channel < inputBuffer.getNumChannels(); ++channel)
+        {
+            float* data = inputBuffer.getWritePointer(channel);
+            std::memmove(data, data + keepFrom, sizeof(float) * (size_t) numToKeep);
+        }
+
+        numValidSamples = numToKeep;
+        readPos -= keepFrom;
+    }
+}
+
+void DeckResampler::fillInput(int required)
+{
+    jassert(required <= inputBuffer.getNumSamples());
+
+    if (required <= numValidSamples)
+        return;
+
+    // Never ask the input for more than the block size it was prepared with
+    jassert(required - numValidSamples <= maxInputPerChunk);
+
+    AudioSourceChannelInfo info(&inputBuffer, numValidSamples, required - numValidSamples);
+    input->getNextAudioBlock(info);
+    numValidSamples = required;
+}
+
+void DeckResampler::buildSincTables()
+{
+    sincTables.allocate((size_t) (numSincTables * sincTableSize), true);
+
+    for (int table = 0; table < numSincTables; ++table)
+    {
+        // Playing faster than the input moves its Nyquist frequency down by the ratio
+        const double cutoff = 1.0 / (1.0 + table * sincRatioStep);
+
+        for (int phase = 0; phase <= sincPhases; ++phase)
+        {
+            const double fraction = phase / static_cast<double>(sincPhases);
+            float* row = sincTables + table * sincTableSize + phase * sincTaps;
+            double sum = 0.0;
+
+            for (int tap = 0; tap < sincTaps; ++tap)
+            {
+                // Distance from the output position to the input sample under this tap
+                const double x = (tap - maxLeftContext) - fraction;
+                const double sinc = std::abs(x) < 1.0e-9 ? 1.0
+                    : std::sin(MathConstants<double>::pi * cutoff * x) / (MathConstants<double>::pi * cutoff * x);
+
+                // Blackman window spanning the whole kernel
+                const double w = (x + maxLeftContext + 1) / (sincTaps + 1.0);
+                const double window = 0.42 - 0.5 * std::cos(MathConstants<double>::twoPi * w)
+                                    + 0.08 * std::cos(2.0 * MathConstants<double>::twoPi * w);
+
+                row[tap] = static_cast<float>(sinc * window);
+                sum += row[tap];
+            }
+
+            // Normalise for unity gain at DC, which also undoes the gain of the lower cutoff
+            for (int tap = 0; tap < sincTaps; ++tap)
+            {
+                row[tap] = static_cast<float>(row[tap] / sum);
+            }
+        }
+    }
+}
+
+void DeckResampler::getSincCoefficients(float t, double step, float* coefficients) const noexcept
+{
+    // Interpolate between the two nearest phases...
+    const float phase = t * sincPhases;
+    const int phaseIndex = jmin(sincPhases - 1, static_cast<int>(phase));
+    const float phaseFraction = phase - phaseIndex;
+
+    // ...of the two tables whose cutoffs are either side of this ratio
+    const double tablePosition = jlimit(0.0, numSincTables - 1.0, (step - 1.0) / sincRatioStep);
+    const int tableIndex = jmin(numSincTables - 2, static_cast<int>(tablePosition));
+    const float tableFraction = static_cast<float>(tablePosition - tableIndex);
+
+    const float* lower = sincTables + tableIndex * sincTableSize + phaseIndex * sincTaps;
+    const float* higher = lower + sincTableSize;
+
+    FloatVectorOperations::copy(coefficients, lower, sincTaps);
+    FloatVectorOperations::multiply(coefficients, (1.0f - phaseFraction) * (1.0f - tableFraction), sincTaps);
+    FloatVectorOperations::addWithMultiply(coefficients, lower + sincTaps, phaseFraction * (1.0f - tableFraction), sincTaps);
+
+    if (tableFraction > 0.0f)
+    {
+        FloatVectorOperations::addWithMultiply(coefficients, higher, (1.0f - phaseFraction) * tableFraction, sincTaps);
+        FloatVectorOperations::addWithMultiply(coefficients, higher + sincTaps, phaseFraction * tableFraction, sincTaps);
+    }
+}
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    DeckResampler.h
+    Created: 18 Oct 2026 9:20:44am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The DeckResampler class changes the playback speed of a deck by resampling its input.
+ *
+ * It replaces ResamplingAudioSource with a choice of interpolation kernels:
+ * linear, 4-point cubic Lagrange and a 16-tap Blackman-windowed sinc. The sinc
+ * kernel uses SSE, AVX or NEON when available. When playing faster than the input
+ * its cutoff is lowered by the ratio, so the input is band-limited before it is
+ * decimated and fast playback does not alias. The mode and the ratio can be
+ * changed from any thread; every mode keeps the same input history, so switching
+ * modes mid-playback is seamless. Ratio changes are ramped sample by sample over
+ * 50 ms so speed changes never produce zipper noise.
+ */
+class DeckResampler : public AudioSource
+{
+public:
+    /**
+     * The interpolation kernels.
+     */
+    enum class Mode
+    {
+        linear = 0,
+        cubic,
+        sinc
+    };
+
+    /**
+     * Constructor for DeckResampler.
+     * @param _input The source to read from. Not owned.
+     */
+    DeckResampler(AudioSource* _input);
+
+    /**
+     * Destructor for DeckResampler.
+     */
+    ~DeckResampler() override;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Override of the getNextAudioBlock method to resample the input into the buffer.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Set the resampling ratio. Values above 1 play faster, values below 1 play slower.
+     * @param ratio The ratio, between 0 and maxRatio.
+     */
+    void setResamplingRatio(double ratio);
+
+    /**
+     * Get the resampling ratio.
+     * @return The ratio.
+     */
+    double getResamplingRatio() const;
+
+    /**
+     * Select the interpolation kernel.
+     * @param newMode The kernel to use from the next block on.
+     */
+    void setMode(Mode newMode);
+
+    /**
+     * Get the interpolation kernel in use.
+     * @return The kernel.
+     */
+    Mode getMode() const;
+
+    /**
+     * Forget all buffered input. Call on the audio thread, it does not allocate.
+     */
+    void reset() noexcept;
+
+    /**
+     * Get how far the input has been read ahead of the next output sample, which is
+     * what the kernel's right context and the buffered input add up to. Call on the audio thread.
+     * @return The latency in input samples.
+     */
+    double getLatencySamples() const noexcept;
+
+    /**
+     * The highest ratio the input buffer is sized for.
+     */
+    static constexpr double maxRatio = 5.0;
+
+    /**
+     * Samples of left and right context needed by the widest kernel.
+     */
+    static constexpr int maxLeftContext = 7;
+    static constexpr int maxRightContext = 8;
+
+private:
+    /**
+     * Resample up to one prepared block of output.
+     */
+    void processChunk(AudioBuffer<float>& output, int startSample, int numSamples, int numChannels);
+
+    /**
+     * Pull more input so that samples up to index `required` are valid.
+     */
+    void fillInput(int required);
+
+    /**
+     * Fill the windowed-sinc coefficient tables, one per cutoff.
+     */
+    void buildSincTables();
+
+    /**
+     * Blend the sinc coefficients for a fractional position and a ratio into `coefficients`.
+     */
+    void getSincCoefficients(float t, double step, float* coefficients) const noexcept;
+
+    AudioSource* input;
+
+    std::atomic<double> ratio{ 1.0 };
+
+    /**
+     * Ramps the ratio used by the audio thread towards the requested ratio.
+     */
+    SmoothedValue<double> ratioSmoother{ 1.0 };
+    std::atomic<int> mode{ static_cast<int>(Mode::linear) };
+
+    /**
+     * Input samples, with maxLeftContext samples of history before readPos.
+     */
+    AudioBuffer<float> inputBuffer;
+    int numValidSamples = 0;
+    double readPos = 0.0;
+
+    /**
+     * Largest number of output samples processed in one go, and the most input
+     * that one chunk can request.
+     */
+    int maxChunkSize = 0;
+    int maxInputPerChunk = 0;
+
+    /**
+     * Number of phases in each sinc table. One extra phase is stored so neighbouring
+     * phases can always be interpolated.
+     */
+    static constexpr int sincPhases = 256;
+    static constexpr int sincTaps = maxLeftContext + maxRightContext + 1;
+    static constexpr int sincTableSize = (sincPhases + 1) * sincTaps;
+
+    /**
+     * One table per ratio from 1 to maxRatio in steps of sincRatioStep, with the cutoff
+     * at 1 / ratio of the input's Nyquist. Ratios in between blend two neighbouring tables.
+     */
+    static constexpr double sincRatioStep = 0.25;
+    static constexpr int numSincTables = static_cast<int>((maxRatio - 1.0) / sincRatioStep) + 1;
+
+    HeapBlock<float> sincTables;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckResampler)
+};
@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DeckTrack.cpp
+    Created: 17 Oct 2026 2:40:55pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "DeckTrack.h"
+
+std::unique_ptr<DeckTrack> DeckTrack::create(AudioFormatManager& formatManager,
+                                             const URL& audioURL,
+                                             TimeSliceThread& readAheadThread,
+                                             int readAheadBufferSize,
+                                             std::atomic<int>& underrunCount)
+{
+    bool isMemoryMapped = false;
+    auto* reader = createReaderFor(formatManager, audioURL, isMemoryMapped);
+
+    if (reader == nullptr)
+        return nullptr;
+
+    std::unique_ptr<DeckTrack> track(new DeckTrack());
+    track->audioURL = audioURL;
+    track->readerSource.reset(new AudioFormatReaderSource(reader, true));
+
+    if (isMemoryMapped)
+    {
+        // Mapped files are read straight from memory, no read-ahead needed
+        track->transportSource.setSource(track->readerSource.get(), 0, nullptr, reader->sampleRate);
+    }
+    else
+    {
+        // Compressed or remote files are decoded ahead on the read-ahead thread
+        const int numChannels = jmax(2, static_cast<int>(reader->numChannels));
+        track->readAheadSource.reset(new ReadAheadAudioSource(track->readerSource.get(), readAheadThread,
+            readAheadBufferSize, numChannels, underrunCount));
+
+        // Jumping back to a loop start would empty the read-ahead buffer, so the loop start is played from memory
+        track->loopStartCache.reset(new LoopStartCache(track->readAheadSource.get(), reader->sampleRate, numChannels));
+        track->transportSource.setSource(track->loopStartCache.get(), 0, nullptr, reader->sampleRate);
+    }
+
+    return track;
+}
+
+std::unique_ptr<DeckTrack> DeckTrack::createResident(const URL& audioURL,
+                                                     std::shared_ptr<SampleCache::Sample> sample)
+{
+    std::unique_ptr<DeckTrack> track(new DeckTrack());
+    track->audioURL = audioURL;
+    track->residentSample = std::move(sample);
+
+    // Play the shared buffer in place rather than copying it
+    track->memorySource.reset(new MemoryAudioSource(track->residentSample->buffer, false));
+    track->transportSource.setSource(track->memorySource.get(), 0, nullptr, track->residentSample->sampleRate);
+
+    return track;
+}
+
+DeckTrack::~DeckTrack()
+{
+    transportSource.setSource(nullptr);
+}
+
+AudioFormatReader* DeckTrack::createReaderFor(AudioFormatManager& formatManager,
+                                              const URL& audioURL,
+                                              bool& isMemoryMapped)
+{
+    isMemoryMapped = false;
+
+    if (audioURL.isLocalFile())
+    {
+        File audioFile = audioURL.getLocalFile();
+
+        // Only uncompressed formats such as WAV and AIFF provide a memory-mapped reader
+        if (auto* format = formatManager.findFormatForFileExtension(audioFile.getFileExtension()))
+        {
+            std::unique_ptr<MemoryMappedAudioFormatReader> mappedReader(format->createMemoryMappedReader(audioFile));
+
+            if (mappedReader != nullptr && mappedReader->mapEntireFile())
+            {
+                isMemoryMapped = true;
+                return mappedReader.release();
+            }
+        }
+    }
+
+    return formatManager.createReaderFor(audioURL.createInputStream(false));
+}
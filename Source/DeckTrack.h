@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    DeckTrack.h
+    Created: 17 Oct 2026 2:40:55pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ReadAheadAudioSource.h"
+#include "LoopStartCache.h"
+#include "SampleCache.h"
+#include "BeatGrid.h"
+
+/**
+ * The DeckTrack class owns the complete source chain for one loaded track:
+ * the reader, the optional read-ahead buffer and the transport.
+ *
+ * A DeckTrack is built and prepared entirely off the audio thread and is then
+ * handed to the audio thread in one piece, so loading a track never takes the
+ * audio callback lock of the track that is currently playing.
+ */
+class DeckTrack
+{
+public:
+    /**
+     * Open a track and build its source chain.
+     *
+     * Local files whose format supports it are memory-mapped, everything else
+     * is decoded ahead of the playhead on the read-ahead thread.
+     *
+     * @param formatManager       The AudioFormatManager used to open the file.
+     * @param audioURL            The URL of the audio file to load.
+     * @param readAheadThread     The thread that fills read-ahead buffers.
+     * @param readAheadBufferSize The size of the read-ahead buffer in samples.
+     * @param underrunCount       Counter incremented when the read-ahead buffer underruns.
+     * @return                    The new track, or nullptr if the file could not be opened.
+     */
+    static std::unique_ptr<DeckTrack> create(AudioFormatManager& formatManager,
+        const URL& audioURL,
+        TimeSliceThread& readAheadThread,
+        int readAheadBufferSize,
+        std::atomic<int>& underrunCount);
+
+    /**
+     * Build a RAM-resident track that plays from an already decoded sample.
+     * Seeking only moves a read index, the file is never touched again.
+     *
+     * @param audioURL The URL the sample was decoded from.
+     * @param sample   The decoded track, shared with the SampleCache.
+     * @return         The new track.
+     */
+    static std::unique_ptr<DeckTrack> createResident(const URL& audioURL,
+        std::shared_ptr<SampleCache::Sample> sample);
+
+    /**
+     * Destructor for DeckTrack.
+     */
+    ~DeckTrack();
+
+    /**
+     * The URL the track was loaded from.
+     */
+    URL audioURL;
+
+    /**
+     * Unique pointer to manage the AudioFormatReaderSource's lifecycle.
+     */
+    std::unique_ptr<AudioFormatReaderSource> readerSource;
+
+    /**
+     * Read-ahead buffer between readerSource and transportSource.
+     * Null when the loaded file is memory-mapped.
+     */
+    std::unique_ptr<ReadAheadAudioSource> readAheadSource;
+
+    /**
+     * Keeps the audio after the loop start in memory, between readAheadSource and transportSource.
+     * Null when the loaded file is memory-mapped or RAM-resident, as those seek without waiting.
+     */
+    std::unique_ptr<LoopStartCache> loopStartCache;
+
+    /**
+     * The decoded samples and the source that plays them, for RAM-resident tracks.
+     */
+    std::shared_ptr<SampleCache::Sample> residentSample;
+    std::unique_ptr<MemoryAudioSource> memorySource;
+
+    /**
+     * AudioTransportSource for managing playback of this track.
+     * Declared after the sources it reads from so it is destroyed first.
+     */
+    AudioTransportSource transportSource;
+
+    /**
+     * The beat grid of the track and its cue point in seconds.
+     * Set before the track is handed over, then only touched on the audio thread.
+     */
+    BeatGrid beatGrid;
+    double cuePointSeconds = 0.0;
+
+    /**
+     * The loop in and out points in seconds, -1 while unset, and whether the deck is looping between them.
+     * Only touched on the audio thread.
+     */
+    double loopInSeconds = -1.0;
+    double loopOutSeconds = -1.0;
+    bool loopEngaged = false;
+
+private:
+    DeckTrack() = default;
+
+    /**
+     * Open a reader for the URL, memory-mapping local files whose format supports it.
+     * @param formatManager The AudioFormatManager used to open the file.
+     * @param audioURL The URL of the audio file to open.
+     * @param isMemoryMapped Set to true if the returned reader is memory-mapped.
+     * @return The new reader, or nullptr if the file could not be opened.
+     */
+    static AudioFormatReader* createReaderFor(AudioFormatManager& formatManager,
+        const URL& audioURL, bool& isMemoryMapped);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DeckTrack)
+};
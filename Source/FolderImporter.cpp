@@ -0,0 +1,205 @@
+/*
+  ==============================================================================
+
+    FolderImporter.cpp
+    Created: 22 Oct 2026 2:07:45pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "FolderImporter.h"
+
+//==============================================================================
+class FolderImporter::ScanJob : public ThreadPoolJob
+{
+public:
+    ScanJob(FolderImporter& _owner, const juce::File& _folder)
+        : ThreadPoolJob("Scan " + _folder.getFullPathName()),
+          owner(_owner),
+          folder(_folder)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        // Only this folder is listed here, subfolders become jobs of their own
+        for (const auto& entry : RangedDirectoryIterator(folder, false, "*", File::findFilesAndDirectories))
+        {
+            if (shouldExit() || owner.cancelled)
+                break;
+
+            if (entry.isHidden())
+                continue;
+
+            if (entry.isDirectory())
+            {
+                // Following links could walk the same tree twice or loop forever
+                if (!entry.getFile().isSymbolicLink())
+                    owner.addFolder(entry.getFile());
+            }
+            else
+            {
+                owner.addFile(entry.getFile());
+            }
+        }
+
+        owner.jobFinished();
+        return jobHasFinished;
+    }
+
+private:
+    FolderImporter& owner;
+    juce::File folder;
+};
+
+//==============================================================================
+class FolderImporter::ProbeJob : public ThreadPoolJob
+{
+public:
+    ProbeJob(FolderImporter& _owner, const juce::File& _file)
+        : ThreadPoolJob("Import " + _file.getFullPathName()),
+          owner(_owner),
+          file(_file)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (!shouldExit() && !owner.cancelled)
+            owner.addResult(TrackAnalyser::probe(owner.formatManager, juce::URL{ file }.toString(false)));
+
+        owner.jobFinished();
+        return jobHasFinished;
+    }
+
+private:
+    FolderImporter& owner;
+    juce::File file;
+};
+
+//==============================================================================
+FolderImporter::FolderImporter(AudioFormatManager& _formatManager, Listener& _listener)
+    : formatManager(_formatManager),
+      listener(_listener),
+      pool(jmax(1, SystemStats::getNumCpus()))
+{
+}
+
+FolderImporter::~FolderImporter()
+{
+    cancelled = true;
+    pool.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+}
+
+void FolderImporter::import(const Array<juce::File>& filesOrFolders)
+{
+    if (!importing)
+    {
+        importing = true;
+        cancelled = false;
+        numFound = 0;
+        numProbed = 0;
+    }
+
+    // Holds the import open until every item has been queued
+    ++pendingJobs;
+
+    for (const auto& item : filesOrFolders)
+    {
+        if (item.isDirectory())
+            addFolder(item);
+        else
+            addFile(item);
+    }
+
+    jobFinished();
+}
+
+void FolderImporter::cancel()
+{
+    if (!importing)
+        return;
+
+    cancelled = true;
+    pool.removeAllJobs(true, 5000);
+
+    pendingJobs = 0;
+    importing = false;
+
+    {
+        const ScopedLock sl(resultLock);
+        finishedResults.clear();
+    }
+
+    listener.importFinished(true);
+}
+
+bool FolderImporter::isImporting() const
+{
+    return importing;
+}
+
+void FolderImporter::addFolder(const juce::File& folder)
+{
+    ++pendingJobs;
+    pool.addJob(new ScanJob(*this, folder), true);
+}
+
+void FolderImporter::addFile(const juce::File& file)
+{
+    // Only the extension is checked here, the probe decides whether the file is readable
+    if (formatManager.findFormatForFileExtension(file.getFileExtension()) == nullptr)
+        return;
+
+    ++numFound;
+    ++pendingJobs;
+    pool.addJob(new ProbeJob(*this, file), true);
+}
+
+void FolderImporter::addResult(const TrackAnalyser::Result& result)
+{
+    ++numProbed;
+
+    if (!result.WasReadable)
+        return;
+
+    const ScopedLock sl(resultLock);
+    finishedResults.add(result);
+}
+
+void FolderImporter::jobFinished()
+{
+    --pendingJobs;
+    triggerAsyncUpdate();
+}
+
+void FolderImporter::handleAsyncUpdate()
+{
+    // Jobs store their result before they count as finished, so reading the count
+    // first guarantees that a finished import has no results left behind
+    const bool allJobsFinished = pendingJobs <= 0;
+
+    Array<TrackAnalyser::Result> results;
+
+    {
+        const ScopedLock sl(resultLock);
+        results.swapWith(finishedResults);
+    }
+
+    // A cancelled import has already been reported
+    if (!importing)
+        return;
+
+    if (!results.isEmpty())
+        listener.importBatchReady(results);
+
+    listener.importProgressChanged(numProbed, numFound);
+
+    if (allJobsFinished)
+    {
+        importing = false;
+        listener.importFinished(false);
+    }
+}
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    FolderImporter.h
+    Created: 22 Oct 2026 2:07:45pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackAnalyser.h"
+
+/**
+ * The FolderImporter class imports files and whole folder trees into the
+ * playlist without blocking the message thread.
+ *
+ * Every folder is listed by its own job on a ThreadPool with one worker per CPU,
+ * so sibling folders are walked in parallel and subfolders are queued as they are
+ * found. Files with an extension handled by the AudioFormatManager are probed on
+ * the same pool. Probed tracks are handed to the Listener in batches on the
+ * message thread, together with the progress, until the import finishes or is
+ * cancelled.
+ */
+class FolderImporter : private AsyncUpdater
+{
+public:
+    /**
+     * Receives batches, progress and completion on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called with every readable track probed since the previous call.
+         *
+         * @param results The probed tracks, in completion order.
+         */
+        virtual void importBatchReady(const Array<TrackAnalyser::Result>& results) = 0;
+
+        /**
+         * Called after every batch with the progress so far.
+         *
+         * @param numProbed The number of audio files probed.
+         * @param numFound  The number of audio files found so far. Grows while folders are walked.
+         */
+        virtual void importProgressChanged(int numProbed, int numFound) = 0;
+
+        /**
+         * Called once the import is over.
+         *
+         * @param wasCancelled True if cancel() stopped the import.
+         */
+        virtual void importFinished(bool wasCancelled) = 0;
+    };
+
+    /**
+     * Constructor for FolderImporter.
+     *
+     * @param _formatManager Reference to the AudioFormatManager deciding which files are imported.
+     * @param _listener      The listener that receives the tracks.
+     */
+    FolderImporter(AudioFormatManager& _formatManager, Listener& _listener);
+
+    /**
+     * Destructor for FolderImporter. Abandons the running import.
+     */
+    ~FolderImporter() override;
+
+    /**
+     * Import files and folders. Folders are searched recursively.
+     * Calling it during an import adds the items to the running import.
+     *
+     * @param filesOrFolders The files and folders to import.
+     */
+    void import(const Array<juce::File>& filesOrFolders);
+
+    /**
+     * Stop the running import. Tracks already delivered stay in the playlist.
+     */
+    void cancel();
+
+    /**
+     * Check whether an import is running.
+     *
+     * @return True between import() and importFinished().
+     */
+    bool isImporting() const;
+
+private:
+    class ScanJob;
+    class ProbeJob;
+
+    /**
+     * Queue a job listing a folder. Called from any thread.
+     */
+    void addFolder(const juce::File& folder);
+
+    /**
+     * Queue a probe if the file has a supported extension. Called from any thread.
+     */
+    void addFile(const juce::File& file);
+
+    /**
+     * Store a probed track. Called from worker threads.
+     */
+    void addResult(const TrackAnalyser::Result& result);
+
+    /**
+     * Count a finished job and schedule delivery. Called from worker threads.
+     */
+    void jobFinished();
+
+    /**
+     * Deliver results, progress and completion to the listener on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    AudioFormatManager& formatManager;
+    Listener& listener;
+
+    /**
+     * Worker pool, one thread per CPU.
+     */
+    ThreadPool pool;
+
+    std::atomic<int> pendingJobs{ 0 };
+    std::atomic<int> numFound{ 0 };
+    std::atomic<int> numProbed{ 0 };
+    std::atomic<bool> cancelled{ false };
+
+    /**
+     * Whether an import is running. Message thread only.
+     */
+    bool importing = false;
+
+    /**
+     * Probed tracks waiting to be delivered, guarded by resultLock.
+     */
+    CriticalSection resultLock;
+    Array<TrackAnalyser::Result> finishedResults;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(FolderImporter)
+};
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    KeyAnalyser.cpp
+    Created: 26 Oct 2026 9:37:25am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "KeyAnalyser.h"
+
+namespace
+{
+    constexpr double analysisRate = 11025.0;
+    constexpr double lowPassHz = 2500.0;
+    constexpr int fftOrder = 12;
+    constexpr int fftSize = 1 << fftOrder;
+    constexpr int hopSize = fftSize / 2;
+    constexpr double lowestPitchHz = 80.0;
+    constexpr double highestPitchHz = 2000.0;
+    constexpr double minimumCorrelation = 0.4;
+
+    // Krumhansl-Kessler key profiles, from the tonic up in semitones
+    constexpr double majorProfile[12] = { 6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88 };
+    constexpr double minorProfile[12] = { 6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17 };
+
+    // In-place radix-2 FFT of one frame
+    void performFft(std::vector<std::complex<float>>& data, const std::vector<std::complex<float>>& twiddles)
+    {
+        for (size_t i = 1, j = 0; i < (size_t) fftSize; ++i)
+        {
+            size_t bit = (size_t) fftSize >> 1;
+
+            for (; (j & bit) != 0; bit >>= 1)
+                j ^= bit;
+
+            j ^= bit;
+
+            if (i < j)
+                std::swap(data[i], data[j]);
+        }
+
+        for (size_t length = 2; length <= (size_t) fftSize; length <<= 1)
+        {
+            const size_t step = (size_t) fftSize / length;
+            const size_t half = length / 2;
+
+            for (size_t start = 0; start < (size_t) fftSize; start += length)
+            {
+                for (size_t k = 0; k < half; ++k)
+                {
+                    const std::complex<float> odd = data[start + k + half] * twiddles[k * step];
+                    data[start + k + half] = data[start + k] - odd;
+                    data[start + k] += odd;
+                }
+            }
+        }
+    }
+
+    // Pearson correlation between the chromagram and a key profile rotated to a tonic
+    double correlateWithProfile(const double (&chromagram)[12], const double (&profile)[12], int tonic)
+    {
+        double chromaMean = 0.0;
+        double profileMean = 0.0;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            chromaMean += chromagram[i];
+            profileMean += profile[i];
+        }
+
+        chromaMean /= 12.0;
+        profileMean /= 12.0;
+
+        double product = 0.0;
+        double chromaVariance = 0.0;
+        double profileVariance = 0.0;
+
+        for (int i = 0; i < 12; ++i)
+        {
+            const double chroma = chromagram[(i + tonic) % 12] - chromaMean;
+            const double weight = profile[i] - profileMean;
+            product += chroma * weight;
+            chromaVariance += chroma * chroma;
+            profileVariance += weight * weight;
+        }
+
+        return chromaVariance > 0.0 ? product / std::sqrt(chromaVariance * profileVariance) : 0.0;
+    }
+}
+
+//==============================================================================
+KeyAnalyser::KeyAnalyser(double sampleRate)
+    : decimation(jmax(1, static_cast<int>(sampleRate / analysisRate))),
+      pitchClassOfBin((size_t) fftSize / 2, -1),
+      window((size_t) fftSize),
+      twiddles((size_t) fftSize / 2),
+      frame((size_t) fftSize, 0.0f),
+      spectrum((size_t) fftSize),
+      lowPassCoefficient(static_cast<float>(1.0 - std::exp(-MathConstants<double>::twoPi * lowPassHz / sampleRate)))
+{
+    // Everything above the highest pitch is dropped, so the track is decimated before the FFT
+    const double frameRate = sampleRate / decimation;
+
+    // Each FFT bin belongs to the pitch class nearest its centre frequency, or to none
+    for (int bin = 1; bin < fftSize / 2; ++bin)
+    {
+        const double frequency = bin * frameRate / fftSize;
+
+        if (frequency >= lowestPitchHz && frequency <= highestPitchHz)
+        {
+            const int midiNote = roundToInt(69.0 + 12.0 * std::log2(frequency / 440.0));
+            pitchClassOfBin[(size_t) bin] = midiNote % 12;
+        }
+    }
+
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t) i] = static_cast<float>(0.5 - 0.5 * std::cos(MathConstants<double>::twoPi * i / fftSize));
+
+    for (int k = 0; k < fftSize / 2; ++k)
+        twiddles[(size_t) k] = std::polar(1.0f, static_cast<float>(-MathConstants<double>::twoPi * k / fftSize));
+}
+
+KeyAnalyser::~KeyAnalyser()
+{
+}
+
+void KeyAnalyser::process(const float* samples, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Two one-pole low-passes keep most of what would alias from folding into the pitch range
+        firstPole += lowPassCoefficient * (samples[i] - firstPole);
+        secondPole += lowPassCoefficient * (firstPole - secondPole);
+
+        if (samplesToSkip > 0)
+        {
+            --samplesToSkip;
+            continue;
+        }
+
+        samplesToSkip = decimation - 1;
+        frame[(size_t) frameFill++] = secondPole;
+
+        if (frameFill == fftSize)
+            processFrame();
+    }
+}
+
+void KeyAnalyser::processFrame()
+{
+    for (int n = 0; n < fftSize; ++n)
+        spectrum[(size_t) n] = { frame[(size_t) n] * window[(size_t) n], 0.0f };
+
+    performFft(spectrum, twiddles);
+
+    double frameChroma[12] = {};
+    double loudest = 0.0;
+
+    for (int bin = 1; bin < fftSize / 2; ++bin)
+        if (pitchClassOfBin[(size_t) bin] >= 0)
+            frameChroma[pitchClassOfBin[(size_t) bin]] += std::abs(spectrum[(size_t) bin]);
+
+    for (double energy : frameChroma)
+        loudest = jmax(loudest, energy);
+
+    // Every frame with sound counts the same, so loud choruses do not outvote the rest
+    if (loudest > 1.0e-3)
+        for (int pitchClass = 0; pitchClass < 12; ++pitchClass)
+            chromagram[pitchClass] += frameChroma[pitchClass] / loudest;
+
+    // Frames overlap by half
+    std::copy(frame.begin() + hopSize, frame.end(), frame.begin());
+    frameFill = fftSize - hopSize;
+}
+
+KeyAnalyser::Result KeyAnalyser::getResult() const
+{
+    Result result;
+
+    // Try every tonic against both profiles, the best match is the key
+    double bestCorrelation = minimumCorrelation;
+
+    for (int key = 0; key < 24; ++key)
+    {
+        const double correlation = correlateWithProfile(chromagram, key < 12 ? majorProfile : minorProfile, key % 12);
+
+        if (correlation > bestCorrelation)
+        {
+            bestCorrelation = correlation;
+            result.Key = key;
+        }
+    }
+
+    // A chromagram that matches no profile well means the track has no clear tonal centre
+    result.WasAnalysed = result.Key >= 0;
+    return result;
+}
+
+juce::String KeyAnalyser::getKeyName(int key)
+{
+    static const char* const majorNames[12] = { "C", "Db", "D", "Eb", "E", "F", "F#", "G", "Ab", "A", "Bb", "B" };
+    static const char* const minorNames[12] = { "Cm", "C#m", "Dm", "Ebm", "Em", "Fm", "F#m", "Gm", "G#m", "Am", "Bbm", "Bm" };
+
+    if (key < 0 || key >= 24)
+        return {};
+
+    return key < 12 ? majorNames[key] : minorNames[key - 12];
+}
+
+juce::String KeyAnalyser::getCamelotCode(int key)
+{
+    if (key < 0 || key >= 24)
+        return {};
+
+    const int order = getCamelotOrder(key);
+    return juce::String(order / 2 + 1) + (order % 2 == 0 ? "A" : "B");
+}
+
+int KeyAnalyser::getCamelotOrder(int key)
+{
+    // A minor key sits on the same number as its relative major, a fifth up is the next number
+    const bool isMinor = key >= 12;
+    const int relativeMajor = isMinor ? (key - 12 + 3) % 12 : key;
+    const int number = (relativeMajor * 7 + 7) % 12;
+    return number * 2 + (isMinor ? 0 : 1);
+}
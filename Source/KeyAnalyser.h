@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+    KeyAnalyser.h
+    Created: 26 Oct 2026 9:37:25am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <complex>
+#include <vector>
+
+/**
+ * The KeyAnalyser class estimates the musical key of a track from its samples.
+ *
+ * The ContentAnalyser decodes a track once and hands the mono mix to this class block
+ * by block, together with the beat and loudness analysers. Every block is low-passed
+ * and decimated to about 11 kHz, and the FFT of every frame is folded into a
+ * chromagram: the energy of each of the 12 pitch classes between 80 Hz and 2 kHz.
+ * Only the running chromagram is kept, so memory stays bounded whatever the track
+ * length. The key is the major or minor key profile that correlates best with the
+ * chromagram of the whole track.
+ *
+ * Keys are numbered 0 to 11 for the major keys from C, and 12 to 23 for the minor
+ * keys from C minor.
+ */
+class KeyAnalyser
+{
+public:
+    /**
+     * The key of a single track.
+     */
+    struct Result
+    {
+        int Key = -1;
+        bool WasAnalysed = false;
+    };
+
+    /**
+     * Constructor for KeyAnalyser.
+     *
+     * @param sampleRate The sample rate of the track.
+     */
+    KeyAnalyser(double sampleRate);
+
+    /**
+     * Destructor for KeyAnalyser.
+     */
+    ~KeyAnalyser();
+
+    /**
+     * Add the next block of the track to the chromagram.
+     *
+     * @param samples    The mono mix of the block.
+     * @param numSamples The number of samples in the block.
+     */
+    void process(const float* samples, int numSamples);
+
+    /**
+     * Find the key of everything processed so far.
+     *
+     * @return The key, WasAnalysed is false if the track has no clear tonal centre.
+     */
+    Result getResult() const;
+
+    /**
+     * Get the name of a key, such as "C" or "F#m".
+     *
+     * @param key The key, 0 to 23.
+     * @return    The name, or an empty string for an unknown key.
+     */
+    static juce::String getKeyName(int key);
+
+    /**
+     * Get the position of a key on the Camelot wheel DJs use for harmonic mixing,
+     * such as "8B" for C major and "8A" for A minor.
+     *
+     * @param key The key, 0 to 23.
+     * @return    The Camelot code, or an empty string for an unknown key.
+     */
+    static juce::String getCamelotCode(int key);
+
+    /**
+     * Get a number that orders keys around the Camelot wheel, 1A first and 12B last,
+     * so keys that mix well sort next to each other.
+     *
+     * @param key The key, 0 to 23.
+     * @return    The order, from 0 to 23.
+     */
+    static int getCamelotOrder(int key);
+
+private:
+    /**
+     * Window and transform the filled frame and add its pitch class energy to the chromagram.
+     */
+    void processFrame();
+
+    /**
+     * The decimation factor, the pitch class each FFT bin belongs to or -1, the window
+     * and the FFT twiddles, all worked out once per track.
+     */
+    int decimation = 1;
+    std::vector<int> pitchClassOfBin;
+    std::vector<float> window;
+    std::vector<std::complex<float>> twiddles;
+
+    /**
+     * The decimated frame being filled and the buffer it is transformed in.
+     */
+    std::vector<float> frame;
+    std::vector<std::complex<float>> spectrum;
+    int frameFill = 0;
+
+    /**
+     * State of the low-pass that runs before the decimation.
+     */
+    float lowPassCoefficient = 0.0f;
+    float firstPole = 0.0f;
+    float secondPole = 0.0f;
+    int samplesToSkip = 0;
+
+    double chromagram[12] = {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(KeyAnalyser)
+};
@@ -0,0 +1,145 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.cpp
+    Created: 17 Oct 2026 11:03:47am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "LibraryIndex.h"
+
+bool LibraryIndex::save(const juce::File& indexFile, const TrackStore& tracks)
+{
+    TemporaryFile tempFile(indexFile);
+
+    {
+        FileOutputStream stream(tempFile.getFile());
+
+        if (!stream.openedOk())
+        {
+            DBG("LibraryIndex::save could not open " << tempFile.getFile().getFullPathName());
+            return false;
+        }
+
+        // Header
+        stream.writeInt(magicNumber);
+        stream.writeInt(formatVersion);
+        stream.writeInt(static_cast<int>(tracks.size()));
+
+        // One record per track
+        for (size_t i = 0; i < tracks.size(); ++i)
+        {
+            const SoundTrack track = tracks.getTrack(i);
+            stream.writeString(track.MusicName);
+            stream.writeString(track.MusicUrl);
+            stream.writeDouble(track.LengthInSeconds);
+            stream.writeDouble(track.SampleRate);
+            stream.writeInt(track.NumChannels);
+            stream.writeInt64(track.FileSize);
+            stream.writeInt64(track.ModificationTime);
+            stream.writeInt64(track.ContentHash);
+            stream.writeBool(track.IsAnalysed);
+            stream.writeDouble(track.Bpm);
+            stream.writeDouble(track.FirstBeatSeconds);
+            stream.writeByte(static_cast<char>(track.MusicalKey));
+            stream.writeBool(track.HasLoudness);
+            stream.writeDouble(track.LoudnessLufs);
+            stream.writeDouble(track.TruePeakDb);
+            stream.writeInt64(track.ContentAnalysedTime);
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+bool LibraryIndex::load(const juce::File& indexFile, std::vector<SoundTrack>& tracks)
+{
+    MemoryMappedFile mappedFile(indexFile, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr)
+        return false;
+
+    MemoryInputStream stream(mappedFile.getData(), mappedFile.getSize(), false);
+
+    const bool hasMagicNumber = stream.readInt() == magicNumber;
+    const int version = stream.readInt();
+
+    if (!hasMagicNumber || version < 1 || version > formatVersion)
+    {
+        DBG("LibraryIndex::load unsupported index " << indexFile.getFullPathName());
+        return false;
+    }
+
+    int numTracks = stream.readInt();
+
+    if (numTracks < 0)
+        return false;
+
+    // Bytes in a record after its two strings, for this version of the format
+    const auto fixedBytesPerRecord = static_cast<juce::int64>(2 * sizeof(double) + sizeof(int) + 3 * sizeof(juce::int64) + 1
+                                                            + (version >= 2 ? 2 * sizeof(double) : 0)
+                                                            + (version >= 3 ? 1 : 0)
+                                                            + (version >= 4 ? 1 + 2 * sizeof(double) : 0)
+                                                            + (version >= 5 ? sizeof(juce::int64) : 0));
+
+    tracks.reserve(tracks.size() + static_cast<size_t>(numTracks));
+
+    for (int i = 0; i < numTracks && !stream.isExhausted(); ++i)
+    {
+        juce::String musicName = stream.readString();
+        juce::String musicUrl = stream.readString();
+
+        // A file cut short while it was written ends in a partial record, which is dropped
+        if (stream.getNumBytesRemaining() < fixedBytesPerRecord)
+        {
+            DBG("LibraryIndex::load dropped a truncated record in " << indexFile.getFullPathName());
+            break;
+        }
+
+        SoundTrack track{ musicName, musicUrl };
+        track.LengthInSeconds = stream.readDouble();
+        track.SampleRate = stream.readDouble();
+        track.NumChannels = stream.readInt();
+        track.FileSize = stream.readInt64();
+        track.ModificationTime = stream.readInt64();
+        track.ContentHash = stream.readInt64();
+        track.IsAnalysed = stream.readBool();
+
+        // Version 1 records end here, their beats are analysed again
+        if (version >= 2)
+        {
+            track.Bpm = stream.readDouble();
+            track.FirstBeatSeconds = stream.readDouble();
+        }
+
+        // Version 3 added the key, older records are analysed again
+        if (version >= 3)
+            track.MusicalKey = jlimit(-1, 23, static_cast<int>(stream.readByte()));
+
+        // Version 4 added the loudness
+        if (version >= 4)
+        {
+            track.HasLoudness = stream.readBool();
+            track.LoudnessLufs = stream.readDouble();
+            track.TruePeakDb = stream.readDouble();
+        }
+
+        // Version 5 records when the content was analysed. Older records count as
+        // analysed if they have everything, the rest are analysed once more.
+        if (version >= 5)
+            track.ContentAnalysedTime = stream.readInt64();
+        else if (track.HasLoudness && track.Bpm > 0.0 && track.MusicalKey >= 0)
+            track.ContentAnalysedTime = track.ModificationTime;
+
+        tracks.push_back(std::move(track));
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    LibraryIndex.h
+    Created: 17 Oct 2026 11:03:47am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "SoundTrack.h"
+#include "TrackStore.h"
+
+/**
+ * The LibraryIndex class reads and writes the track library as a versioned
+ * binary file.
+ *
+ * Every SoundTrack is stored together with its probed metadata, so opening the
+ * library never has to touch the audio files themselves. The index is read
+ * through a memory-mapped view and written through a temporary file, so a crash
+ * while saving never leaves a half-written library behind.
+ */
+class LibraryIndex
+{
+public:
+    /**
+     * Write the tracks to the index file, replacing any previous contents.
+     *
+     * @param indexFile The file to write.
+     * @param tracks    The tracks to store.
+     * @return          True if the file was written successfully.
+     */
+    static bool save(const juce::File& indexFile, const TrackStore& tracks);
+
+    /**
+     * Read the tracks stored in the index file. A record cut short at the end of
+     * the file is dropped, along with anything after it.
+     *
+     * @param indexFile The file to read.
+     * @param tracks    The vector that receives the stored tracks.
+     * @return          True if the file exists and has a supported format.
+     */
+    static bool load(const juce::File& indexFile, std::vector<SoundTrack>& tracks);
+
+    /**
+     * The identifier written at the start of every index file.
+     */
+    static constexpr int magicNumber = 0x494c444f; // "ODLI"
+
+    /**
+     * The version of the format written by save(). Bump when the record layout changes.
+     * load() still reads every older version. Version 2 added the beat grid,
+     * version 3 the musical key, version 4 the loudness and version 5 the
+     * time the content was last analysed.
+     */
+    static constexpr int formatVersion = 5;
+};
@@ -0,0 +1,178 @@
+/*
+  ==============================================================================
+
+    LoopStartCache.cpp
+    Created: 27 Oct 2026 3:16:05pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "LoopStartCache.h"
+
+LoopStartCache::LoopStartCache(BufferingAudioSource* _source, double _sampleRate, int numChannels)
+    : source(_source),
+      sampleRate(_sampleRate),
+      history(numChannels, jmax(1, roundToInt(historySeconds * _sampleRate))),
+      cache(numChannels, jmax(1, roundToInt(cacheSeconds * _sampleRate)))
+{
+}
+
+LoopStartCache::~LoopStartCache()
+{
+}
+
+void LoopStartCache::setLoopStart(double seconds) noexcept
+{
+    // A few samples before the start too, as the transport may round its jump down when it converts the sample rate
+    const juce::int64 start = jmax<juce::int64>(0, static_cast<juce::int64>(std::floor(seconds * sampleRate)) - startMargin);
+
+    if (start == cacheStart)
+        return;
+
+    cacheStart = start;
+    cacheFill = 0;
+
+    // A loop start just behind the playhead was heard moments ago, so it is still in the history
+    if (start < historyEnd - historyFill || start >= historyEnd)
+        return;
+
+    const int historyLength = history.getNumSamples();
+    const int count = static_cast<int>(jmin<juce::int64>(historyEnd - start, cache.getNumSamples()));
+    const int first = static_cast<int>(start % historyLength);
+    const int beforeWrap = jmin(count, historyLength - first);
+
+    for (int channel = 0; channel < cache.getNumChannels(); ++channel)
+    {
+        cache.copyFrom(channel, 0, history, channel, first, beforeWrap);
+
+        if (count > beforeWrap)
+            cache.copyFrom(channel, beforeWrap, history, channel, 0, count - beforeWrap);
+    }
+
+    cacheFill = count;
+}
+
+void LoopStartCache::prepareToPlay(int samplesPerBlockExpected, double _sampleRate)
+{
+    source->prepareToPlay(samplesPerBlockExpected, _sampleRate);
+}
+
+void LoopStartCache::releaseResources()
+{
+    source->releaseResources();
+}
+
+void LoopStartCache::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    int offset = 0;
+
+    while (offset < bufferToFill.numSamples)
+    {
+        const int remaining = bufferToFill.numSamples - offset;
+        const int startSample = bufferToFill.startSample + offset;
+
+        if (isCached(position))
+        {
+            const int index = static_cast<int>(position - cacheStart);
+            const int numSamples = jmin(remaining, cacheFill - index);
+
+            for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+            {
+                if (channel < cache.getNumChannels())
+                    bufferToFill.buffer->copyFrom(channel, startSample, cache, channel, index, numSamples);
+                else
+                    bufferToFill.buffer->clear(channel, startSample, numSamples);
+            }
+
+            position += numSamples;
+            offset += numSamples;
+            continue;
+        }
+
+        // Leaving the cache, the source has been reading ahead from exactly here
+        if (source->getNextReadPosition() != position)
+            source->setNextReadPosition(position);
+
+        // Silence played while the read-ahead catches up must not be kept
+        const AudioSourceChannelInfo part(bufferToFill.buffer, startSample, remaining);
+        const bool isBuffered = source->waitForNextAudioBlockReady(part, 0);
+        source->getNextAudioBlock(part);
+
+        if (isBuffered)
+            capture(part, position);
+        else
+            historyFill = 0;
+
+        position += remaining;
+        offset += remaining;
+    }
+}
+
+void LoopStartCache::setNextReadPosition(juce::int64 newPosition)
+{
+    position = newPosition;
+
+    // Inside the cache the source reads ahead from where the cache ends, so it is ready when the cache runs out
+    source->setNextReadPosition(isCached(position) ? cacheStart + cacheFill : position);
+}
+
+juce::int64 LoopStartCache::getNextReadPosition() const
+{
+    return position;
+}
+
+juce::int64 LoopStartCache::getTotalLength() const
+{
+    return source->getTotalLength();
+}
+
+bool LoopStartCache::isLooping() const
+{
+    return source->isLooping();
+}
+
+void LoopStartCache::capture(const AudioSourceChannelInfo& info, juce::int64 start) noexcept
+{
+    const int numChannels = jmin(history.getNumChannels(), info.buffer->getNumChannels());
+
+    // The history only holds one contiguous run of the track
+    if (start != historyEnd)
+        historyFill = 0;
+
+    const int historyLength = history.getNumSamples();
+    const int skipped = jmax(0, info.numSamples - historyLength);
+
+    for (int written = skipped; written < info.numSamples;)
+    {
+        const int index = static_cast<int>((start + written) % historyLength);
+        const int numSamples = jmin(info.numSamples - written, historyLength - index);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            history.copyFrom(channel, index, *info.buffer, channel, info.startSample + written, numSamples);
+
+        written += numSamples;
+    }
+
+    historyEnd = start + info.numSamples;
+    historyFill = jmin(historyLength, historyFill + info.numSamples);
+
+    // The cache grows while the track plays on from its end
+    const juce::int64 cacheEnd = cacheStart + cacheFill;
+
+    if (cacheStart < 0 || cacheFill == cache.getNumSamples() || cacheEnd < start || cacheEnd >= historyEnd)
+        return;
+
+    const int first = static_cast<int>(cacheEnd - start);
+    const int numSamples = jmin(info.numSamples - first, cache.getNumSamples() - cacheFill);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        cache.copyFrom(channel, cacheFill, *info.buffer, channel, info.startSample + first, numSamples);
+
+    cacheFill += numSamples;
+}
+
+bool LoopStartCache::isCached(juce::int64 trackPosition) const noexcept
+{
+    return cacheStart >= 0 && trackPosition >= cacheStart && trackPosition < cacheStart + cacheFill;
+}
@@ -0,0 +1,125 @@
+/*
+  ==============================================================================
+
+    LoopStartCache.h
+    Created: 27 Oct 2026 3:16:05pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The LoopStartCache class keeps the audio just after a streamed track's loop
+ * start in memory, so jumping back to the loop start never waits on the disk.
+ *
+ * The read-ahead buffer of a streamed track only holds audio ahead of the playhead,
+ * so moving back to the loop start would throw it away and play silence until the
+ * background thread caught up. This class sits between the read-ahead buffer and
+ * the transport and copies the first couple of seconds after the loop start as
+ * they play, or from the last couple of seconds played when the loop start is just
+ * behind the playhead. A jump into the cached audio is played from memory while the
+ * read-ahead buffer refills from the end of the cache.
+ *
+ * Both buffers are allocated when the track is built, everything else runs on the
+ * audio thread without allocating.
+ */
+class LoopStartCache : public PositionableAudioSource
+{
+public:
+    /**
+     * Constructor for LoopStartCache.
+     *
+     * @param _source      The read-ahead buffer to cache. Not owned.
+     * @param _sampleRate  The sample rate of the track.
+     * @param numChannels  The number of channels to cache.
+     */
+    LoopStartCache(BufferingAudioSource* _source, double _sampleRate, int numChannels);
+
+    /**
+     * Destructor for LoopStartCache.
+     */
+    ~LoopStartCache() override;
+
+    /**
+     * Cache the audio from a new loop start. Nothing changes if the start is the same as before.
+     * Called on the audio thread.
+     *
+     * @param seconds The loop start in the track, in seconds.
+     */
+    void setLoopStart(double seconds) noexcept;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Play from the cache where it holds the audio, and from the source everywhere else.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    void setNextReadPosition(juce::int64 newPosition) override;
+    juce::int64 getNextReadPosition() const override;
+    juce::int64 getTotalLength() const override;
+    bool isLooping() const override;
+
+    /**
+     * How much audio after the loop start is cached, and how much of what was last played
+     * is kept for loop starts just behind the playhead. The cache must last longer than
+     * the read-ahead thread takes to refill after a jump.
+     */
+    static constexpr double cacheSeconds = 2.0;
+    static constexpr double historySeconds = 2.0;
+
+    /**
+     * Samples cached before the loop start.
+     */
+    static constexpr int startMargin = 16;
+
+private:
+    /**
+     * Keep a block that was read from the source, in the history and, if it continues the cache, in the cache.
+     * @param info The part of the buffer that was read.
+     * @param start The track position of its first sample.
+     */
+    void capture(const AudioSourceChannelInfo& info, juce::int64 start) noexcept;
+
+    /**
+     * Check whether the cache holds the audio at a track position.
+     */
+    bool isCached(juce::int64 trackPosition) const noexcept;
+
+    BufferingAudioSource* source;
+    double sampleRate;
+
+    /**
+     * The last samples read from the source, indexed by track position modulo its length.
+     * historyEnd is the position after the newest sample, historyFill how many are valid.
+     */
+    AudioBuffer<float> history;
+    juce::int64 historyEnd = 0;
+    int historyFill = 0;
+
+    /**
+     * The audio from the loop start on. cacheStart is -1 while there is no loop start.
+     */
+    AudioBuffer<float> cache;
+    juce::int64 cacheStart = -1;
+    int cacheFill = 0;
+
+    juce::int64 position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopStartCache)
+};
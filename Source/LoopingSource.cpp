@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    LoopingSource.cpp
+    Created: 26 Oct 2026 4:37:12pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "LoopingSource.h"
+
+LoopingSource::LoopingSource(TrackHandoffSource& _input)
+    : input(_input)
+{
+}
+
+LoopingSource::~LoopingSource()
+{
+}
+
+void LoopingSource::prepareToPlay(int samplesPerBlockExpected, double _sampleRate)
+{
+    input.prepareToPlay(samplesPerBlockExpected, _sampleRate);
+
+    // Allocated here so a wrap never allocates on the audio thread
+    sampleRate = _sampleRate;
+    tail.setSize(2, jmax(1, static_cast<int>(std::ceil(crossfadeSeconds * sampleRate))), false, true, true);
+    reset();
+}
+
+void LoopingSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    // The owner swaps tracks in at the start of its block only, so this is the track it is rendering
+    DeckTrack* track = input.getRenderingTrack();
+
+    if (track == nullptr || loopEndSeconds <= loopStartSeconds || sampleRate <= 0.0)
+    {
+        renderFading(bufferToFill);
+        return;
+    }
+
+    // The transport counts its position in output samples, so the loop is counted the same way
+    auto& transport = track->transportSource;
+    const juce::int64 loopStart = static_cast<juce::int64>(std::round(loopStartSeconds * sampleRate));
+    const juce::int64 loopEnd = jmax(loopStart + 1, static_cast<juce::int64>(std::round(loopEndSeconds * sampleRate)));
+    int offset = 0;
+
+    while (offset < bufferToFill.numSamples)
+    {
+        const juce::int64 position = transport.getNextReadPosition();
+
+        // A paused deck stays where it is
+        if (!transport.isPlaying())
+            break;
+
+        if (position >= loopEnd)
+        {
+            wrap(transport, loopStart, loopEnd - loopStart);
+
+            // A transport that could not be moved back plays on
+            if (transport.getNextReadPosition() >= loopEnd)
+                break;
+
+            continue;
+        }
+
+        const int numSamples = static_cast<int>(jmin<juce::int64>(bufferToFill.numSamples - offset, loopEnd - position));
+        renderFading(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample + offset, numSamples));
+        offset += numSamples;
+    }
+
+    if (offset < bufferToFill.numSamples)
+        renderFading(AudioSourceChannelInfo(bufferToFill.buffer, bufferToFill.startSample + offset, bufferToFill.numSamples - offset));
+}
+
+void LoopingSource::releaseResources()
+{
+    input.releaseResources();
+    tail.setSize(0, 0);
+}
+
+void LoopingSource::setLoop(double startSeconds, double endSeconds) noexcept
+{
+    loopStartSeconds = startSeconds;
+    loopEndSeconds = endSeconds;
+}
+
+void LoopingSource::clearLoop() noexcept
+{
+    loopStartSeconds = 0.0;
+    loopEndSeconds = 0.0;
+}
+
+void LoopingSource::reset() noexcept
+{
+    fadeLength = 0;
+    fadePosition = 0;
+}
+
+void LoopingSource::renderFading(const AudioSourceChannelInfo& info)
+{
+    input.getNextAudioBlock(info);
+
+    if (fadePosition >= fadeLength)
+        return;
+
+    const int numSamples = jmin(info.numSamples, fadeLength - fadePosition);
+    const float startGain = static_cast<float>(fadePosition) / fadeLength;
+    const float endGain = static_cast<float>(fadePosition + numSamples) / fadeLength;
+
+    // The loop start fades in as the audio past the loop end fades out
+    for (int channel = 0; channel < info.buffer->getNumChannels(); ++channel)
+    {
+        info.buffer->applyGainRamp(channel, info.startSample, numSamples, startGain, endGain);
+
+        if (channel < tail.getNumChannels())
+            info.buffer->addFromWithRamp(channel, info.startSample, tail.getReadPointer(channel, fadePosition),
+                                         numSamples, 1.0f - startGain, 1.0f - endGain);
+    }
+
+    fadePosition += numSamples;
+}
+
+void LoopingSource::wrap(AudioTransportSource& transport, juce::int64 loopStart, juce::int64 loopLength)
+{
+    // A short loop is never more than half crossfade, so each fade ends before the next wrap
+    fadeLength = static_cast<int>(jmin<juce::int64>(tail.getNumSamples(), loopLength / 2));
+    fadePosition = 0;
+
+    if (fadeLength > 0)
+        input.getNextAudioBlock(AudioSourceChannelInfo(&tail, 0, fadeLength));
+
+    transport.setNextReadPosition(loopStart);
+
+    // Reading the tail past the end of the track stops the transport
+    if (!transport.isPlaying())
+        transport.start();
+}
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    LoopingSource.h
+    Created: 26 Oct 2026 4:37:12pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "TrackHandoffSource.h"
+
+/**
+ * The LoopingSource class plays the deck's track and wraps around a loop at sample precision.
+ *
+ * It sits between the speed stages and the TrackHandoffSource, so loops are counted
+ * in samples of the track and stay exact at any speed. A block that crosses the loop
+ * end is rendered up to the exact sample, the transport is moved back to the loop
+ * start and the rest of the block is rendered from there.
+ *
+ * Jumping straight from the loop end to the loop start would click, so at every wrap
+ * a few milliseconds past the loop end are read into a preallocated buffer and faded
+ * out under the start of the loop as it fades in. Streamed tracks play the loop start
+ * from their LoopStartCache, so the jump back does not empty their read-ahead buffer.
+ *
+ * The loop is set by the owner at the start of every block, after it has swapped in
+ * any newly loaded track; this class never swaps tracks itself. Everything here runs
+ * on the audio thread, apart from prepareToPlay() and releaseResources().
+ */
+class LoopingSource : public AudioSource
+{
+public:
+    /**
+     * Constructor for LoopingSource.
+     * @param _input The source that plays the active track.
+     */
+    LoopingSource(TrackHandoffSource& _input);
+
+    /**
+     * Destructor for LoopingSource.
+     */
+    ~LoopingSource() override;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Render the active track, wrapping around the loop whenever the playhead reaches its end.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Loop the track being rendered. Called on the audio thread before the block is rendered.
+     * @param startSeconds The loop start in the track, in seconds.
+     * @param endSeconds The loop end in the track, in seconds. Must be after the start.
+     */
+    void setLoop(double startSeconds, double endSeconds) noexcept;
+
+    /**
+     * Play straight on without looping. A crossfade in progress still finishes.
+     */
+    void clearLoop() noexcept;
+
+    /**
+     * Drop a crossfade in progress. Called on the audio thread when a new track is swapped in.
+     */
+    void reset() noexcept;
+
+    /**
+     * Length of the crossfade at every wrap.
+     */
+    static constexpr double crossfadeSeconds = 0.005;
+
+private:
+    /**
+     * Render part of a block from the input, fading in under the tail of the last wrap.
+     * @param info The part of the buffer to fill.
+     */
+    void renderFading(const AudioSourceChannelInfo& info);
+
+    /**
+     * Read the tail past the loop end and move the transport back to the loop start.
+     * @param transport The transport of the track being rendered.
+     * @param loopStart The loop start in output samples.
+     * @param loopLength The loop length in output samples.
+     */
+    void wrap(AudioTransportSource& transport, juce::int64 loopStart, juce::int64 loopLength);
+
+    TrackHandoffSource& input;
+
+    /**
+     * The loop in seconds, the end is not after the start when there is no loop.
+     */
+    double loopStartSeconds = 0.0;
+    double loopEndSeconds = 0.0;
+
+    /**
+     * Audio read past the loop end at the last wrap, and how far through it the crossfade is.
+     */
+    AudioBuffer<float> tail;
+    int fadeLength = 0;
+    int fadePosition = 0;
+
+    double sampleRate = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoopingSource)
+};
@@ -0,0 +1,224 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.cpp
+    Created: 26 Oct 2026 3:52:40pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "LoudnessAnalyser.h"
+
+namespace
+{
+    constexpr double stepSeconds = 0.1;
+    constexpr int stepsPerGatingBlock = 4;
+    constexpr double absoluteGateLufs = -70.0;
+    constexpr double relativeGateLu = 10.0;
+
+    double energyToLufs(double energy)
+    {
+        return -0.691 + 10.0 * std::log10(energy);
+    }
+
+    double sinc(double x)
+    {
+        return x == 0.0 ? 1.0 : std::sin(MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+    }
+}
+
+//==============================================================================
+// Transposed direct form II
+double LoudnessAnalyser::Biquad::process(double input) noexcept
+{
+    const double output = b0 * input + z1;
+    z1 = b1 * input - a1 * output + z2;
+    z2 = b2 * input - a2 * output;
+    return output;
+}
+
+LoudnessAnalyser::Biquad LoudnessAnalyser::makeShelfFilter(double sampleRate)
+{
+    const double frequency = 1681.974450955533;
+    const double gainDb = 3.999843853973347;
+    const double q = 0.7071752369554196;
+
+    const double k = std::tan(MathConstants<double>::pi * frequency / sampleRate);
+    const double highGain = std::pow(10.0, gainDb / 20.0);
+    const double bandGain = std::pow(highGain, 0.4996667741545416);
+    const double a0 = 1.0 + k / q + k * k;
+
+    Biquad filter;
+    filter.b0 = (highGain + bandGain * k / q + k * k) / a0;
+    filter.b1 = 2.0 * (k * k - highGain) / a0;
+    filter.b2 = (highGain - bandGain * k / q + k * k) / a0;
+    filter.a1 = 2.0 * (k * k - 1.0) / a0;
+    filter.a2 = (1.0 - k / q + k * k) / a0;
+    return filter;
+}
+
+LoudnessAnalyser::Biquad LoudnessAnalyser::makeHighPassFilter(double sampleRate)
+{
+    const double frequency = 38.13547087602444;
+    const double q = 0.5003270373238773;
+
+    const double k = std::tan(MathConstants<double>::pi * frequency / sampleRate);
+    const double a0 = 1.0 + k / q + k * k;
+
+    Biquad filter;
+    filter.b0 = 1.0;
+    filter.b1 = -2.0;
+    filter.b2 = 1.0;
+    filter.a1 = 2.0 * (k * k - 1.0) / a0;
+    filter.a2 = (1.0 - k / q + k * k) / a0;
+    return filter;
+}
+
+//==============================================================================
+LoudnessAnalyser::TruePeakMeter::TruePeakMeter()
+    : history((size_t) (historyLength + chunkSize), 0.0f),
+      phaseOutput((size_t) chunkSize)
+{
+    // Lanczos-windowed sinc at the three positions between two samples, normalised to unity gain
+    for (int phase = 1; phase < oversampling; ++phase)
+    {
+        double sum = 0.0;
+
+        for (int tap = 0; tap < tapsPerPhase; ++tap)
+        {
+            const double x = (tap - historyLength / 2) - static_cast<double>(phase) / oversampling;
+            const double window = (double) tapsPerPhase / 2.0;
+            const double coefficient = sinc(x) * sinc(x / window);
+            coefficients[phase - 1][tap] = static_cast<float>(coefficient);
+            sum += coefficient;
+        }
+
+        for (float& coefficient : coefficients[phase - 1])
+            coefficient = static_cast<float>(coefficient / sum);
+    }
+}
+
+void LoudnessAnalyser::TruePeakMeter::process(const float* samples, int numSamples)
+{
+    // The samples themselves are the first phase
+    updatePeak(samples, numSamples);
+
+    for (int offset = 0; offset < numSamples; offset += chunkSize)
+    {
+        const int numInChunk = jmin(chunkSize, numSamples - offset);
+        std::copy(samples + offset, samples + offset + numInChunk, history.begin() + historyLength);
+        float* output = phaseOutput.data();
+
+        for (const auto& phase : coefficients)
+        {
+            FloatVectorOperations::clear(output, numInChunk);
+
+            for (int tap = 0; tap < tapsPerPhase; ++tap)
+                FloatVectorOperations::addWithMultiply(output, history.data() + tap, phase[tap], numInChunk);
+
+            updatePeak(output, numInChunk);
+        }
+
+        std::copy(history.begin() + numInChunk, history.begin() + numInChunk + historyLength, history.begin());
+    }
+}
+
+void LoudnessAnalyser::TruePeakMeter::updatePeak(const float* samples, int numSamples)
+{
+    const auto range = FloatVectorOperations::findMinAndMax(samples, numSamples);
+    peak = jmax(peak, -range.getStart(), range.getEnd());
+}
+
+//==============================================================================
+LoudnessAnalyser::LoudnessAnalyser(double sampleRate, juce::int64 lengthInSamples)
+    : shelfFilters{ makeShelfFilter(sampleRate), makeShelfFilter(sampleRate) },
+      highPassFilters{ makeHighPassFilter(sampleRate), makeHighPassFilter(sampleRate) },
+      stepLength(jmax(1, roundToInt(sampleRate * stepSeconds)))
+{
+    stepEnergies.reserve(static_cast<size_t>(lengthInSamples / stepLength) + 1);
+}
+
+LoudnessAnalyser::~LoudnessAnalyser()
+{
+}
+
+void LoudnessAnalyser::process(const float* left, const float* right, int numSamples)
+{
+    peakMeters[0].process(left, numSamples);
+    peakMeters[1].process(right, numSamples);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double weightedLeft = highPassFilters[0].process(shelfFilters[0].process(left[i]));
+        const double weightedRight = highPassFilters[1].process(shelfFilters[1].process(right[i]));
+        stepEnergy += weightedLeft * weightedLeft + weightedRight * weightedRight;
+
+        if (++samplesInStep == stepLength)
+        {
+            stepEnergies.push_back(stepEnergy / stepLength);
+            stepEnergy = 0.0;
+            samplesInStep = 0;
+        }
+    }
+}
+
+LoudnessAnalyser::Result LoudnessAnalyser::getResult() const
+{
+    Result result;
+
+    // Gating blocks are 400 ms long and start every 100 ms
+    if (stepEnergies.size() < (size_t) stepsPerGatingBlock)
+        return result;
+
+    auto gatedMean = [this](double gateLufs)
+    {
+        double sum = 0.0;
+        int count = 0;
+
+        for (size_t step = stepsPerGatingBlock - 1; step < stepEnergies.size(); ++step)
+        {
+            double blockEnergy = 0.0;
+
+            for (int i = 0; i < stepsPerGatingBlock; ++i)
+                blockEnergy += stepEnergies[step - (size_t) i];
+
+            blockEnergy /= stepsPerGatingBlock;
+
+            if (blockEnergy > 0.0 && energyToLufs(blockEnergy) > gateLufs)
+            {
+                sum += blockEnergy;
+                ++count;
+            }
+        }
+
+        return count > 0 ? sum / count : 0.0;
+    };
+
+    // Silence is left out first, then everything 10 LU below the loudness of what remains
+    const double ungatedEnergy = gatedMean(absoluteGateLufs);
+
+    if (ungatedEnergy <= 0.0)
+        return result;
+
+    const double relativeGate = jmax(absoluteGateLufs, energyToLufs(ungatedEnergy) - relativeGateLu);
+    const double gatedEnergy = gatedMean(relativeGate);
+
+    if (gatedEnergy <= 0.0)
+        return result;
+
+    result.IntegratedLufs = energyToLufs(gatedEnergy);
+    result.TruePeakDb = Decibels::gainToDecibels(jmax(peakMeters[0].getPeak(), peakMeters[1].getPeak()), -200.0f);
+    result.WasAnalysed = true;
+    return result;
+}
+
+float LoudnessAnalyser::getTrimGain(double integratedLufs, double truePeakDb)
+{
+    double trimDb = targetLufs - integratedLufs;
+
+    // Lowering a track never clips, raising it stops where its true peak reaches the ceiling
+    trimDb = jmin(trimDb, jmax(0.0, peakCeilingDb - truePeakDb));
+
+    return Decibels::decibelsToGain(static_cast<float>(jlimit(-maximumTrimDb, maximumTrimDb, trimDb)));
+}
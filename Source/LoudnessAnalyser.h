@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    LoudnessAnalyser.h
+    Created: 26 Oct 2026 3:52:40pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+/**
+ * The LoudnessAnalyser class measures the loudness of a track from its samples,
+ * as defined by EBU R128 and ITU-R BS.1770.
+ *
+ * The ContentAnalyser decodes a track once and hands every stereo block to this
+ * class, together with the beat and key analysers. The integrated loudness is the
+ * gated mean energy of the K-weighted signal over 400 ms blocks, and the true peak
+ * is the highest sample of the signal upsampled four times. Only one energy value
+ * per 100 ms is kept, so memory stays small whatever the track length.
+ *
+ * The trim gain computed from a result brings every track to the same loudness,
+ * so the decks can be mixed without riding the volume.
+ */
+class LoudnessAnalyser
+{
+public:
+    /**
+     * The loudness of a single track.
+     */
+    struct Result
+    {
+        double IntegratedLufs = 0.0;
+        double TruePeakDb = 0.0;
+        bool WasAnalysed = false;
+    };
+
+    /**
+     * Constructor for LoudnessAnalyser.
+     *
+     * @param sampleRate      The sample rate of the track.
+     * @param lengthInSamples The length of the track, used to size the step energies up front.
+     */
+    LoudnessAnalyser(double sampleRate, juce::int64 lengthInSamples);
+
+    /**
+     * Destructor for LoudnessAnalyser.
+     */
+    ~LoudnessAnalyser();
+
+    /**
+     * Add the next block of the track. A mono track is passed as the same samples on both sides,
+     * as the decks play it on both speakers.
+     *
+     * @param left       The left channel of the block.
+     * @param right      The right channel of the block.
+     * @param numSamples The number of samples in the block.
+     */
+    void process(const float* left, const float* right, int numSamples);
+
+    /**
+     * Find the loudness of everything processed so far.
+     *
+     * @return The integrated loudness and true peak, WasAnalysed is false if the
+     *         track is shorter than one gating block or silent.
+     */
+    Result getResult() const;
+
+    /**
+     * Get the gain that brings a track to the target loudness. Quiet tracks are only
+     * raised as far as their true peak allows, so the trim never makes a track clip.
+     *
+     * @param integratedLufs The integrated loudness of the track.
+     * @param truePeakDb     The true peak of the track.
+     * @return               The linear gain to apply before the deck's volume.
+     */
+    static float getTrimGain(double integratedLufs, double truePeakDb);
+
+    /**
+     * The loudness every track is trimmed to, the highest true peak a trim may
+     * raise a track to, and the largest trim in either direction.
+     */
+    static constexpr double targetLufs = -12.0;
+    static constexpr double peakCeilingDb = -1.0;
+    static constexpr double maximumTrimDb = 12.0;
+
+private:
+    /**
+     * One second-order section, in double so the 38 Hz high-pass stays stable at any sample rate.
+     */
+    struct Biquad
+    {
+        double process(double input) noexcept;
+
+        double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+        double z1 = 0.0, z2 = 0.0;
+    };
+
+    /**
+     * The two stages of the K-weighting, redesigned for the sample rate: the high shelf
+     * modelling the head, and the RLB high-pass.
+     */
+    static Biquad makeShelfFilter(double sampleRate);
+    static Biquad makeHighPassFilter(double sampleRate);
+
+    /**
+     * Highest absolute value of one channel upsampled four times. Each interpolated phase
+     * is a 12-tap filter run over a chunk of samples as vector multiply-adds.
+     */
+    class TruePeakMeter
+    {
+    public:
+        TruePeakMeter();
+
+        void process(const float* samples, int numSamples);
+
+        float getPeak() const noexcept { return peak; }
+
+        static constexpr int tapsPerPhase = 12;
+        static constexpr int historyLength = tapsPerPhase - 1;
+        static constexpr int oversampling = 4;
+        static constexpr int chunkSize = 4096;
+
+    private:
+        void updatePeak(const float* samples, int numSamples);
+
+        float coefficients[oversampling - 1][tapsPerPhase] = {};
+        std::vector<float> history;
+        std::vector<float> phaseOutput;
+        float peak = 0.0f;
+    };
+
+    /**
+     * The K-weighting filters and true peak meter of each channel.
+     */
+    Biquad shelfFilters[2];
+    Biquad highPassFilters[2];
+    TruePeakMeter peakMeters[2];
+
+    /**
+     * The summed channel energy of every 100 ms step, and of the step being filled.
+     */
+    std::vector<double> stepEnergies;
+    int stepLength = 1;
+    double stepEnergy = 0.0;
+    int samplesInStep = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LoudnessAnalyser)
+};
@@ -1,94 +1,158 @@
-#include <JuceHeader.h>
-#include "MainComponent.h"
-
-//==============================================================================
-class OtoDecksApplication  : public JUCEApplication
-{
-public:
-    //==============================================================================
-    OtoDecksApplication() {}
-    const String getApplicationName() override       { return ProjectInfo::projectName; }
-    const String getApplicationVersion() override    { return ProjectInfo::versionString; }
-    bool moreThanOneInstanceAllowed() override       { return true; }
-
-    //==============================================================================
-    void initialise (const String& commandLine) override
-    {
-        // This method is where you should put your application's initialisation code..
-
-        mainWindow.reset (new MainWindow (getApplicationName()));
-    }
-
-    void shutdown() override
-    {
-        // Add your application's shutdown code here..
-        mainWindow = nullptr; // (deletes our window)
-    }
-
-    //==============================================================================
-    void systemRequestedQuit() override
-    {
-        // This is called when the app is being asked to quit: you can ignore this
-        // request and let the app carry on running, or call quit() to allow the app to close.
-        quit();
-    }
-
-    void anotherInstanceStarted (const String& commandLine) override
-    {
-        // When another instance of the app is launched while this one is running,
-        // this method is invoked, and the commandLine parameter tells you what
-        // the other instance's command-line arguments were.
-    }
-
-    //==============================================================================
-    /*
-        This class implements the desktop window that contains an instance of
-        our MainComponent class.
-    */
-    class MainWindow    : public DocumentWindow
-    {
-    public:
-        MainWindow (String name)  : DocumentWindow (name,
-                                                    Desktop::getInstance().getDefaultLookAndFeel()
-                                                                          .findColour (ResizableWindow::backgroundColourId),
-                                                    DocumentWindow::allButtons)
-        {
-            setUsingNativeTitleBar (true);
-            setContentOwned (new MainComponent(), true);
-
-           #if JUCE_IOS || JUCE_ANDROID
-            setFullScreen (true);
-           #else
-            setResizable (true, true);
-            centreWithSize (getWidth(), getHeight());
-           #endif
-
-            setVisible (true);
-        }
-
-        void closeButtonPressed() override
-        {
-            // This is called when the user tries to close this window. Here, we'll just
-            // ask the app to quit when this happens, but you can change this to do
-            // whatever you need.
-            JUCEApplication::getInstance()->systemRequestedQuit();
-        }
-
-        /* Note: Be careful if you override any DocumentWindow methods - the base
-           class uses a lot of them, so by overriding you might break its functionality.
-           It's best to do all your work in your content component instead, but if
-           you really have to override any DocumentWindow methods, make sure your
-           subclass also calls the superclass's method.
-        */
-
-    private:
-        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainWindow)
-    };
-
-private:
-    std::unique_ptr<MainWindow> mainWindow;
-};
-
-//==============================================================================
-// This macro generates the main() routine that launches the app.
-START_JUCE_APPLICATION (OtoDecksApplication)
+#include <JuceHeader.h>
+#include "MainComponent.h"
+#include "Benchmarks.h"
+#include "MixRenderer.h"
+
+//==============================================================================
+class OtoDecksApplication  : public JUCEApplication
+{
+public:
+    //==============================================================================
+    OtoDecksApplication() {}
+    const String getApplicationName() override       { return ProjectInfo::projectName; }
+    const String getApplicationVersion() override    { return ProjectInfo::versionString; }
+    bool moreThanOneInstanceAllowed() override       { return true; }
+
+    //==============================================================================
+    void initialise (const String& commandLine) override
+    {
+        // This method is where you should put your application's initialisation code..
+
+        // Headless benchmark mode: print the results and exit without opening a window.
+        // With --json the results are written as JSON instead, to a file if one follows.
+        if (commandLine.contains("--benchmark"))
+        {
+            Benchmarks::Metrics metrics;
+            const String report = Benchmarks::runAll(metrics);
+            StringArray arguments = StringArray::fromTokens(commandLine, true);
+            const int jsonIndex = arguments.indexOf("--json");
+
+            if (jsonIndex < 0)
+            {
+                std::cout << report << std::endl;
+            }
+            else if (jsonIndex + 1 < arguments.size() && !arguments[jsonIndex + 1].startsWith("--"))
+            {
+                const File jsonFile = File::getCurrentWorkingDirectory().getChildFile(arguments[jsonIndex + 1].unquoted());
+
+                if (!jsonFile.replaceWithText(Benchmarks::toJson(metrics)))
+                {
+                    std::cout << "Could not write " << jsonFile.getFullPathName() << std::endl;
+                    setApplicationReturnValue(1);
+                }
+            }
+            else
+            {
+                std::cout << Benchmarks::toJson(metrics) << std::endl;
+            }
+
+            quit();
+            return;
+        }
+
+        // Headless render mode: --render <timeline.json> <output.wav|output.flac>
+        if (commandLine.contains("--render"))
+        {
+            StringArray arguments = StringArray::fromTokens(commandLine, true);
+            const int index = arguments.indexOf("--render");
+            const File workingDirectory = File::getCurrentWorkingDirectory();
+
+            // Scripts see a failed render through the exit code
+            if (arguments.size() < index + 3)
+            {
+                std::cout << "Usage: --render <timeline.json> <output.wav|output.flac>" << std::endl;
+                setApplicationReturnValue(1);
+            }
+            else
+            {
+                String message;
+
+                if (!MixRenderer::renderFromCommandLine(workingDirectory.getChildFile(arguments[index + 1].unquoted()),
+                                                        workingDirectory.getChildFile(arguments[index + 2].unquoted()), message))
+                {
+                    setApplicationReturnValue(1);
+                }
+
+                std::cout << message << std::endl;
+            }
+
+            quit();
+            return;
+        }
+
+        mainWindow.reset (new MainWindow (getApplicationName()));
+    }
+
+    void shutdown() override
+    {
+        // Add your application's shutdown code here..
+        mainWindow = nullptr; // (deletes our window)
+    }
+
+    //==============================================================================
+    void systemRequestedQuit() override
+    {
+        // This is called when the app is being asked to quit: you can ignore this
+        // request and let the app carry on running, or call quit() to allow the app to close.
+        quit();
+    }
+
+    void anotherInstanceStarted (const String& commandLine) override
+    {
+        // When another instance of the app is launched while this one is running,
+        // this method is invoked, and the commandLine parameter tells you what
+        // the other instance's command-line arguments were.
+    }
+
+    //==============================================================================
+    /*
+        This class implements the desktop window that contains an instance of
+        our MainComponent class.
+    */
+    class MainWindow    : public DocumentWindow
+    {
+    public:
+        MainWindow (String name)  : DocumentWindow (name,
+                                                    Desktop::getInstance().getDefaultLookAndFeel()
+                                                                          .findColour (ResizableWindow::backgroundColourId),
+                                                    DocumentWindow::allButtons)
+        {
+            setUsingNativeTitleBar (true);
+            setContentOwned (new MainComponent(), true);
+
+           #if JUCE_IOS || JUCE_ANDROID
+            setFullScreen (true);
+           #else
+            setResizable (true, true);
+            centreWithSize (getWidth(), getHeight());
+           #endif
+
+            setVisible (true);
+        }
+
+        void closeButtonPressed() override
+        {
+            // This is called when the user tries to close this window. Here, we'll just
+            // ask the app to quit when this happens, but you can change this to do
+            // whatever you need.
+            JUCEApplication::getInstance()->systemRequestedQuit();
+        }
+
+        /* Note: Be careful if you override any DocumentWindow methods - the base
+           class uses a lot of them, so by overriding you might break its functionality.
+           It's best to do all your work in your content component instead, but if
+           you really have to override any DocumentWindow methods, make sure your
+           subclass also calls the superclass's method.
+        */
+
+    private:
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainWindow)
+    };
+
+private:
+    std::unique_ptr<MainWindow> mainWindow;
+};
+
+//==============================================================================
+// This macro generates the main() routine that launches the app.
+START_JUCE_APPLICATION (OtoDecksApplication)
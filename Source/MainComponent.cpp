@@ -1,116 +1,160 @@
-#include "MainComponent.h"
-
-//==============================================================================
-MainComponent::MainComponent()
-{
-    // Make sure you set the size of the component after
-    // you add any child components.
-    setSize (800, 600);
-
-    // Some platforms require permissions to open input channels so request that here
-    if (RuntimePermissions::isRequired (RuntimePermissions::recordAudio)
-        && ! RuntimePermissions::isGranted (RuntimePermissions::recordAudio))
-    {
-        RuntimePermissions::request (RuntimePermissions::recordAudio,
-                                     [&] (bool granted) { if (granted)  setAudioChannels (2, 2); });
-    }  
-    else
-    {
-        // Specify the number of input and output channels that we want to open
-        setAudioChannels (0, 2);
-    }
-    addAndMakeVisible(deckGUI1);
-    addAndMakeVisible(deckGUI2);
-    addAndMakeVisible(playlistComponent);
-
-    //formatManager.registerBasicFormats();
-
-    // Add and initialize the slider
-    setupCrossFadeSlider();
-}
-
-MainComponent::~MainComponent()
-{
-    // This shuts down the audio device and clears the audio source.
-    shutdownAudio();
-}
-
-//==============================================================================
-void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
-{
-
-    // ************
-    mixerSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
-    // ************
-    mixerSource.addInputSource(&player1, false);
-    mixerSource.addInputSource(&player2, false);
-}
-
-void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
-{
-    mixerSource.getNextAudioBlock(bufferToFill);
-}
-
-void MainComponent::releaseResources()
-{
-    // This will be called when the audio device stops, or when it is being
-    // restarted due to a setting change.
-    player1.releaseResources();
-    player2.releaseResources();
-    mixerSource.releaseResources();
-    // Clear memory when stopped
-    mixerSource.removeAllInputs();
-}
-
-//==============================================================================
-void MainComponent::paint (Graphics& g)
-{
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
-
-    // You can add your drawing code here!
-}
-
-void MainComponent::resized()
-{
-    float height = getHeight() * 0.5;
-    float width = getWidth() * 0.5;
-    float height2 = getHeight() * 0.1;
-    // This is called when the MainContentComponent is resized.
-    // If you add any child components, this is where you should
-    // update their positions.
-    deckGUI1.setBounds(0, 0, width, height);
-    deckGUI2.setBounds(width, 0, width, height);
-    playlistComponent.setBounds(0, height2 * 5.5, getWidth(), height2 * 9);
-
-    // Set the bounds of the crossFadeSlider
-    crossFadeSlider.setBounds(getWidth() * 0.1, height2 * 5, getWidth() * 0.8, height2*0.5);
-}
-
-// Setting the crossfader
-void MainComponent::setupCrossFadeSlider()
-{
-    addAndMakeVisible(crossFadeSlider);
-    crossFadeSlider.setSliderStyle(Slider::LinearHorizontal);
-    crossFadeSlider.setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
-    crossFadeSlider.setRange(0.0, 1.0, 0.01); // Range from 0 to 1 with a step of 0.01
-    crossFadeSlider.setValue(0.5); // Set initial value to center position
-    crossFadeSlider.setDoubleClickReturnValue(true, 0.5);
-    crossFadeSlider.setColour(Slider::trackColourId, juce::Colours::orange);
-    crossFadeSlider.setColour(Slider::backgroundColourId, juce::Colours::deepskyblue);
-    crossFadeSlider.addListener(this);
-}
-
-// Handling slider value changes
-void MainComponent::sliderValueChanged(Slider* slider)
-{
-    DBG("Slider Value: " << slider->getValue());
-
-    // Adjust volume levels based on slider position
-    float sliderValue = slider->getValue();
-    double gain1 = 1.0 - sliderValue; // Gain for deck 1
-    double gain2 = sliderValue;       // Gain for deck 2
-
-    player1.setGain(gain1);
-    player2.setGain(gain2);
+#include "MainComponent.h"
+
+//==============================================================================
+MainComponent::MainComponent()
+{
+    // Make sure you set the size of the component after
+    // you add any child components.
+    setSize (800, 600);
+
+    // The mixer channels must exist before the audio device starts calling back
+    mixer.addChannel(&player1, DeckMixer::Assignment::a);
+    mixer.addChannel(&player2, DeckMixer::Assignment::b);
+
+    // Both decks render on the audio thread in lockstep, so they can share one master clock
+    player1.setSyncClock(&syncClock, 1);
+    player2.setSyncClock(&syncClock, 2);
+
+    // Profiler stages and counters must also be registered before the first callback
+    mixer.setProfiler(&profiler, profiler.addStage("mix"));
+    player1.setProfiler(&profiler, profiler.addStage("deck 1 read"), profiler.addStage("deck 1 resample"));
+    player2.setProfiler(&profiler, profiler.addStage("deck 2 read"), profiler.addStage("deck 2 resample"));
+    profiler.addCounter("deck 1 read-ahead underruns", [this] { return (juce::int64) player1.getUnderrunCount(); });
+    profiler.addCounter("deck 2 read-ahead underruns", [this] { return (juce::int64) player2.getUnderrunCount(); });
+    profiler.addCounter("device xruns", [this] { return (juce::int64) jmax(0, deviceManager.getXRunCount()); });
+
+    // Some platforms require permissions to open input channels so request that here
+    if (RuntimePermissions::isRequired (RuntimePermissions::recordAudio)
+        && ! RuntimePermissions::isGranted (RuntimePermissions::recordAudio))
+    {
+        RuntimePermissions::request (RuntimePermissions::recordAudio,
+                                     [&] (bool granted) { if (granted)  setAudioChannels (2, 2); });
+    }  
+    else
+    {
+        // Specify the number of input and output channels that we want to open
+        setAudioChannels (0, 2);
+    }
+    addAndMakeVisible(deckGUI1);
+    addAndMakeVisible(deckGUI2);
+    addAndMakeVisible(playlistComponent);
+
+    //formatManager.registerBasicFormats();
+
+    // Add and initialize the slider
+    setupCrossFadeSlider();
+
+    // The profiler overlay sits above everything and starts hidden
+    addChildComponent(profilerOverlay);
+    setWantsKeyboardFocus(true);
+}
+
+MainComponent::~MainComponent()
+{
+    // This shuts down the audio device and clears the audio source.
+    shutdownAudio();
+}
+
+//==============================================================================
+void MainComponent::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
+{
+    // The mixer prepares both players
+    deviceSampleRate = sampleRate;
+    mixer.prepareToPlay(samplesPerBlockExpected, sampleRate);
+}
+
+void MainComponent::getNextAudioBlock (const AudioSourceChannelInfo& bufferToFill)
+{
+    const juce::int64 start = CallbackProfiler::getTicks();
+
+    mixer.getNextAudioBlock(bufferToFill);
+
+    profiler.recordCallback(CallbackProfiler::getTicks() - start, bufferToFill.numSamples, deviceSampleRate);
+}
+
+void MainComponent::releaseResources()
+{
+    // This will be called when the audio device stops, or when it is being
+    // restarted due to a setting change.
+    // The mixer releases both players
+    mixer.releaseResources();
+}
+
+//==============================================================================
+void MainComponent::paint (Graphics& g)
+{
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll (getLookAndFeel().findColour (ResizableWindow::backgroundColourId));
+
+    // You can add your drawing code here!
+}
+
+void MainComponent::resized()
+{
+    float height = getHeight() * 0.5;
+    float width = getWidth() * 0.5;
+    float height2 = getHeight() * 0.1;
+    // This is called when the MainContentComponent is resized.
+    // If you add any child components, this is where you should
+    // update their positions.
+    deckGUI1.setBounds(0, 0, width, height);
+    deckGUI2.setBounds(width, 0, width, height);
+    playlistComponent.setBounds(0, height2 * 5.5, getWidth(), height2 * 9);
+
+    // Set the bounds of the crossFadeSlider
+    crossFadeSlider.setBounds(getWidth() * 0.1, height2 * 5, getWidth() * 0.8, height2*0.5);
+    crossFadeCurveBox.setBounds(getWidth() * 0.9, height2 * 5.05, getWidth() * 0.09, height2 * 0.4);
+
+    profilerOverlay.setBounds(getLocalBounds().withSizeKeepingCentre(jmin(getWidth() - 20, 560), jmin(getHeight() - 20, 240)));
+}
+
+bool MainComponent::keyPressed(const KeyPress& key)
+{
+    if (key == KeyPress('p', ModifierKeys::commandModifier, 0))
+    {
+        profilerOverlay.setVisible(!profilerOverlay.isVisible());
+        profilerOverlay.toFront(false);
+        return true;
+    }
+
+    return false;
+}
+
+// Setting the crossfader
+void MainComponent::setupCrossFadeSlider()
+{
+    addAndMakeVisible(crossFadeSlider);
+    crossFadeSlider.setSliderStyle(Slider::LinearHorizontal);
+    crossFadeSlider.setTextBoxStyle(Slider::NoTextBox, false, 0, 0);
+    crossFadeSlider.setRange(0.0, 1.0, 0.01); // Range from 0 to 1 with a step of 0.01
+    crossFadeSlider.setValue(0.5); // Set initial value to center position
+    crossFadeSlider.setDoubleClickReturnValue(true, 0.5);
+    crossFadeSlider.setColour(Slider::trackColourId, juce::Colours::orange);
+    crossFadeSlider.setColour(Slider::backgroundColourId, juce::Colours::deepskyblue);
+    crossFadeSlider.addListener(this);
+
+    addAndMakeVisible(crossFadeCurveBox);
+    crossFadeCurveBox.addItem("Linear", static_cast<int>(DeckMixer::CrossfaderCurve::linear) + 1);
+    crossFadeCurveBox.addItem("Power", static_cast<int>(DeckMixer::CrossfaderCurve::constantPower) + 1);
+    crossFadeCurveBox.addItem("Cut", static_cast<int>(DeckMixer::CrossfaderCurve::cut) + 1);
+    crossFadeCurveBox.setSelectedId(static_cast<int>(mixer.getCrossfaderCurve()) + 1, dontSendNotification);
+    crossFadeCurveBox.addListener(this);
+}
+
+// Handling slider value changes
+void MainComponent::sliderValueChanged(Slider* slider)
+{
+    DBG("Slider Value: " << slider->getValue());
+
+    // The crossfader is applied in the mixer, so it no longer overrides the deck volumes
+    mixer.setCrossfaderPosition(static_cast<float>(slider->getValue()));
+}
+
+// Handling crossfader curve changes
+void MainComponent::comboBoxChanged(ComboBox* comboBox)
+{
+    if (comboBox == &crossFadeCurveBox)
+    {
+        mixer.setCrossfaderCurve(static_cast<DeckMixer::CrossfaderCurve>(comboBox->getSelectedId() - 1));
+    }
 }
\ No newline at end of file
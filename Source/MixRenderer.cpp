@@ -0,0 +1,418 @@
+/*
+  ==============================================================================
+
+    MixRenderer.cpp
+    Created: 24 Oct 2026 9:12:38am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "MixRenderer.h"
+#include "DJAudioPlayer.h"
+#include "DeckMixer.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Renders a deck ahead of the mixer into a buffer, so both decks can render on
+ * separate threads before the mixer pulls the results one after the other.
+ */
+class MixRenderer::DeckBuffer : public AudioSource
+{
+public:
+    explicit DeckBuffer(AudioSource& _deck) : deck(_deck) {}
+
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override
+    {
+        deck.prepareToPlay(samplesPerBlockExpected, sampleRate);
+        buffer.setSize(2, samplesPerBlockExpected);
+    }
+
+    void releaseResources() override
+    {
+        deck.releaseResources();
+    }
+
+    /**
+     * Render the next block of the deck. Called before the mixer asks for it.
+     */
+    void render(int numSamples)
+    {
+        AudioSourceChannelInfo info(&buffer, 0, numSamples);
+        deck.getNextAudioBlock(info);
+        numRendered = numSamples;
+        readPosition = 0;
+    }
+
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override
+    {
+        const int numSamples = jmin(bufferToFill.numSamples, numRendered - readPosition);
+
+        for (int channel = 0; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+        {
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample, buffer, channel % 2, readPosition, numSamples);
+        }
+
+        // The mixer never asks for more than was rendered, but stay silent rather than repeat if it does
+        if (numSamples < bufferToFill.numSamples)
+            bufferToFill.buffer->clear(bufferToFill.startSample + numSamples, bufferToFill.numSamples - numSamples);
+
+        readPosition += numSamples;
+    }
+
+private:
+    AudioSource& deck;
+    AudioBuffer<float> buffer;
+    int numRendered = 0;
+    int readPosition = 0;
+};
+
+double MixRenderer::Report::getRealtimeFactor() const
+{
+    return renderSeconds > 0.0 ? renderedSeconds / renderSeconds : 0.0;
+}
+
+juce::String MixRenderer::Report::toString() const
+{
+    return "Rendered " + juce::String(renderedSeconds, 1) + " s in " + juce::String(renderSeconds, 2)
+         + " s (" + juce::String(getRealtimeFactor(), 1) + "x realtime), tracks decoded in "
+         + juce::String(decodeSeconds, 2) + " s";
+}
+
+MixRenderer::MixRenderer(AudioFormatManager& _formatManager) :
+    formatManager(_formatManager)
+{
+}
+
+bool MixRenderer::parseTimeline(const juce::String& json, const juce::File& baseDirectory,
+    Timeline& timeline, juce::String& errorMessage)
+{
+    var parsed;
+    const juce::Result result = JSON::parse(json, parsed);
+
+    if (result.failed())
+    {
+        errorMessage = result.getErrorMessage();
+        return false;
+    }
+
+    timeline = Timeline{};
+    timeline.lengthInSeconds = parsed.getProperty("length", 0.0);
+
+    if (timeline.lengthInSeconds <= 0.0)
+    {
+        errorMessage = "The timeline needs a length in seconds";
+        return false;
+    }
+
+    const Array<var>* events = parsed.getProperty("events", var()).getArray();
+
+    if (events == nullptr)
+    {
+        errorMessage = "The timeline has no events array";
+        return false;
+    }
+
+    const struct { const char* name; Event::Type type; } actions[] = {
+        { "load",            Event::Type::load },
+        { "play",            Event::Type::play },
+        { "pause",           Event::Type::pause },
+        { "position",        Event::Type::position },
+        { "gain",            Event::Type::gain },
+        { "speed",           Event::Type::speed },
+        { "keyLock",         Event::Type::keyLock },
+        { "crossfader",      Event::Type::crossfader },
+        { "crossfaderCurve", Event::Type::crossfaderCurve }
+    };
+    const char* curves[] = { "linear", "constantPower", "cut" };
+
+    for (int i = 0; i < events->size(); ++i)
+    {
+        const var& entry = events->getReference(i);
+        const juce::String action = entry.getProperty("action", "").toString();
+
+        auto found = std::find_if(std::begin(actions), std::end(actions),
+            [&action](const auto& candidate) { return action == candidate.name; });
+
+        if (found == std::end(actions))
+        {
+            errorMessage = "Event " + juce::String(i) + " has an unknown action \"" + action + "\"";
+            return false;
+        }
+
+        Event event;
+        event.type = found->type;
+        event.timeInSeconds = entry.getProperty("time", 0.0);
+        event.deck = entry.getProperty("deck", 1);
+
+        if (event.deck != 1 && event.deck != 2)
+        {
+            errorMessage = "Event " + juce::String(i) + " names deck " + juce::String(event.deck) + ", expected 1 or 2";
+            return false;
+        }
+
+        if (event.type == Event::Type::load)
+        {
+            // Plain paths are relative to the timeline so a timeline and its tracks can be moved together
+            const juce::String location = entry.getProperty("url", "").toString();
+            event.url = location.contains("://") ? juce::URL{ location } : juce::URL{ baseDirectory.getChildFile(location) };
+        }
+        else if (event.type == Event::Type::crossfaderCurve)
+        {
+            const juce::String curve = entry.getProperty("value", "").toString();
+            auto curveIndex = std::find_if(std::begin(curves), std::end(curves),
+                [&curve](const char* name) { return curve == name; });
+
+            if (curveIndex == std::end(curves))
+            {
+                errorMessage = "Event " + juce::String(i) + " has an unknown crossfader curve \"" + curve + "\"";
+                return false;
+            }
+
+            event.value = static_cast<double>(curveIndex - std::begin(curves));
+        }
+        else if (event.type == Event::Type::keyLock)
+        {
+            event.value = static_cast<bool>(entry.getProperty("value", false)) ? 1.0 : 0.0;
+        }
+        else
+        {
+            event.value = entry.getProperty("value", 0.0);
+        }
+
+        timeline.events.push_back(event);
+    }
+
+    // Stable, so events at the same time keep the order they were recorded in
+    std::stable_sort(timeline.events.begin(), timeline.events.end(),
+        [](const Event& a, const Event& b) { return a.timeInSeconds < b.timeInSeconds; });
+
+    return true;
+}
+
+bool MixRenderer::decodeTracks(const Timeline& timeline, SampleCache& cache, juce::String& errorMessage)
+{
+    ThreadPool decodePool{ jmax(1, SystemStats::getNumCpus()) };
+    CriticalSection failedLock;
+    StringArray failed;
+    StringArray queued;
+
+    for (const auto& event : timeline.events)
+    {
+        if (event.type != Event::Type::load || queued.contains(event.url.toString(false)))
+            continue;
+
+        queued.add(event.url.toString(false));
+
+        decodePool.addJob([&cache, &failedLock, &failed, url = event.url]
+            {
+                if (cache.getOrDecode(url) == nullptr)
+                {
+                    const ScopedLock sl(failedLock);
+                    failed.add(url.toString(false));
+                }
+            });
+    }
+
+    // The pool would abandon queued jobs when it is destroyed, so wait for all of them
+    while (decodePool.getNumJobs() > 0)
+        Thread::sleep(5);
+
+    if (!failed.isEmpty())
+    {
+        errorMessage = "Could not decode " + failed.joinIntoString(", ") + " into RAM";
+        return false;
+    }
+
+    return true;
+}
+
+bool MixRenderer::render(const Timeline& timeline, const juce::File& outputFile, const Settings& settings, Report& report)
+{
+    report = Report{};
+    report.renderedSeconds = timeline.lengthInSeconds;
+
+    if (timeline.lengthInSeconds <= 0.0 || settings.sampleRate <= 0.0 || settings.blockSize <= 0)
+    {
+        report.errorMessage = "Nothing to render";
+        return false;
+    }
+
+    AudioFormat* format = formatManager.findFormatForFileExtension(outputFile.getFileExtension());
+
+    if (format == nullptr || !format->getPossibleBitDepths().contains(settings.bitsPerSample))
+    {
+        report.errorMessage = "Cannot write " + juce::String(settings.bitsPerSample) + "-bit " + outputFile.getFileExtension() + " files";
+        return false;
+    }
+
+    // Every track is resident before the first block, so no deck ever waits on the disk
+    SampleCache cache(formatManager, settings.memoryBudgetBytes);
+    const double decodeStart = Time::getMillisecondCounterHiRes();
+
+    if (!decodeTracks(timeline, cache, report.errorMessage))
+        return false;
+
+    report.decodeSeconds = (Time::getMillisecondCounterHiRes() - decodeStart) / 1000.0;
+
+    // The same graph as MainComponent, with each deck rendered ahead of the mixer
+    DJAudioPlayer player1{ formatManager, &cache };
+    DJAudioPlayer player2{ formatManager, &cache };
+    player1.setRamResident(true);
+    player2.setRamResident(true);
+
+    DeckBuffer deck1{ player1 };
+    DeckBuffer deck2{ player2 };
+
+    DeckMixer mixer;
+    mixer.addChannel(&deck1, DeckMixer::Assignment::a);
+    mixer.addChannel(&deck2, DeckMixer::Assignment::b);
+    mixer.prepareToPlay(settings.blockSize, settings.sampleRate);
+
+    outputFile.deleteFile();
+    std::unique_ptr<FileOutputStream> stream = outputFile.createOutputStream();
+
+    if (stream == nullptr)
+    {
+        report.errorMessage = "Cannot open " + outputFile.getFullPathName() + " for writing";
+        mixer.releaseResources();
+        return false;
+    }
+
+    std::unique_ptr<AudioFormatWriter> writer(format->createWriterFor(stream.get(), settings.sampleRate, 2,
+        settings.bitsPerSample, {}, 0));
+
+    if (writer == nullptr)
+    {
+        report.errorMessage = "Cannot create a writer for " + outputFile.getFullPathName();
+        mixer.releaseResources();
+        return false;
+    }
+
+    // The writer owns the stream from here on
+    stream.release();
+
+    // Encoding runs on its own thread while the next blocks render
+    TimeSliceThread writerThread{ "Mix Render Writer" };
+    writerThread.startThread();
+    auto threadedWriter = std::make_unique<AudioFormatWriter::ThreadedWriter>(writer.release(), writerThread, 1 << 18);
+
+    auto applyEvent = [&](const Event& event)
+    {
+        DJAudioPlayer& player = event.deck == 2 ? player2 : player1;
+
+        switch (event.type)
+        {
+            case Event::Type::load:            player.loadURL(event.url); break;
+            case Event::Type::play:            player.start(); break;
+            case Event::Type::pause:           player.pause(); break;
+            case Event::Type::position:        player.setPosition(event.value); break;
+            case Event::Type::gain:            player.setGain(event.value); break;
+            case Event::Type::speed:           player.setSpeed(event.value); break;
+            case Event::Type::keyLock:         player.setKeyLock(event.value != 0.0); break;
+            case Event::Type::crossfader:      mixer.setCrossfaderPosition(static_cast<float>(event.value)); break;
+            case Event::Type::crossfaderCurve: mixer.setCrossfaderCurve(static_cast<DeckMixer::CrossfaderCurve>(static_cast<int>(event.value))); break;
+        }
+    };
+
+    auto getEventSample = [&settings](const Event& event)
+    {
+        return static_cast<juce::int64>(std::llround(event.timeInSeconds * settings.sampleRate));
+    };
+
+    const auto totalSamples = static_cast<juce::int64>(std::llround(timeline.lengthInSeconds * settings.sampleRate));
+    AudioBuffer<float> mixBuffer(2, settings.blockSize);
+    ThreadPool deckPool{ 1 };
+    WaitableEvent deck2Rendered;
+    size_t nextEvent = 0;
+    juce::int64 position = 0;
+
+    const double renderStart = Time::getMillisecondCounterHiRes();
+
+    while (position < totalSamples)
+    {
+        // Events act at the start of the next block, and every block ends at the next event
+        while (nextEvent < timeline.events.size() && getEventSample(timeline.events[nextEvent]) <= position)
+            applyEvent(timeline.events[nextEvent++]);
+
+        juce::int64 blockEnd = jmin(position + settings.blockSize, totalSamples);
+
+        if (nextEvent < timeline.events.size())
+            blockEnd = jmin(blockEnd, getEventSample(timeline.events[nextEvent]));
+
+        const int numSamples = static_cast<int>(blockEnd - position);
+
+        // The decks do not depend on each other, only the mixer needs both
+        if (settings.renderDecksInParallel)
+        {
+            deckPool.addJob([&deck2, &deck2Rendered, numSamples]
+                {
+                    deck2.render(numSamples);
+                    deck2Rendered.signal();
+                });
+
+            deck1.render(numSamples);
+            deck2Rendered.wait();
+        }
+        else
+        {
+            deck1.render(numSamples);
+            deck2.render(numSamples);
+        }
+
+        AudioSourceChannelInfo info(&mixBuffer, 0, numSamples);
+        mixer.getNextAudioBlock(info);
+
+        // Only waits if the encoder has fallen a quarter of a million samples behind
+        while (!threadedWriter->write(mixBuffer.getArrayOfReadPointers(), numSamples))
+            Thread::sleep(1);
+
+        // There is no message loop to run the players' timers, so tracks replaced by a load are freed here
+        player1.collectRetiredTracks();
+        player2.collectRetiredTracks();
+
+        position = blockEnd;
+    }
+
+    // Deleting the threaded writer flushes what is still queued and closes the file
+    threadedWriter.reset();
+    report.renderSeconds = (Time::getMillisecondCounterHiRes() - renderStart) / 1000.0;
+
+    writerThread.stopThread(2000);
+    mixer.releaseResources();
+    return true;
+}
+
+bool MixRenderer::renderFromCommandLine(const juce::File& timelineFile, const juce::File& outputFile, juce::String& message)
+{
+    if (!timelineFile.existsAsFile())
+    {
+        message = "Cannot read the timeline " + timelineFile.getFullPathName();
+        return false;
+    }
+
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    Timeline timeline;
+    juce::String errorMessage;
+
+    if (!parseTimeline(timelineFile.loadFileAsString(), timelineFile.getParentDirectory(), timeline, errorMessage))
+    {
+        message = "Invalid timeline: " + errorMessage;
+        return false;
+    }
+
+    MixRenderer renderer(formatManager);
+    Report report;
+
+    if (!renderer.render(timeline, outputFile, Settings{}, report))
+    {
+        message = "Render failed: " + report.errorMessage;
+        return false;
+    }
+
+    message = report.toString() + " to " + outputFile.getFullPathName();
+    return true;
+}
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    MixRenderer.h
+    Created: 24 Oct 2026 9:12:38am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include "SampleCache.h"
+
+/**
+ * The MixRenderer class bounces a two-deck mix to an audio file without an audio device.
+ *
+ * It builds the same graph as MainComponent, two DJAudioPlayers on crossfader
+ * sides A and B of a DeckMixer, and drives it from a timeline of automation
+ * events instead of the GUI. Blocks are split at every event, so automation
+ * lands on the exact sample it was recorded at. Every track is decoded into RAM
+ * before rendering starts, so the output does not depend on disk or thread timing.
+ *
+ * The render runs as fast as the CPU allows. Tracks are decoded in parallel, the
+ * two decks render each block on separate threads before the mixer sums them,
+ * and the file is encoded on a background thread while the next blocks render.
+ */
+class MixRenderer
+{
+public:
+    /**
+     * One automation event on the timeline.
+     */
+    struct Event
+    {
+        enum class Type
+        {
+            load,
+            play,
+            pause,
+            position,
+            gain,
+            speed,
+            keyLock,
+            crossfader,
+            crossfaderCurve
+        };
+
+        double timeInSeconds = 0.0;
+        Type type = Type::play;
+
+        /**
+         * The deck the event applies to, 1 or 2. Unused by crossfader events.
+         */
+        int deck = 1;
+
+        /**
+         * The parameter value, in the units of the matching DJAudioPlayer or DeckMixer setter.
+         */
+        double value = 0.0;
+
+        /**
+         * The track to load, for load events.
+         */
+        juce::URL url;
+    };
+
+    /**
+     * A complete automation timeline.
+     */
+    struct Timeline
+    {
+        double lengthInSeconds = 0.0;
+
+        /**
+         * The events in time order. Events at the same time are applied in the order given.
+         */
+        std::vector<Event> events;
+    };
+
+    /**
+     * Render settings.
+     */
+    struct Settings
+    {
+        double sampleRate = 44100.0;
+        int blockSize = 1024;
+        int bitsPerSample = 24;
+
+        /**
+         * Render the two decks on separate threads.
+         */
+        bool renderDecksInParallel = true;
+
+        /**
+         * Budget of the sample cache the tracks are decoded into.
+         */
+        juce::int64 memoryBudgetBytes = juce::int64(2048) * 1024 * 1024;
+    };
+
+    /**
+     * What a render did and how long it took.
+     */
+    struct Report
+    {
+        double renderedSeconds = 0.0;
+        double decodeSeconds = 0.0;
+        double renderSeconds = 0.0;
+        juce::String errorMessage;
+
+        /**
+         * Get the number of seconds of audio rendered per second of wall-clock time, excluding decoding.
+         */
+        double getRealtimeFactor() const;
+
+        /**
+         * Describe the render in one line for the command line.
+         */
+        juce::String toString() const;
+    };
+
+    /**
+     * Constructor for MixRenderer.
+     *
+     * @param _formatManager The AudioFormatManager used to decode tracks and write the output.
+     */
+    explicit MixRenderer(AudioFormatManager& _formatManager);
+
+    /**
+     * Read a timeline from JSON.
+     *
+     * The JSON is an object with a "length" in seconds and an array of "events".
+     * Every event has a "time" in seconds and an "action": load, play, pause,
+     * position, gain, speed, keyLock, crossfader or crossfaderCurve. Deck events
+     * name their "deck", 1 or 2. Load events give a "url", either a URL or a file
+     * path relative to the timeline. Other events give a "value"; for crossfaderCurve
+     * it is linear, constantPower or cut.
+     *
+     * @param json          The JSON text.
+     * @param baseDirectory The directory relative file paths are resolved against.
+     * @param timeline      The timeline that receives the events, sorted by time.
+     * @param errorMessage  Set to a description of the problem if the JSON is not a valid timeline.
+     * @return              True if the timeline was read.
+     */
+    static bool parseTimeline(const juce::String& json, const juce::File& baseDirectory,
+        Timeline& timeline, juce::String& errorMessage);
+
+    /**
+     * Render a timeline to a file. The format is chosen from the file extension, e.g. .wav or .flac.
+     *
+     * @param timeline   The automation to play.
+     * @param outputFile The file to write, replaced if it exists.
+     * @param settings   The render settings.
+     * @param report     Receives the timings, or the error message if the render failed.
+     * @return           True if the file was written.
+     */
+    bool render(const Timeline& timeline, const juce::File& outputFile, const Settings& settings, Report& report);
+
+    /**
+     * Read a timeline file, render it and describe the result. Used by the --render command line mode.
+     *
+     * @param timelineFile The JSON timeline.
+     * @param outputFile   The file to write.
+     * @param message      Receives the report, or the error, as text.
+     * @return             True if the file was written.
+     */
+    static bool renderFromCommandLine(const juce::File& timelineFile, const juce::File& outputFile, juce::String& message);
+
+private:
+    class DeckBuffer;
+
+    /**
+     * Decode every track the timeline loads into the cache, one job per track.
+     *
+     * @return False with errorMessage set if a track could not be decoded.
+     */
+    bool decodeTracks(const Timeline& timeline, SampleCache& cache, juce::String& errorMessage);
+
+    /**
+     * AudioFormatManager reference
+     */
+    AudioFormatManager& formatManager;
+};
@@ -1,45 +1,75 @@
-/*
-  ==============================================================================
-
-    OtherLookAndFeel.cpp
-    Created: 17 Feb 2024 6:47:05pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#include "OtherLookAndFeel.h"
-
-OtherLookAndFeel::OtherLookAndFeel() {
-
-}
-
-OtherLookAndFeel::~OtherLookAndFeel() {
-}
-
-void OtherLookAndFeel::drawRotarySlider(Graphics& g, int x, int y, int width, int height, float sliderPos,
-    float rotaryStartAngle, float rotaryEndAngle, Slider& slider)
-{
-    auto angle = MathConstants<float>::pi;
-    slider.setRotaryParameters(angle, (angle * 2) + angle, true);
-
-
-    float dia = jmin(width, height);
-    float rad = dia * 0.5;
-    float focusX = x + width * 0.5;
-    float focusY = y + height * 0.5;
-    float ang = rotaryStartAngle + (sliderPos * (rotaryEndAngle - rotaryStartAngle));
-
-    AffineTransform rot = AffineTransform::rotation(ang).translated(focusX, focusY);
-
-    auto djImg = ImageCache::getFromMemory(BinaryData::disc_png, BinaryData::disc_pngSize);
-
-    g.addTransform(AffineTransform::rotation(rotAngle, focusX, focusY));
-
-    g.drawImageWithin(djImg, x, y, width, height, RectanglePlacement::centred, false);
-}
-
-void OtherLookAndFeel::rotateDisc(double ang)
-{
-    rotAngle = ang;
-}
\ No newline at end of file
+/*
+  ==============================================================================
+
+    OtherLookAndFeel.cpp
+    Created: 17 Feb 2024 6:47:05pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "OtherLookAndFeel.h"
+
+OtherLookAndFeel::OtherLookAndFeel() {
+    discImage = ImageCache::getFromMemory(BinaryData::disc_png, BinaryData::disc_pngSize);
+    discFrames.resize(numDiscFrames);
+}
+
+OtherLookAndFeel::~OtherLookAndFeel() {
+}
+
+void OtherLookAndFeel::drawRotarySlider(Graphics& g, int x, int y, int width, int height, float sliderPos,
+    float rotaryStartAngle, float rotaryEndAngle, Slider& slider)
+{
+    auto angle = MathConstants<float>::pi;
+    slider.setRotaryParameters(angle, (angle * 2) + angle, true);
+
+
+    float dia = jmin(width, height);
+    float rad = dia * 0.5;
+    float focusX = x + width * 0.5;
+    float focusY = y + height * 0.5;
+    float ang = rotaryStartAngle + (sliderPos * (rotaryEndAngle - rotaryStartAngle));
+
+    // Pick the pre-rendered frame for the current angle and blit it centred
+    const Image& frame = getDiscFrame(roundToInt(dia));
+
+    g.drawImageAt(frame, roundToInt(focusX - frame.getWidth() * 0.5f), roundToInt(focusY - frame.getHeight() * 0.5f));
+}
+
+void OtherLookAndFeel::rotateDisc(double ang)
+{
+    rotAngle = ang;
+}
+
+const Image& OtherLookAndFeel::getDiscFrame(int diameter)
+{
+    diameter = jmax(1, diameter);
+
+    // A new size invalidates every sprite, the disc is scaled once for all of them
+    if (scaledDiscImage.getWidth() != diameter)
+    {
+        scaledDiscImage = discImage.rescaled(diameter, diameter, Graphics::highResamplingQuality);
+
+        for (auto& frame : discFrames)
+            frame = Image();
+    }
+
+    const double turn = MathConstants<double>::twoPi;
+    const double wrapped = rotAngle - turn * std::floor(rotAngle / turn);
+    const int index = roundToInt(wrapped / turn * numDiscFrames) % numDiscFrames;
+    Image& frame = discFrames.getReference(index);
+
+    if (!frame.isValid())
+    {
+        frame = Image(Image::ARGB, diameter, diameter, true);
+        Graphics g(frame);
+        g.setImageResamplingQuality(Graphics::highResamplingQuality);
+
+        const float centre = diameter * 0.5f;
+        g.drawImageTransformed(scaledDiscImage,
+            AffineTransform::rotation(static_cast<float>(index * turn / numDiscFrames), centre, centre));
+    }
+
+    return frame;
+}
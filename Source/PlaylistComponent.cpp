@@ -1,504 +1,880 @@
-/*
-  ==============================================================================
-
-    PlaylistComponent.cpp
-    Created: 1 Feb 2024 8:01:17pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "PlaylistComponent.h"
-
-
-//==============================================================================
-PlaylistComponent::PlaylistComponent(AudioFormatManager& _formatManager, 
-                                     DeckGUI* _deckGUI1, 
-                                     DeckGUI* _deckGUI2)
-    : formatManager(_formatManager), 
-    deckGUI1(_deckGUI1), 
-    deckGUI2(_deckGUI2)
-{
-    formatManager.registerBasicFormats();
-
-    readExistingPlaylistData();
-
-    // Add buttons and editable text box to make them visible.
-    addAndMakeVisible(importTrackToLib);
-    addAndMakeVisible(loadBtn1);
-    addAndMakeVisible(loadBtn2);
-    addAndMakeVisible(searchBox);
-    addAndMakeVisible(clearPlaylistBtn);
-
-    // Add listeners for click events.
-    importTrackToLib.addListener(this);
-    loadBtn1.addListener(this);
-    loadBtn2.addListener(this);
-    searchBox.addListener(this);
-    clearPlaylistBtn.addListener(this);
-
-    loadBtn1.setColour(TextButton::textColourOffId, Colours::orange);
-    importTrackToLib.setColour(TextButton::textColourOffId, Colours::orange);
-    loadBtn2.setColour(TextButton::textColourOffId, Colours::deepskyblue);
-    clearPlaylistBtn.setColour(TextButton::textColourOffId, Colours::deepskyblue);
-
-    // Configure columns for the table component
-    tableComponent.getHeader().addColumn("Track Title", 1, 320);
-    tableComponent.getHeader().addColumn("Music Length (MM/SS)", 2, 150);
-    tableComponent.getHeader().addColumn("Remove", 3, 150);
-
-    // Set the model for the table component
-    tableComponent.setModel(this);
-
-    // Make the table component visible
-    addAndMakeVisible(tableComponent);
-
-    // Display placeholder text in the search box
-    searchBox.setTextToShowWhenEmpty("Search here...", juce::Colours::navajowhite);
-
-    // Center the placeholder text vertically
-    searchBox.setJustification(juce::Justification::centred);
-
-    // Set the font size for the placeholder text
-    searchBox.setFont(16.0f);
-
-    // Enable keyboard focus for the TextEditor
-    searchBox.setWantsKeyboardFocus(true);
-
-    // Ensure that "Enter" key press is not treated as a newline
-    searchBox.setReturnKeyStartsNewLine(false);
-}
-
-PlaylistComponent::~PlaylistComponent()
-{
-    // Save the current playlist state before closing the application
-    savePlaylistToFile();
-}
-
-void PlaylistComponent::paint (juce::Graphics& g)
-{
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-}
-
-void PlaylistComponent::resized()
-{
-    // Calculate width and height based on the component's size
-    int width = getWidth() / 10;
-    int height = getHeight() / 12;
-
-    // Set the bounds for the respective buttons
-    searchBox.setBounds(0, 0, getWidth(), height);
-    loadBtn1.setBounds(0, height, width, height * 4);
-    loadBtn2.setBounds(width * 9, height, width, height * 4);
-    tableComponent.setBounds(width, height, width * 8, height * 4);
-    clearPlaylistBtn.setBounds(getWidth() / 2, height * 5, getWidth() / 2, height);
-    importTrackToLib.setBounds(0, height * 5, getWidth() / 2, height);
-
-    // Adjust column widths in the table header based on the component's width
-    tableComponent.getHeader().setColumnWidth(1, getWidth() * 0.4);
-    tableComponent.getHeader().setColumnWidth(2, getWidth() * 0.31);
-    tableComponent.getHeader().setColumnWidth(3, getWidth() * 0.09);
-}
-
-
-int PlaylistComponent::getNumRows()
-{
-    // return size of sound track
-    return soundTrack.size();
-}
-
-void PlaylistComponent::paintRowBackground(Graphics & g,
-    int rowNumber,
-    int width,
-    int height,
-    bool rowIsSelected)
-{
-    if (rowIsSelected)
-    {
-        g.fillAll(Colours::orange);
-    }
-    else
-    {
-        g.fillAll(Colours::transparentBlack);
-    }
-}
-
-void PlaylistComponent::paintCell(juce::Graphics & g,
-    int rowNumber,
-    int columnId,
-    int width,
-    int height,
-    bool rowIsSelected)
-{
-    g.setColour(Colours::white);
-    g.drawText(soundTrack[rowNumber].MusicName,
-        2,
-        0,
-        width - 4,
-        height,
-        Justification::centredLeft,
-        true);
-}
-
-juce::Component* PlaylistComponent::refreshComponentForCell(int row,
-    int columnId,
-    bool isRowSelected,
-    juce::Component* componentToUpdate)
-{
-    if (columnId == 2)
-    {
-        // Check if the rowNumber is within the valid range
-        if (row >= 0 && row < soundTrack.size())
-        {
-            // Get the music URL for the current row
-            juce::URL musicURL = soundTrack[row].MusicUrl;
-
-            // Use the modified getMusicLength function to get the minutes and seconds
-            std::pair<int, int> musicLength = getMusicLength(musicURL);
-
-            int minutes = musicLength.first;
-            int seconds = musicLength.second;
-
-            // Attempt to cast the existing componentToUpdate to a Label
-            juce::Label* durationLabel = dynamic_cast<juce::Label*>(componentToUpdate);
-
-            if (durationLabel == nullptr)
-            {
-                // If componentToUpdate is not a Label, create a new Label
-                durationLabel = new juce::Label{};
-                durationLabel->setJustificationType(juce::Justification::centred);
-                durationLabel->setColour(juce::Label::textColourId, juce::Colours::white);
-                durationLabel->setColour(juce::Label::backgroundColourId, juce::Colours::transparentWhite);
-
-                // Set the label as the componentToUpdate
-                componentToUpdate = durationLabel;
-            }
-
-            // Set the label's text to the minutes and seconds
-            durationLabel->setText(juce::String::formatted("%02d:%02d", minutes, seconds),
-                juce::dontSendNotification); // tell the system not to trigger any listeners or observers associated with the change
-        }
-    }
-    else if (columnId == 3)
-    {
-        if (componentToUpdate == nullptr)
-        {
-            // If componentToUpdate is null, create a new TextButton
-            juce::TextButton* deleteButton = new juce::TextButton{ "Del" };
-
-            // Convert the row index to a string and set it as the component ID
-            juce::String id{ std::to_string(row) };
-            deleteButton->setComponentID(id);
-
-            // Add a listener for the delete button
-            deleteButton->addListener(this);
-            deleteButton->setColour(TextButton::textColourOffId, Colours::gold);
-
-            // Set the TextButton as the componentToUpdate
-            componentToUpdate = deleteButton;
-        }
-    }
-
-    // Return the updated or newly created component
-    return componentToUpdate;
-}
-
-// When a button is clicked
-void PlaylistComponent::buttonClicked(juce::Button* button)
-{
-    if (button == &importTrackToLib)
-    {
-        DBG("PlaylistComponent::buttonClicked - Import track button was clicked");
-
-        // Launch the file chooser and able to select multiple files
-        auto fileChooser = juce::FileBrowserComponent::canSelectMultipleItems;
-        fChooser.launchAsync(fileChooser, [this](const juce::FileChooser& chooser)
-            {
-                // Iterate through all the selected files
-                for (const auto& file : chooser.getResults())
-                {
-                    // Add the selected file to the playlist
-                    juce::File musicFile{ file };
-                    addSoundTrack(musicFile);
-                }
-            });
-    }
-    else if (button == &loadBtn1)
-    {
-        DBG("PlaylistComponent::buttonClicked - Load to Deck1 button was clicked");
-
-        // Load the selected music into deck1
-        loadToSpecifiedPlayer(deckGUI1);
-    }
-    else if (button == &loadBtn2)
-    {
-        DBG("PlaylistComponent::buttonClicked - Load to Deck2 button was clicked");
-
-        // Load the selected music into deck2
-        loadToSpecifiedPlayer(deckGUI2);
-    }
-    else if (button == &clearPlaylistBtn)
-    {
-        DBG("PlaylistComponent::buttonClicked - Clear Playlist button was clicked");
-
-        // Display a confirmation dialog before clearing the playlist
-        juce::AlertWindow confirmDelete("Clear Playlist", "Are you sure you want to clear the playlist?", juce::AlertWindow::QuestionIcon);
-        confirmDelete.setUsingNativeTitleBar(true);
-        confirmDelete.addButton("Clear", 1); // If the "Clear" button is clicked, returns 1
-        confirmDelete.addButton("Cancel", 0); // If the "Cancel" button is clicked, returns 0
-
-        // define JUCE_MODAL_LOOPS_PERMITTED=1 at "defined at preprocessor definations"
-        // For runModalLoop()
-        // Run the modal loop to wait for user input in the confirmation dialog
-        int result = confirmDelete.runModalLoop();
-
-        if (result == 1) // "Clear" button clicked
-        {
-            // Clear the playlist if confirmed
-            clearPlaylist();
-        }
-    }
-    else
-    {
-        // Remove a track based on the button's component ID
-        int id = std::stoi(button->getComponentID().toStdString());
-        deleteMusic(id);
-    }
-}
-
-// Convert the music file into music name and url and add into the SoundTrack
-void PlaylistComponent::addSoundTrack(const juce::File& musicFile)
-{
-    DBG("PlaylistComponent::addSoundTrack");
-
-    // Get the music name and URL of the of the file.
-    juce::String musicName = musicFile.getFileNameWithoutExtension();
-    juce::String musicUrl = juce::URL{ musicFile }.toString(false);
-
-    // Check if the musicName is already in the playlist.
-    if (matchingMusicTitle(musicName))
-    {
-        DBG(musicName << " is already loaded");
-        return;  // Exit early if the track is already in the playlist.
-    }
-    // Create a new SoundTrack object and add it to the playlist.
-    SoundTrack newTrack{ musicName, musicUrl };
-    soundTrack.push_back(newTrack);
-
-    // Update the table content.
-    tableComponent.updateContent();
-}
-
-// Delete music from the playlist
-void PlaylistComponent::deleteMusic(int id)
-{
-    DBG("PlaylistComponent::deleteMusic");
-    // remove the music at the requested index within the playlist
-    soundTrack.erase(soundTrack.begin() + id);
-    tableComponent.updateContent();
-}
-
-// Load track into a specified player
-void PlaylistComponent::loadToSpecifiedPlayer(DeckGUI* deckGUI)
-{
-    DBG("PlaylistComponent::loadInPlayer");
-
-    try
-    {
-        // Get the selected row from the table component.
-        std::optional<int> selectedRow = tableComponent.getSelectedRow();
-
-        // Check if no row is selected
-        if (!selectedRow.has_value())
-        {
-            throw std::runtime_error("Error: No row selected.");
-        }
-
-        // Check if the selected row is within the valid range of soundTrack.
-        if (selectedRow.value() < 0 || selectedRow.value() >= soundTrack.size())
-        {
-            throw std::out_of_range("Error: Selected row is out of bounds.");
-        }
-        // Load the selected track into the deck.
-        deckGUI->loadMusicFileToApplication(soundTrack[selectedRow.value()].MusicUrl);
-    }
-    catch (const std::exception& e)
-    {
-        // Handle exceptions and print error messages.
-        DBG("Exception caught: " << e.what());
-    }
-}
-
-bool PlaylistComponent::matchingMusicTitle(const juce::String& MusicName) const
-{
-    // Store the titles of imported audio tracks in a set
-    std::unordered_set<juce::String> musicTitles;
-
-    // Populate with existing track titles
-    for (const auto& music : soundTrack)
-    {
-        musicTitles.insert(music.MusicName);
-    }
-
-    // Check if the imported music title exists
-    return musicTitles.find(MusicName) != musicTitles.end();
-}
-
-// It updates the search results in the searhbox based on the search input
-void PlaylistComponent::textEditorReturnKeyPressed(juce::TextEditor& editor)
-{
-    // Handle the "Enter" key press
-    searchBoxInput = editor.getText().toLowerCase();  // Convert search input to lowercase
-    int selectedRow = -1;  // Initialize selected row index
-
-    // Check if the search bar contains any input
-    if (!searchBoxInput.isEmpty())
-    {
-        // Iterate through the tracks in the playlist to find a matching track.
-        for (int i = 0; i < soundTrack.size(); ++i)
-        {
-            // Convert track name to lowercase for case-insensitive comparison
-            juce::String trackNameLowerCase = soundTrack[i].MusicName.toLowerCase();
-
-            // Check if the track name contains the lowercase search input
-            if (trackNameLowerCase.contains(searchBoxInput))
-            {
-                selectedRow = i;  // Record the index of the matching track
-                break;  // Exit the loop when a match is found.
-            }
-        }
-    }
-
-    // Select the row if a match is found, otherwise deselect all rows.
-    if (selectedRow != -1)
-    {
-        tableComponent.selectRow(selectedRow);  // Select the matching row in the table
-    }
-    else
-    {
-        tableComponent.deselectAllRows();  // Deselect all rows if no match is found
-    }
-
-    // Update the table to display the search results.
-    tableComponent.updateContent();  // Refresh the table to reflect the selected/deselected rows
-}
-
-// make use of url to fet the minutes and seconds of each files
-std::pair<int, int> PlaylistComponent::getMusicLength(const juce::URL& musicURL)
-{
-    // Create an AudioFormatReader for each audio track URL
-    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(musicURL.createInputStream(false)));
-
-    if (reader != nullptr) {
-        // Get the length of the audio track in seconds
-        double audioLengthInSeconds = reader->lengthInSamples / static_cast<double>(reader->sampleRate);
-
-        // Convert to minutes and seconds
-        int minutes = static_cast<int>(audioLengthInSeconds / 60);
-        int seconds = static_cast<int>(audioLengthInSeconds - minutes * 60);
-
-        // Return a pair of minutes and seconds
-        return std::make_pair(minutes, seconds);
-    }
-    else {
-        // Return default value if an error occurs
-        return std::make_pair(0, 0);
-    }
-}
-
-bool PlaylistComponent::isInterestedInFileDrag(const StringArray& files)
-{
-    DBG("PlaylistComponent::isInterestedInFileDrag");
-    return true; // Always interested in file drag events
-}
-
-void PlaylistComponent::filesDropped(const StringArray& files, int x, int y)
-{
-    DBG("PlaylistComponent::filesDropped");
-
-    if (files.size() > 0)
-    {
-        // Iterate through all the dropped files
-        for (const auto& file : files)
-        {
-            // Add each file to the playlist
-            juce::File musicFile{ file };
-            addSoundTrack(musicFile);
-        }   
-    }
-}
-
-void PlaylistComponent::clearPlaylist()
-{
-    // Clear the playlist by removing all sound tracks
-    soundTrack.clear();
-
-    // Clear the associated text file
-    std::ofstream playlistFile("CurrentPlaylist.txt", std::ios::trunc);
-
-    // Update the table after clearing the playlist
-    tableComponent.updateContent();
-}
-
-void PlaylistComponent::savePlaylistToFile()
-{
-    try {
-        // Open the text file CurrentPlaylist.txt for writing
-        std::ofstream playlistFile("CurrentPlaylist.txt");
-
-        // Check if the file is open for writing
-        if (!playlistFile.is_open()) {
-            DBG("Error: Could not open playlist file for writing.");
-            return;
-        }
-
-        // Iterate through soundTrack and write each track's information to the file
-        for (const auto& track : soundTrack) {
-            playlistFile << track.MusicName << "," << track.MusicUrl << std::endl;
-        }
-
-        // Close the file
-        playlistFile.close();
-    }
-    catch (const std::exception& e) {
-        DBG("Exception caught while saving playlist: " << e.what());
-    }
-}
-
-void PlaylistComponent::readExistingPlaylistData()
-{
-    try {
-        // Open the text file CurrentPlaylist.txt for reading
-        std::ifstream file("CurrentPlaylist.txt");
-        std::string str;
-
-        // Check if the file is open for reading
-        if (!file.is_open()) {
-            DBG("Error: Could not open playlist file for reading.");
-            return;
-        }
-
-        // Read each line and add it to soundTrack
-        while (std::getline(file, str)) {
-            std::istringstream iss(str);
-            std::string musicName, musicUrl;
-
-            // Extract MusicName and MusicUrl from each line
-            if (std::getline(std::getline(iss, musicName, ','), musicUrl)) {
-                // Debug print for verification
-                DBG(musicName);
-                DBG(musicUrl);
-                // Add a new SoundTrack to soundTrack
-                soundTrack.emplace_back(SoundTrack{ musicName, musicUrl });
-                tableComponent.updateContent();
-            }
-        }
-
-        // Close the file
-        file.close();
-    }
-    catch (const std::exception& e) {
-        DBG("Exception caught while reading playlist: " << e.what());
-    }
-}
\ No newline at end of file
+/*
+  ==============================================================================
+
+    PlaylistComponent.cpp
+    Created: 1 Feb 2024 8:01:17pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PlaylistComponent.h"
+#include <algorithm>
+
+
+//==============================================================================
+PlaylistComponent::PlaylistComponent(AudioFormatManager& _formatManager, 
+                                     SampleCache& _sampleCache,
+                                     DeckGUI* _deckGUI1, 
+                                     DeckGUI* _deckGUI2)
+    : formatManager(_formatManager), 
+    sampleCache(_sampleCache),
+    deckGUI1(_deckGUI1), 
+    deckGUI2(_deckGUI2)
+{
+    formatManager.registerBasicFormats();
+
+    readExistingPlaylistData();
+
+    // Add buttons and editable text box to make them visible.
+    addAndMakeVisible(importTrackToLib);
+    addAndMakeVisible(importFolderBtn);
+    addChildComponent(importProgressBar);
+    addChildComponent(cancelImportBtn);
+    addAndMakeVisible(loadBtn1);
+    addAndMakeVisible(loadBtn2);
+    addAndMakeVisible(searchBox);
+    addAndMakeVisible(clearPlaylistBtn);
+
+    // Add listeners for click events.
+    importTrackToLib.addListener(this);
+    importFolderBtn.addListener(this);
+    cancelImportBtn.addListener(this);
+    loadBtn1.addListener(this);
+    loadBtn2.addListener(this);
+    searchBox.addListener(this);
+    clearPlaylistBtn.addListener(this);
+
+    loadBtn1.setColour(TextButton::textColourOffId, Colours::orange);
+    importTrackToLib.setColour(TextButton::textColourOffId, Colours::orange);
+    importFolderBtn.setColour(TextButton::textColourOffId, Colours::orange);
+    cancelImportBtn.setColour(TextButton::textColourOffId, Colours::gold);
+    importProgressBar.setColour(ProgressBar::foregroundColourId, Colours::orange);
+    loadBtn2.setColour(TextButton::textColourOffId, Colours::deepskyblue);
+    clearPlaylistBtn.setColour(TextButton::textColourOffId, Colours::deepskyblue);
+
+    // Configure columns for the table component
+    tableComponent.getHeader().addColumn("Track Title", 1, 320);
+    tableComponent.getHeader().addColumn("Music Length (MM/SS)", 2, 150);
+    tableComponent.getHeader().addColumn("BPM", 4, 80);
+    tableComponent.getHeader().addColumn("Key", 5, 80);
+    tableComponent.getHeader().addColumn("Remove", 3, 150, 30, -1,
+        TableHeaderComponent::defaultFlags & ~TableHeaderComponent::sortable);
+
+    // Set the model for the table component
+    tableComponent.setModel(this);
+
+    // Make the table component visible
+    addAndMakeVisible(tableComponent);
+
+    // Display placeholder text in the search box
+    searchBox.setTextToShowWhenEmpty("Search here...", juce::Colours::navajowhite);
+
+    // Center the placeholder text vertically
+    searchBox.setJustification(juce::Justification::centred);
+
+    // Set the font size for the placeholder text
+    searchBox.setFont(16.0f);
+
+    // Enable keyboard focus for the TextEditor
+    searchBox.setWantsKeyboardFocus(true);
+
+    // Ensure that "Enter" key press is not treated as a newline
+    searchBox.setReturnKeyStartsNewLine(false);
+}
+
+PlaylistComponent::~PlaylistComponent()
+{
+    // Save the current playlist state before closing the application
+    savePlaylistToFile();
+}
+
+void PlaylistComponent::paint (juce::Graphics& g)
+{
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
+}
+
+void PlaylistComponent::resized()
+{
+    // Calculate width and height based on the component's size
+    int width = getWidth() / 10;
+    int height = getHeight() / 12;
+
+    // Set the bounds for the respective buttons
+    searchBox.setBounds(0, 0, getWidth(), height);
+    loadBtn1.setBounds(0, height, width, height * 4);
+    loadBtn2.setBounds(width * 9, height, width, height * 4);
+    tableComponent.setBounds(width, height, width * 8, height * 4);
+    clearPlaylistBtn.setBounds(getWidth() * 2 / 3, height * 5, getWidth() - getWidth() * 2 / 3, height);
+    importTrackToLib.setBounds(0, height * 5, getWidth() / 3, height);
+    importFolderBtn.setBounds(getWidth() / 3, height * 5, getWidth() / 3, height);
+
+    // The progress bar and cancel button take the place of the import buttons while importing
+    importProgressBar.setBounds(0, height * 5, getWidth() / 2, height);
+    cancelImportBtn.setBounds(getWidth() / 2, height * 5, getWidth() * 2 / 3 - getWidth() / 2, height);
+
+    // Adjust column widths in the table header based on the component's width
+    tableComponent.getHeader().setColumnWidth(1, getWidth() * 0.32);
+    tableComponent.getHeader().setColumnWidth(2, getWidth() * 0.17);
+    tableComponent.getHeader().setColumnWidth(4, getWidth() * 0.1);
+    tableComponent.getHeader().setColumnWidth(5, getWidth() * 0.12);
+    tableComponent.getHeader().setColumnWidth(3, getWidth() * 0.09);
+}
+
+
+int PlaylistComponent::getNumRows()
+{
+    // return the number of search hits, or the size of sound track when not searching
+    return hasCustomRowOrder() ? static_cast<int>(visibleRows.size()) : static_cast<int>(trackStore.size());
+}
+
+void PlaylistComponent::paintRowBackground(Graphics & g,
+    int rowNumber,
+    int width,
+    int height,
+    bool rowIsSelected)
+{
+    if (rowIsSelected)
+    {
+        g.fillAll(Colours::orange);
+    }
+    else
+    {
+        g.fillAll(Colours::transparentBlack);
+    }
+}
+
+void PlaylistComponent::paintCell(juce::Graphics & g,
+    int rowNumber,
+    int columnId,
+    int width,
+    int height,
+    bool rowIsSelected)
+{
+    // Every column is painted straight from the track store, so scrolling never creates components
+    int index = getTrackIndexForRow(rowNumber);
+
+    if (index < 0)
+        return;
+
+    if (columnId == 1)
+    {
+        g.setColour(Colours::white);
+        g.drawText(trackStore.getName(index),
+            2,
+            0,
+            width - 4,
+            height,
+            Justification::centredLeft,
+            true);
+    }
+    else if (columnId == 2)
+    {
+        // Show a placeholder until the TrackAnalyser has delivered the duration
+        juce::String lengthText{ "--:--" };
+
+        if (trackStore.isAnalysed(index))
+        {
+            std::pair<int, int> musicLength = getMusicLength(trackStore.getLengthInSeconds(index));
+            lengthText = juce::String::formatted("%02d:%02d", musicLength.first, musicLength.second);
+        }
+
+        g.setColour(Colours::white);
+        g.drawText(lengthText, 0, 0, width, height, Justification::centred, false);
+    }
+    else if (columnId == 4)
+    {
+        // Show a placeholder until the ContentAnalyser has delivered the tempo
+        juce::String bpmText{ "--" };
+
+        if (trackStore.hasBeatGrid(index))
+            bpmText = juce::String(trackStore.getBpm(index), 1);
+
+        g.setColour(Colours::white);
+        g.drawText(bpmText, 0, 0, width, height, Justification::centred, false);
+    }
+    else if (columnId == 5)
+    {
+        // The Camelot code comes first, so harmonic neighbours are easy to spot
+        juce::String keyText{ "--" };
+        const int key = trackStore.getMusicalKey(index);
+
+        if (key >= 0)
+            keyText = KeyAnalyser::getCamelotCode(key) + "  " + KeyAnalyser::getKeyName(key);
+
+        g.setColour(Colours::white);
+        g.drawText(keyText, 0, 0, width, height, Justification::centred, false);
+    }
+    else if (columnId == 3)
+    {
+        // Drawn like the old "Del" button, clicks are handled in cellClicked
+        auto area = Rectangle<float>(0.0f, 0.0f, static_cast<float>(width), static_cast<float>(height)).reduced(4.0f, 2.0f);
+        g.setColour(Colours::gold.withAlpha(0.15f));
+        g.fillRoundedRectangle(area, 3.0f);
+        g.setColour(Colours::gold);
+        g.drawRoundedRectangle(area, 3.0f, 1.0f);
+        g.drawText("Del", area, Justification::centred, false);
+    }
+}
+
+// Delete the track whose "Del" cell was clicked
+void PlaylistComponent::cellClicked(int rowNumber, int columnId, const juce::MouseEvent& event)
+{
+    if (columnId != 3)
+        return;
+
+    int index = getTrackIndexForRow(rowNumber);
+
+    // The id is read at click time, so it always belongs to the row that was clicked
+    if (index >= 0)
+        deleteMusic(trackStore.getId(index));
+}
+
+// Sort the table by the clicked column, on top of any search filter
+void PlaylistComponent::sortOrderChanged(int newSortColumnId, bool isForwards)
+{
+    sortColumnId = newSortColumnId;
+    sortForwards = isForwards;
+    applySearch();
+}
+
+// Decode the focused track ahead of time so RAM-resident decks load it instantly
+void PlaylistComponent::selectedRowsChanged(int lastRowSelected)
+{
+    // Streaming decks never read the cache, and preloading a whole selection would evict the decks' own tracks
+    if (!deckGUI1->isRamResident() && !deckGUI2->isRamResident())
+        return;
+
+    int index = getTrackIndexForRow(lastRowSelected);
+
+    if (index >= 0)
+    {
+        sampleCache.preload(juce::URL{ trackStore.getUrl(index) });
+    }
+}
+
+// When a button is clicked
+void PlaylistComponent::buttonClicked(juce::Button* button)
+{
+    if (button == &importTrackToLib)
+    {
+        DBG("PlaylistComponent::buttonClicked - Import track button was clicked");
+
+        // Launch the file chooser and able to select multiple files
+        auto fileChooser = juce::FileBrowserComponent::canSelectMultipleItems;
+        fChooser.launchAsync(fileChooser, [this](const juce::FileChooser& chooser)
+            {
+                // Probe all the selected files in the background
+                importFiles(chooser.getResults());
+            });
+    }
+    else if (button == &importFolderBtn)
+    {
+        DBG("PlaylistComponent::buttonClicked - Import folder button was clicked");
+
+        // Launch the file chooser to pick a folder, which is imported with all its subfolders
+        auto folderChooserFlags = juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectDirectories;
+        folderChooser.launchAsync(folderChooserFlags, [this](const juce::FileChooser& chooser)
+            {
+                importFiles(chooser.getResults());
+            });
+    }
+    else if (button == &cancelImportBtn)
+    {
+        DBG("PlaylistComponent::buttonClicked - Cancel import button was clicked");
+        folderImporter.cancel();
+    }
+    else if (button == &loadBtn1)
+    {
+        DBG("PlaylistComponent::buttonClicked - Load to Deck1 button was clicked");
+
+        // Load the selected music into deck1
+        loadToSpecifiedPlayer(deckGUI1);
+    }
+    else if (button == &loadBtn2)
+    {
+        DBG("PlaylistComponent::buttonClicked - Load to Deck2 button was clicked");
+
+        // Load the selected music into deck2
+        loadToSpecifiedPlayer(deckGUI2);
+    }
+    else if (button == &clearPlaylistBtn)
+    {
+        DBG("PlaylistComponent::buttonClicked - Clear Playlist button was clicked");
+
+        // Display a confirmation dialog before clearing the playlist
+        juce::AlertWindow confirmDelete("Clear Playlist", "Are you sure you want to clear the playlist?", juce::AlertWindow::QuestionIcon);
+        confirmDelete.setUsingNativeTitleBar(true);
+        confirmDelete.addButton("Clear", 1); // If the "Clear" button is clicked, returns 1
+        confirmDelete.addButton("Cancel", 0); // If the "Cancel" button is clicked, returns 0
+
+        // define JUCE_MODAL_LOOPS_PERMITTED=1 at "defined at preprocessor definations"
+        // For runModalLoop()
+        // Run the modal loop to wait for user input in the confirmation dialog
+        int result = confirmDelete.runModalLoop();
+
+        if (result == 1) // "Clear" button clicked
+        {
+            // Clear the playlist if confirmed
+            clearPlaylist();
+        }
+    }
+}
+
+// Hand files and folders to the background importer
+void PlaylistComponent::importFiles(const Array<juce::File>& filesOrFolders)
+{
+    DBG("PlaylistComponent::importFiles");
+
+    if (filesOrFolders.isEmpty())
+        return;
+
+    showImportProgress(true);
+    folderImporter.import(filesOrFolders);
+}
+
+void PlaylistComponent::showImportProgress(bool isImporting)
+{
+    importTrackToLib.setVisible(!isImporting);
+    importFolderBtn.setVisible(!isImporting);
+    importProgressBar.setVisible(isImporting);
+    cancelImportBtn.setVisible(isImporting);
+
+    if (isImporting)
+    {
+        importProgress = -1.0;
+        importProgressBar.setTextToDisplay("Scanning...");
+    }
+}
+
+// Convert a batch of probed files into sound tracks and add them to the playlist
+void PlaylistComponent::importBatchReady(const Array<TrackAnalyser::Result>& results)
+{
+    // Results arrive in completion order, sort them so folders stay together
+    Array<TrackAnalyser::Result> batch(results);
+    std::sort(batch.begin(), batch.end(), [](const auto& a, const auto& b) { return a.MusicUrl < b.MusicUrl; });
+
+    trackStore.reserve(trackStore.size() + static_cast<size_t>(batch.size()));
+
+    for (const auto& result : batch)
+    {
+        const juce::File musicFile = juce::URL{ result.MusicUrl }.getLocalFile();
+        juce::String musicName = musicFile.getFileNameWithoutExtension();
+
+        // Links are resolved here, once, so the path index never has to touch the file system
+        const juce::File targetFile = musicFile.getLinkedTarget();
+        SoundTrack newTrack{ musicName, targetFile == musicFile ? result.MusicUrl : juce::URL{ targetFile }.toString(false) };
+        newTrack.LengthInSeconds = result.LengthInSeconds;
+        newTrack.SampleRate = result.SampleRate;
+        newTrack.NumChannels = result.NumChannels;
+        newTrack.FileSize = result.FileSize;
+        newTrack.ModificationTime = result.ModificationTime;
+        newTrack.ContentHash = result.ContentHash;
+        newTrack.IsAnalysed = true;
+
+        if (!appendToPlaylist(newTrack))
+        {
+            DBG(musicName << " is already loaded");
+        }
+        else
+        {
+            // A copy of a loaded track under another name is only removed once the whole files match
+            auto id = trackIdByPath.find(getNormalisedPath(newTrack.MusicUrl));
+            registerContentHash(static_cast<size_t>(trackStore.indexOf(id->second)));
+
+            contentAnalyser.analyse(newTrack.MusicUrl);
+        }
+    }
+
+    // One table update for the whole batch
+    applySearch();
+}
+
+void PlaylistComponent::importProgressChanged(int numProbed, int numFound)
+{
+    importProgress = numFound > 0 ? static_cast<double>(numProbed) / numFound : -1.0;
+    importProgressBar.setTextToDisplay(juce::String(numProbed) + " / " + juce::String(numFound) + " tracks");
+}
+
+void PlaylistComponent::importFinished(bool wasCancelled)
+{
+    DBG("PlaylistComponent::importFinished" << (wasCancelled ? " (cancelled)" : ""));
+    showImportProgress(false);
+}
+
+// Give the track an id and make it searchable
+bool PlaylistComponent::appendToPlaylist(const SoundTrack& track)
+{
+    // One hash lookup instead of a scan of the playlist, the stored path confirms the match
+    juce::String path = getNormalisedPath(track.MusicUrl);
+
+    if (trackIdByPath.count(path) > 0)
+        return false;
+
+    const juce::uint32 id = trackStore.add(track);
+    trackIdByPath.emplace(std::move(path), id);
+
+    // Tracks from the library index already know their content
+    if (track.IsAnalysed && track.ContentHash != 0)
+        trackIdByContentHash.emplace(track.ContentHash, id);
+
+    // Titles and folder names are both searchable
+    juce::String folderName = juce::URL{ track.MusicUrl }.getLocalFile().getParentDirectory().getFileName();
+    searchIndex.add(id, track.MusicName + " " + folderName);
+    return true;
+}
+
+// Delete music from the playlist
+void PlaylistComponent::deleteMusic(juce::uint32 id)
+{
+    DBG("PlaylistComponent::deleteMusic");
+
+    int index = trackStore.indexOf(id);
+
+    if (index < 0)
+        return;
+
+    // remove the music with the requested id within the playlist
+    searchIndex.remove(id);
+    trackIdByPath.erase(getNormalisedPath(trackStore.getUrl(index)));
+
+    auto hashOwner = trackIdByContentHash.find(trackStore.getContentHash(index));
+
+    if (hashOwner != trackIdByContentHash.end() && hashOwner->second == id)
+        trackIdByContentHash.erase(hashOwner);
+
+    trackStore.remove(id);
+    applySearch();
+}
+
+bool PlaylistComponent::hasCustomRowOrder() const
+{
+    return isFiltered || sortColumnId != 0;
+}
+
+int PlaylistComponent::getTrackIndexForRow(int row) const
+{
+    if (row < 0)
+        return -1;
+
+    if (hasCustomRowOrder())
+        return row < static_cast<int>(visibleRows.size()) ? static_cast<int>(visibleRows[row]) : -1;
+
+    return row < static_cast<int>(trackStore.size()) ? row : -1;
+}
+
+// Filter the table to the tracks matching the search box
+void PlaylistComponent::applySearch()
+{
+    isFiltered = searchBoxInput.trim().isNotEmpty();
+    visibleRows.clear();
+
+    if (isFiltered)
+    {
+        for (auto id : searchIndex.search(searchBoxInput))
+        {
+            int index = trackStore.indexOf(id);
+
+            if (index >= 0)
+                visibleRows.push_back(static_cast<size_t>(index));
+        }
+    }
+    else if (sortColumnId != 0)
+    {
+        visibleRows.resize(trackStore.size());
+
+        for (size_t i = 0; i < visibleRows.size(); ++i)
+            visibleRows[i] = i;
+    }
+
+    if (sortColumnId != 0)
+        sortRows(visibleRows);
+
+    tableComponent.updateContent();
+    tableComponent.repaint();
+}
+
+void PlaylistComponent::sortRows(std::vector<size_t>& rows) const
+{
+    // Tracks still waiting for the analysers have nothing to sort by
+    auto hasValue = [this](size_t index)
+    {
+        switch (sortColumnId)
+        {
+            case 2:  return trackStore.isAnalysed(index);
+            case 4:  return trackStore.hasBeatGrid(index);
+            case 5:  return trackStore.getMusicalKey(index) >= 0;
+            default: return true;
+        }
+    };
+
+    auto analysedEnd = std::stable_partition(rows.begin(), rows.end(), hasValue);
+
+    if (sortColumnId == 1)
+    {
+        // Titles are decoded once rather than on every comparison
+        std::vector<std::pair<juce::String, size_t>> titles;
+        titles.reserve(rows.size());
+
+        for (size_t index : rows)
+            titles.emplace_back(trackStore.getName(index), index);
+
+        std::stable_sort(titles.begin(), titles.end(), [this](const auto& a, const auto& b)
+            {
+                const int order = a.first.compareNatural(b.first);
+                return sortForwards ? order < 0 : order > 0;
+            });
+
+        for (size_t i = 0; i < rows.size(); ++i)
+            rows[i] = titles[i].second;
+
+        return;
+    }
+
+    auto sortValue = [this](size_t index) -> double
+    {
+        switch (sortColumnId)
+        {
+            case 2:  return trackStore.getLengthInSeconds(index);
+            case 4:  return trackStore.getBpm(index);
+            case 5:  return KeyAnalyser::getCamelotOrder(trackStore.getMusicalKey(index));
+            default: return 0.0;
+        }
+    };
+
+    std::stable_sort(rows.begin(), analysedEnd, [&](size_t a, size_t b)
+        {
+            return sortForwards ? sortValue(a) < sortValue(b) : sortValue(b) < sortValue(a);
+        });
+}
+
+// Load track into a specified player
+void PlaylistComponent::loadToSpecifiedPlayer(DeckGUI* deckGUI)
+{
+    DBG("PlaylistComponent::loadInPlayer");
+
+    try
+    {
+        // Get the selected row from the table component.
+        std::optional<int> selectedRow = tableComponent.getSelectedRow();
+
+        // Check if no row is selected
+        if (!selectedRow.has_value())
+        {
+            throw std::runtime_error("Error: No row selected.");
+        }
+
+        // Check if the selected row is within the valid range of the track store.
+        int index = getTrackIndexForRow(selectedRow.value());
+
+        if (index < 0)
+        {
+            throw std::out_of_range("Error: Selected row is out of bounds.");
+        }
+        // Load the selected track into the deck.
+        // The stored beat grid and loudness go with it, so SYNC and the auto-gain trim
+        // work as soon as the track is loaded
+        const float trimGain = trackStore.hasLoudness(index)
+            ? LoudnessAnalyser::getTrimGain(trackStore.getLoudnessLufs(index), trackStore.getTruePeakDb(index))
+            : 0.0f;
+
+        deckGUI->loadMusicFileToApplication(trackStore.getUrl(index),
+            BeatGrid{ trackStore.getBpm(index), trackStore.getFirstBeatSeconds(index) },
+            trimGain);
+    }
+    catch (const std::exception& e)
+    {
+        // Handle exceptions and print error messages.
+        DBG("Exception caught: " << e.what());
+    }
+}
+
+juce::String PlaylistComponent::getNormalisedPath(const juce::String& musicUrl)
+{
+    // Only string work: links were resolved when the track was imported
+    juce::String path = juce::URL{ musicUrl }.getLocalFile().getFullPathName();
+    return juce::File::areFileNamesCaseSensitive() ? path : path.toLowerCase();
+}
+
+void PlaylistComponent::registerContentHash(size_t index)
+{
+    const juce::int64 contentHash = trackStore.getContentHash(index);
+    const juce::uint32 id = trackStore.getId(index);
+
+    if (contentHash == 0)
+        return;
+
+    auto inserted = trackIdByContentHash.emplace(contentHash, id);
+
+    if (inserted.second || inserted.first->second == id)
+        return;
+
+    // The hash only covers the ends of the files, so whichever track was added later is
+    // checked against the whole of the first before anything is removed
+    juce::uint32& owner = inserted.first->second;
+    juce::uint32 duplicate = id;
+
+    if (duplicate < owner)
+        std::swap(duplicate, owner);
+
+    const int ownerIndex = trackStore.indexOf(owner);
+    const int duplicateIndex = trackStore.indexOf(duplicate);
+
+    if (ownerIndex >= 0 && duplicateIndex >= 0)
+        trackAnalyser.confirmDuplicate(trackStore.getUrl(duplicateIndex), trackStore.getUrl(ownerIndex));
+}
+
+// It updates the search results in the searhbox based on the search input
+void PlaylistComponent::textEditorReturnKeyPressed(juce::TextEditor& editor)
+{
+    // Handle the "Enter" key press
+    searchBoxInput = editor.getText();
+    applySearch();
+
+    // Select the best match if there is one, otherwise deselect all rows.
+    if (isFiltered && !visibleRows.empty())
+    {
+        tableComponent.selectRow(0);  // Select the best matching row in the table
+    }
+    else
+    {
+        tableComponent.deselectAllRows();  // Deselect all rows if no match is found
+    }
+}
+
+// Search as the user types
+void PlaylistComponent::textEditorTextChanged(juce::TextEditor& editor)
+{
+    searchBoxInput = editor.getText();
+    applySearch();
+}
+
+// Use the probed length of the track to get the minutes and seconds
+std::pair<int, int> PlaylistComponent::getMusicLength(double audioLengthInSeconds) const
+{
+    // Convert to minutes and seconds
+    int minutes = static_cast<int>(audioLengthInSeconds / 60);
+    int seconds = static_cast<int>(audioLengthInSeconds - minutes * 60);
+
+    // Return a pair of minutes and seconds
+    return std::make_pair(minutes, seconds);
+}
+
+// Store the durations delivered by the TrackAnalyser and refresh the visible cells
+void PlaylistComponent::tracksAnalysed(const Array<TrackAnalyser::Result>& results)
+{
+    // Find each track through the path index instead of walking the playlist
+    for (const auto& result : results)
+    {
+        auto id = trackIdByPath.find(getNormalisedPath(result.MusicUrl));
+
+        if (id == trackIdByPath.end())
+            continue;
+
+        int index = trackStore.indexOf(id->second);
+
+        if (index < 0)
+            continue;
+
+        // A file that changed on disk no longer owns its old content hash
+        const juce::int64 oldHash = trackStore.getContentHash(index);
+        auto oldOwner = trackIdByContentHash.find(oldHash);
+
+        if (oldOwner != trackIdByContentHash.end() && oldOwner->second == id->second && oldHash != result.ContentHash)
+            trackIdByContentHash.erase(oldOwner);
+
+        trackStore.setAnalysis(index, result);
+        registerContentHash(index);
+
+        if (result.WasReadable)
+        {
+            if (trackStore.needsContentAnalysis(index))
+                contentAnalyser.analyse(result.MusicUrl);
+        }
+    }
+
+    tableComponent.updateContent();
+}
+
+// Copies of a track under another name or folder are dropped like any other duplicate
+void PlaylistComponent::duplicatesFound(const Array<TrackAnalyser::Duplicate>& duplicates)
+{
+    for (const auto& duplicate : duplicates)
+    {
+        auto id = trackIdByPath.find(getNormalisedPath(duplicate.MusicUrl));
+
+        // The copy is only dropped while the track it copies is still loaded
+        if (id == trackIdByPath.end() || trackIdByPath.count(getNormalisedPath(duplicate.OriginalUrl)) == 0)
+            continue;
+
+        DBG(duplicate.MusicUrl << " has the same content as " << duplicate.OriginalUrl);
+        deleteMusic(id->second);
+    }
+
+    tableComponent.updateContent();
+}
+
+// Store the beat grids, keys and loudness delivered by the ContentAnalyser and refresh the visible cells
+void PlaylistComponent::contentAnalysed(const Array<ContentAnalyser::Result>& results)
+{
+    for (const auto& result : results)
+    {
+        auto id = trackIdByPath.find(getNormalisedPath(result.MusicUrl));
+
+        // The track may have been deleted while it was being analysed
+        if (id == trackIdByPath.end())
+            continue;
+
+        int index = trackStore.indexOf(id->second);
+
+        if (index < 0)
+            continue;
+
+        if (result.Beats.WasAnalysed)
+            trackStore.setBeatGrid(index, result.Beats.Bpm, result.Beats.FirstBeatSeconds);
+
+        if (result.Key.WasAnalysed)
+            trackStore.setMusicalKey(index, result.Key.Key);
+
+        // The loudness is used when the track is next loaded
+        if (result.Loudness.WasAnalysed)
+            trackStore.setLoudness(index, result.Loudness.IntegratedLufs, result.Loudness.TruePeakDb);
+
+        // Tracks without a beat or a key are not decoded again on the next launch
+        trackStore.setContentAnalysed(index);
+    }
+
+    tableComponent.repaint();
+}
+
+bool PlaylistComponent::isInterestedInFileDrag(const StringArray& files)
+{
+    DBG("PlaylistComponent::isInterestedInFileDrag");
+    return true; // Always interested in file drag events
+}
+
+void PlaylistComponent::filesDropped(const StringArray& files, int x, int y)
+{
+    DBG("PlaylistComponent::filesDropped");
+
+    // Dropped files and folders are imported in the background
+    Array<juce::File> droppedFiles;
+
+    for (const auto& file : files)
+    {
+        droppedFiles.add(juce::File{ file });
+    }
+
+    importFiles(droppedFiles);
+}
+
+void PlaylistComponent::clearPlaylist()
+{
+    // Stop probing and importing tracks that are about to be removed
+    trackAnalyser.cancelAll();
+    contentAnalyser.cancelAll();
+    folderImporter.cancel();
+
+    // Clear the playlist by removing all sound tracks
+    trackStore.clear();
+    trackIdByPath.clear();
+    trackIdByContentHash.clear();
+    searchIndex.clear();
+
+    // Clear the associated library index
+    getLibraryIndexFile().deleteFile();
+
+    // Update the table after clearing the playlist
+    applySearch();
+}
+
+juce::File PlaylistComponent::getLibraryIndexFile()
+{
+    return juce::File::getCurrentWorkingDirectory().getChildFile("TrackLibrary.idx");
+}
+
+void PlaylistComponent::savePlaylistToFile()
+{
+    // Write every track and its probed metadata to the binary library index
+    if (!LibraryIndex::save(getLibraryIndexFile(), trackStore))
+    {
+        DBG("Error: Could not write the library index.");
+    }
+}
+
+void PlaylistComponent::readExistingPlaylistData()
+{
+    // Open the binary library index, falling back to the old text playlist once
+    std::vector<SoundTrack> storedTracks;
+
+    if (!LibraryIndex::load(getLibraryIndexFile(), storedTracks))
+    {
+        DBG("No library index found, importing the legacy playlist file.");
+        readLegacyPlaylistData(storedTracks);
+    }
+
+    trackStore.reserve(storedTracks.size());
+
+    for (const auto& track : storedTracks)
+    {
+        appendToPlaylist(track);
+    }
+
+    for (size_t i = 0; i < trackStore.size(); ++i)
+    {
+        const SoundTrack track = trackStore.getTrack(i);
+
+        if (track.IsAnalysed)
+        {
+            // Only re-probe files that changed on disk since they were indexed
+            trackAnalyser.analyseIfModified(track.MusicUrl, track.FileSize, track.ModificationTime);
+
+            // Only tracks never analysed, or changed since, are decoded again
+            if (trackStore.needsContentAnalysis(i))
+                contentAnalyser.analyse(track.MusicUrl);
+        }
+        else
+        {
+            trackAnalyser.analyse(track.MusicUrl);
+        }
+    }
+
+    tableComponent.updateContent();
+}
+
+void PlaylistComponent::readLegacyPlaylistData(std::vector<SoundTrack>& tracks)
+{
+    try {
+        // Open the text file CurrentPlaylist.txt for reading
+        std::ifstream file("CurrentPlaylist.txt");
+        std::string str;
+
+        // Check if the file is open for reading
+        if (!file.is_open()) {
+            DBG("Error: Could not open playlist file for reading.");
+            return;
+        }
+
+        // Read each line and add it to tracks
+        while (std::getline(file, str)) {
+            // The URL never contains a raw comma, so split on the last one
+            // to keep titles that contain commas intact
+            std::string::size_type separator = str.rfind(',');
+
+            if (separator != std::string::npos) {
+                std::string musicName = str.substr(0, separator);
+                std::string musicUrl = str.substr(separator + 1);
+
+                // Add a new SoundTrack to tracks
+                tracks.emplace_back(SoundTrack{ musicName, musicUrl });
+            }
+        }
+
+        // Close the file
+        file.close();
+    }
+    catch (const std::exception& e) {
+        DBG("Exception caught while reading playlist: " << e.what());
+    }
+}
@@ -1,251 +1,450 @@
-/*
-  ==============================================================================
-
-    PlaylistComponent.h
-    Created: 1 Feb 2024 8:01:17pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include <vector>
-#include <string>
-#include "DeckGUI.h"
-#include "SoundTrack.h"
-#include "WaveformDisplay.h"
-#include <fstream>
-
-//==============================================================================
-
-/**
-* The PlaylistComponent class is a custom graphical user interface component 
-* designed to handle a playlist of soundtracks.
-* 
-* It inherits from several JUCE classes and interfaces to facilitate audio playback control,
-* including juce::Component, juce::TableListBoxModel, juce::Button::Listener,
-* juce::TextEditor::Listener, and juce::FileDragAndDropTarget.
-*/
-class PlaylistComponent : public juce::Component,
-                          public juce::TableListBoxModel,
-                          public juce::Button::Listener,
-                          public juce::TextEditor::Listener,
-                          public juce::FileDragAndDropTarget
-{
-public:
-    /**
-     * Constructor for the PlaylistComponent class.
-     *
-     * @param _formatManager    Reference to the AudioFormatManager.
-     * @param _deckGUI1         Pointer to the first DeckGUI instance.
-     * @param _deckGUI2         Pointer to the second DeckGUI instance.
-     */
-    PlaylistComponent(juce::AudioFormatManager& _formatManager, 
-        DeckGUI* _deckGUI1, DeckGUI* _deckGUI2);
-
-    /**
-     * Destructor for the PlaylistComponent class.
-     */
-    ~PlaylistComponent() override;
-
-    /**
-     * Override of the paint method for custom rendering.
-     *
-     * @param g Graphics context for performing drawing operations.
-     */
-    void paint(juce::Graphics&) override;
-
-    /**
-     * Override of the resized method to manage component size changes.
-     */
-    void resized() override;
-
-    /**
-     * Override of the getNumRows method to determine the number of rows in the playlist.
-     *
-     * @return The number of rows in the playlist.
-     */
-    int getNumRows() override;
-
-    /**
-     * Override of the paintRowBackground method to handle the rendering of background
-     * for a specific row in the playlist.
-     *
-     * @param g             Graphics context for performing drawing operations.
-     * @param rowNumber     The index of the row to be painted.
-     * @param width         The width of the row.
-     * @param height        The height of the row.
-     * @param rowIsSelected Indicates whether the row is currently selected.
-     */
-    void paintRowBackground(Graphics& g,
-        int rowNumber,
-        int width,
-        int height,
-        bool rowIsSelected) override;
-
-    /**
-     * Override of the paintCell method to handle the rendering of content
-     * within a specific cell of the playlist.
-     *
-     * @param g             Graphics context for performing drawing operations.
-     * @param rowNumber     The index of the row containing the cell to be painted.
-     * @param columnId      The ID of the column containing the cell to be painted.
-     * @param width         The width of the cell.
-     * @param height        The height of the cell.
-     * @param rowIsSelected Indicates whether the row containing the cell is currently selected.
-     */
-    void paintCell(Graphics& g,
-        int rowNumber,
-        int columnId,
-        int width,
-        int height,
-        bool rowIsSelected) override;
-
-    /**
-     * Override of the refreshComponentForCell method to handle the creation or update
-     * of components within a specific cell of the playlist.
-     *
-     * @param rowNumber                 The index of the row containing the cell to be refreshed.
-     * @param columnId                  The ID of the column containing the cell to be refreshed.
-     * @param isRowSelected             Indicates whether the row containing the cell is currently selected.
-     * @param existingComponentToUpdate Pointer to the existing component that needs to be updated.
-     * @return                          A pointer to the updated or newly created component.
-     */
-    juce::Component* refreshComponentForCell(int rowNumber,
-        int columnId,
-        bool isRowSelected,
-        Component* existingComponentToUpdate) override;
-
-private:
-    
-    /**
-     * Function to add a soundtrack from a music file to the playlist.
-     *
-     * @param musicFile The File object representing the music file to be added.
-     */
-    void addSoundTrack(const juce::File& musicFile);
-
-    /**
-     * Function to delete a soundtrack from the playlist by its ID.
-     *
-     * @param id The ID of the soundtrack to be deleted.
-     */
-    void deleteMusic(int id);
-
-    /**
-     * Function to load a selected track into the specified DeckGUI.
-     *
-     * @param deckGUI Pointer to the DeckGUI instance where the track will be loaded.
-     */
-    void loadToSpecifiedPlayer(DeckGUI* deckGUI);
-
-    /**
-     * Function to check if a music title matches any in the playlist.
-     *
-     * @param musicName The music title to check.
-     * @return True if a match is found, false otherwise.
-     */
-    bool matchingMusicTitle(const juce::String& MusicName) const;
-
-    /**
-     * Callback function triggered when the user presses the "Enter" key in the search box.
-     *
-     * @param editor Reference to the TextEditor component.
-     */
-    void textEditorReturnKeyPressed(juce::TextEditor& editor) override;
-
-    /**
-     * Retrieve the length of a music file in minutes and seconds using its URL.
-     *
-     * @param audioURL The URL of the audio file.
-     * @return A pair representing the length in minutes and seconds.
-     */
-    std::pair<int, int> getMusicLength(const juce::URL& audioURL);
-
-    /**
-     * Determines whether the PlaylistComponent is interested in file drag events.
-     *
-     * @param files An array of file paths being dragged.
-     * @return true if interested in file drag events, false otherwise.
-     */
-    bool isInterestedInFileDrag(const StringArray& file) override;
-
-    /**
-     * Handles the event when files are dropped onto the PlaylistComponent.
-     *
-     * @param files An array of file paths that have been dropped.
-     * @param x The x-coordinate where the files were dropped.
-     * @param y The y-coordinate where the files were dropped.
-     */
-    void filesDropped(const StringArray& files, int x, int y) override;
-
-    /**
-     * Override of the buttonClicked method to handle button click events.
-     *
-     * @param button Pointer to the clicked button.
-     */
-    void buttonClicked(Button* button) override;
-
-    /**
-     * Function to clear all songs in the playlist component.
-     */
-    void clearPlaylist();
-
-    /**
-     * Function to save the current playlist data to a file.
-     */
-    void savePlaylistToFile();
-
-    /**
-     * Reads existing playlist data from a file and populates the PlaylistComponent.
-     * This method is called during the initialization of the PlaylistComponent.
-     */
-    void readExistingPlaylistData();
-
-    /**
-     * Vector to store soundtrack information
-     */
-    std::vector<SoundTrack> soundTrack;
-
-    /**
-     * AudioFormatManager reference
-     */
-    AudioFormatManager& formatManager;
-
-    /**
-     * TableListBox for displaying the playlist
-     */
-    juce::TableListBox tableComponent;
-
-    /**
-     * Buttons for importing and loading tracks to Deck 1 and 2
-     */
-    juce::TextButton importTrackToLib{ "Import To Track Library" };
-    juce::TextButton loadBtn1{ "Load\nDeck1" },
-                     loadBtn2{ "Load\nDeck2" },
-                     clearPlaylistBtn{ "Clear" };
-
-    /**
-     * Text editor for searching tracks in the playlist
-     */
-    juce::TextEditor searchBox{ "Input Song Name: " };
-    juce::String searchBoxInput;
-
-    /**
-     * FileChooser for importing tracks
-     */
-    juce::FileChooser fChooser{ "Select the track..." };
-
-    /** 
-     * Pointer to the first DeckGUI instance
-     */
-    DeckGUI* deckGUI1;
-    /**
-     * Pointer to the second DeckGUI instance
-     */
-    DeckGUI* deckGUI2;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistComponent)
+/*
+  ==============================================================================
+
+    PlaylistComponent.h
+    Created: 1 Feb 2024 8:01:17pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "DeckGUI.h"
+#include "SoundTrack.h"
+#include "TrackStore.h"
+#include "WaveformDisplay.h"
+#include "TrackAnalyser.h"
+#include "ContentAnalyser.h"
+#include "LibraryIndex.h"
+#include "SampleCache.h"
+#include "TrackSearchIndex.h"
+#include "FolderImporter.h"
+#include <fstream>
+
+//==============================================================================
+
+/**
+* The PlaylistComponent class is a custom graphical user interface component 
+* designed to handle a playlist of soundtracks.
+* 
+* It inherits from several JUCE classes and interfaces to facilitate audio playback control,
+* including juce::Component, juce::TableListBoxModel, juce::Button::Listener,
+* juce::TextEditor::Listener, and juce::FileDragAndDropTarget.
+* Track durations are probed in the background by a TrackAnalyser, tempos, beat
+* grids, keys and loudness are found in one pass over each track by a
+* ContentAnalyser, and imports of files and whole folders run in the background
+* in a FolderImporter.
+* Clicking a column header sorts the table by that column.
+*/
+class PlaylistComponent : public juce::Component,
+                          public juce::TableListBoxModel,
+                          public juce::Button::Listener,
+                          public juce::TextEditor::Listener,
+                          public juce::FileDragAndDropTarget,
+                          public TrackAnalyser::Listener,
+                          public ContentAnalyser::Listener,
+                          public FolderImporter::Listener
+{
+public:
+    /**
+     * Constructor for the PlaylistComponent class.
+     *
+     * @param _formatManager    Reference to the AudioFormatManager.
+     * @param _sampleCache      Reference to the SampleCache that selected tracks are preloaded into.
+     * @param _deckGUI1         Pointer to the first DeckGUI instance.
+     * @param _deckGUI2         Pointer to the second DeckGUI instance.
+     */
+    PlaylistComponent(juce::AudioFormatManager& _formatManager, 
+        SampleCache& _sampleCache,
+        DeckGUI* _deckGUI1, DeckGUI* _deckGUI2);
+
+    /**
+     * Destructor for the PlaylistComponent class.
+     */
+    ~PlaylistComponent() override;
+
+    /**
+     * Override of the paint method for custom rendering.
+     *
+     * @param g Graphics context for performing drawing operations.
+     */
+    void paint(juce::Graphics&) override;
+
+    /**
+     * Override of the resized method to manage component size changes.
+     */
+    void resized() override;
+
+    /**
+     * Override of the getNumRows method to determine the number of rows in the playlist.
+     *
+     * @return The number of rows in the playlist.
+     */
+    int getNumRows() override;
+
+    /**
+     * Override of the paintRowBackground method to handle the rendering of background
+     * for a specific row in the playlist.
+     *
+     * @param g             Graphics context for performing drawing operations.
+     * @param rowNumber     The index of the row to be painted.
+     * @param width         The width of the row.
+     * @param height        The height of the row.
+     * @param rowIsSelected Indicates whether the row is currently selected.
+     */
+    void paintRowBackground(Graphics& g,
+        int rowNumber,
+        int width,
+        int height,
+        bool rowIsSelected) override;
+
+    /**
+     * Override of the paintCell method to handle the rendering of content
+     * within a specific cell of the playlist.
+     *
+     * @param g             Graphics context for performing drawing operations.
+     * @param rowNumber     The index of the row containing the cell to be painted.
+     * @param columnId      The ID of the column containing the cell to be painted.
+     * @param width         The width of the cell.
+     * @param height        The height of the cell.
+     * @param rowIsSelected Indicates whether the row containing the cell is currently selected.
+     */
+    void paintCell(Graphics& g,
+        int rowNumber,
+        int columnId,
+        int width,
+        int height,
+        bool rowIsSelected) override;
+
+    /**
+     * Override of the cellClicked method to delete a track when its "Del" cell is clicked.
+     * The cell is painted rather than being a button, so the track is found from the row.
+     *
+     * @param rowNumber The index of the row that was clicked.
+     * @param columnId  The ID of the column that was clicked.
+     * @param event     The mouse event.
+     */
+    void cellClicked(int rowNumber, int columnId, const juce::MouseEvent& event) override;
+
+    /**
+     * Override of the sortOrderChanged method to sort the table when a column header is clicked.
+     *
+     * @param newSortColumnId The ID of the column to sort by, 0 to keep the playlist order.
+     * @param isForwards      True to sort in ascending order.
+     */
+    void sortOrderChanged(int newSortColumnId, bool isForwards) override;
+
+    /**
+     * Override of the selectedRowsChanged method to decode the most recently selected
+     * track into the sample cache before a deck asks for it. Only done while a deck is
+     * in RAM-resident mode.
+     *
+     * @param lastRowSelected The most recently selected row.
+     */
+    void selectedRowsChanged(int lastRowSelected) override;
+
+    /**
+     * Override of the tracksAnalysed method to store probed durations and refresh the table.
+     *
+     * @param results The results delivered by the TrackAnalyser.
+     */
+    void tracksAnalysed(const Array<TrackAnalyser::Result>& results) override;
+
+    /**
+     * Override of the duplicatesFound method to remove tracks whose whole file is already in the playlist.
+     *
+     * @param duplicates The duplicates confirmed by the TrackAnalyser.
+     */
+    void duplicatesFound(const Array<TrackAnalyser::Duplicate>& duplicates) override;
+
+    /**
+     * Override of the contentAnalysed method to store tempos, beat grids, musical keys and loudness and refresh the table.
+     *
+     * @param results The results delivered by the ContentAnalyser.
+     */
+    void contentAnalysed(const Array<ContentAnalyser::Result>& results) override;
+
+    /**
+     * Override of the importBatchReady method to add a batch of imported tracks with a single table update.
+     *
+     * @param results The probed tracks delivered by the FolderImporter.
+     */
+    void importBatchReady(const Array<TrackAnalyser::Result>& results) override;
+
+    /**
+     * Override of the importProgressChanged method to update the progress bar.
+     *
+     * @param numProbed The number of audio files probed.
+     * @param numFound  The number of audio files found so far.
+     */
+    void importProgressChanged(int numProbed, int numFound) override;
+
+    /**
+     * Override of the importFinished method to restore the import buttons.
+     *
+     * @param wasCancelled True if the user cancelled the import.
+     */
+    void importFinished(bool wasCancelled) override;
+
+private:
+    
+    /**
+     * Function to import music files and folders into the playlist in the background.
+     *
+     * @param filesOrFolders The files and folders to import. Folders are searched recursively.
+     */
+    void importFiles(const Array<juce::File>& filesOrFolders);
+
+    /**
+     * Function to swap the import buttons for the progress bar and cancel button while importing.
+     *
+     * @param isImporting True while an import is running.
+     */
+    void showImportProgress(bool isImporting);
+
+    /**
+     * Function to give a track an id, index it for search and duplicates, and append it to the playlist.
+     *
+     * @param track The track to append.
+     * @return False if a track with the same path is already in the playlist.
+     */
+    bool appendToPlaylist(const SoundTrack& track);
+
+    /**
+     * Function to delete a soundtrack from the playlist by its ID.
+     *
+     * @param id The stable ID of the soundtrack to be deleted.
+     */
+    void deleteMusic(juce::uint32 id);
+
+    /**
+     * Check whether the table shows visibleRows rather than the track store in playlist order.
+     *
+     * @return True while searching or sorting.
+     */
+    bool hasCustomRowOrder() const;
+
+    /**
+     * Map a table row to a row of the track store, taking the search filter and sort order into account.
+     *
+     * @param row The table row.
+     * @return    The index into trackStore, or -1 if the row does not exist.
+     */
+    int getTrackIndexForRow(int row) const;
+
+    /**
+     * Run the current search input against the search index, filter the table to the hits
+     * and sort them by the sort column.
+     */
+    void applySearch();
+
+    /**
+     * Sort rows of the track store by the sort column. Tracks not analysed yet go last
+     * in either direction, and ties keep their order.
+     *
+     * @param rows The rows to sort, in place.
+     */
+    void sortRows(std::vector<size_t>& rows) const;
+
+    /**
+     * Function to load a selected track into the specified DeckGUI.
+     *
+     * @param deckGUI Pointer to the DeckGUI instance where the track will be loaded.
+     */
+    void loadToSpecifiedPlayer(DeckGUI* deckGUI);
+
+    /**
+     * Function to get the key a music file is recognised by in the duplicate index.
+     * Links are resolved when a track is imported, so two stored URLs with the same key
+     * refer to the same file on disk. Never touches the file system.
+     *
+     * @param musicUrl The URL of the music file.
+     * @return The absolute path, lower-cased on file systems that ignore case.
+     */
+    static juce::String getNormalisedPath(const juce::String& musicUrl);
+
+    /**
+     * Function to register a probed content hash. If another track already has the same
+     * hash, the two files are queued to be compared in full; nothing is removed on the hash alone.
+     *
+     * @param index The row of the track in trackStore.
+     */
+    void registerContentHash(size_t index);
+
+    /**
+     * Callback function triggered when the user presses the "Enter" key in the search box.
+     *
+     * @param editor Reference to the TextEditor component.
+     */
+    void textEditorReturnKeyPressed(juce::TextEditor& editor) override;
+
+    /**
+     * Callback function triggered on every edit in the search box, filters the table as the user types.
+     *
+     * @param editor Reference to the TextEditor component.
+     */
+    void textEditorTextChanged(juce::TextEditor& editor) override;
+
+    /**
+     * Retrieve the length of a music track in minutes and seconds from its probed metadata.
+     *
+     * @param lengthInSeconds The probed length of the track.
+     * @return A pair representing the length in minutes and seconds.
+     */
+    std::pair<int, int> getMusicLength(double lengthInSeconds) const;
+
+    /**
+     * Determines whether the PlaylistComponent is interested in file drag events.
+     *
+     * @param files An array of file paths being dragged.
+     * @return true if interested in file drag events, false otherwise.
+     */
+    bool isInterestedInFileDrag(const StringArray& file) override;
+
+    /**
+     * Handles the event when files are dropped onto the PlaylistComponent.
+     *
+     * @param files An array of file paths that have been dropped.
+     * @param x The x-coordinate where the files were dropped.
+     * @param y The y-coordinate where the files were dropped.
+     */
+    void filesDropped(const StringArray& files, int x, int y) override;
+
+    /**
+     * Override of the buttonClicked method to handle button click events.
+     *
+     * @param button Pointer to the clicked button.
+     */
+    void buttonClicked(Button* button) override;
+
+    /**
+     * Function to clear all songs in the playlist component.
+     */
+    void clearPlaylist();
+
+    /**
+     * Function to save the current playlist and its track metadata to the library index.
+     */
+    void savePlaylistToFile();
+
+    /**
+     * Reads the library index and populates the PlaylistComponent.
+     * Stored metadata is shown straight away; only files that changed on disk are probed again.
+     * This method is called during the initialization of the PlaylistComponent.
+     */
+    void readExistingPlaylistData();
+
+    /**
+     * Imports the comma-separated CurrentPlaylist.txt written by older versions.
+     * Used only when no library index exists yet.
+     *
+     * @param tracks The vector that receives the imported tracks.
+     */
+    void readLegacyPlaylistData(std::vector<SoundTrack>& tracks);
+
+    /**
+     * Get the location of the binary library index.
+     *
+     * @return The library index file.
+     */
+    static juce::File getLibraryIndexFile();
+
+    /**
+     * Columnar store of every track in the playlist, rows are found by stable id
+     */
+    TrackStore trackStore;
+
+    /**
+     * Duplicate index: track ids by normalised path and by content hash
+     */
+    std::unordered_map<juce::String, juce::uint32> trackIdByPath;
+    std::unordered_map<juce::int64, juce::uint32> trackIdByContentHash;
+
+    /**
+     * Trigram index over the titles and folders of the playlist
+     */
+    TrackSearchIndex searchIndex;
+
+    /**
+     * Rows in trackStore in table order: the search hits, best first, while isFiltered is set,
+     * sorted by sortColumnId unless it is 0
+     */
+    std::vector<size_t> visibleRows;
+    bool isFiltered = false;
+    int sortColumnId = 0;
+    bool sortForwards = true;
+
+    /**
+     * AudioFormatManager reference
+     */
+    AudioFormatManager& formatManager;
+
+    /**
+     * SampleCache reference, shared with the players
+     */
+    SampleCache& sampleCache;
+
+    /**
+     * TableListBox for displaying the playlist
+     */
+    juce::TableListBox tableComponent;
+
+    /**
+     * Buttons for importing and loading tracks to Deck 1 and 2
+     */
+    juce::TextButton importTrackToLib{ "Import To Track Library" },
+                     importFolderBtn{ "Import Folder" },
+                     cancelImportBtn{ "Cancel Import" };
+    juce::TextButton loadBtn1{ "Load\nDeck1" },
+                     loadBtn2{ "Load\nDeck2" },
+                     clearPlaylistBtn{ "Clear" };
+
+    /**
+     * Text editor for searching tracks in the playlist
+     */
+    juce::TextEditor searchBox{ "Input Song Name: " };
+    juce::String searchBoxInput;
+
+    /**
+     * FileChooser for importing tracks
+     */
+    juce::FileChooser fChooser{ "Select the track..." };
+    juce::FileChooser folderChooser{ "Select a music folder..." };
+
+    /**
+     * Progress of the running import, -1 while only folders have been found, and the bar showing it
+     */
+    double importProgress = 0.0;
+    juce::ProgressBar importProgressBar{ importProgress };
+
+    /** 
+     * Pointer to the first DeckGUI instance
+     */
+    DeckGUI* deckGUI1;
+    /**
+     * Pointer to the second DeckGUI instance
+     */
+    DeckGUI* deckGUI2;
+
+    /**
+     * Background service that probes track durations off the message thread
+     */
+    TrackAnalyser trackAnalyser{ formatManager, *this };
+
+    /**
+     * Background service that detects tempos, beat grids, musical keys and loudness, decoding each track once
+     */
+    ContentAnalyser contentAnalyser{ formatManager, *this };
+
+    /**
+     * Background service that walks folders and probes imported files
+     */
+    FolderImporter folderImporter{ formatManager, *this };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PlaylistComponent)
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.cpp
+    Created: 24 Oct 2026 4:35:19pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "ProfilerOverlay.h"
+
+ProfilerOverlay::ProfilerOverlay(CallbackProfiler& _profiler) :
+    profiler(_profiler)
+{
+    addAndMakeVisible(resetBtn);
+    addAndMakeVisible(saveBtn);
+    resetBtn.addListener(this);
+    saveBtn.addListener(this);
+    resetBtn.setColour(TextButton::textColourOffId, Colours::orange);
+    saveBtn.setColour(TextButton::textColourOffId, Colours::deepskyblue);
+
+    // Clicks outside the buttons fall through to the decks underneath
+    setInterceptsMouseClicks(false, true);
+}
+
+ProfilerOverlay::~ProfilerOverlay()
+{
+    stopTimer();
+}
+
+void ProfilerOverlay::paint(Graphics& g)
+{
+    g.setColour(Colours::black.withAlpha(0.8f));
+    g.fillRoundedRectangle(getLocalBounds().toFloat(), 6.0f);
+
+    g.setColour(Colours::white);
+    g.setFont(Font(Font::getDefaultMonospacedFontName(), 13.0f, Font::plain));
+
+    auto area = getLocalBounds().reduced(8);
+    area.removeFromBottom(30);
+    const int lineHeight = 16;
+
+    for (const auto& line : StringArray::fromLines(report + status))
+    {
+        g.drawText(line, area.removeFromTop(lineHeight), Justification::centredLeft, false);
+    }
+}
+
+void ProfilerOverlay::resized()
+{
+    auto buttons = getLocalBounds().reduced(8).removeFromBottom(24);
+    saveBtn.setBounds(buttons.removeFromRight(80));
+    buttons.removeFromRight(8);
+    resetBtn.setBounds(buttons.removeFromRight(80));
+}
+
+void ProfilerOverlay::visibilityChanged()
+{
+    if (isVisible())
+    {
+        timerCallback();
+        startTimerHz(4);
+    }
+    else
+    {
+        stopTimer();
+    }
+}
+
+void ProfilerOverlay::buttonClicked(Button* button)
+{
+    if (button == &resetBtn)
+    {
+        profiler.reset();
+        status = {};
+    }
+    else if (button == &saveBtn)
+    {
+        const File file = getReportFile();
+        status = profiler.dumpToFile(file) ? "Saved to " + file.getFullPathName() : "Could not write " + file.getFullPathName();
+    }
+}
+
+File ProfilerOverlay::getReportFile()
+{
+    return File::getCurrentWorkingDirectory().getChildFile("CallbackProfile.txt");
+}
+
+void ProfilerOverlay::timerCallback()
+{
+    report = profiler.getReport();
+    repaint();
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    ProfilerOverlay.h
+    Created: 24 Oct 2026 4:35:19pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CallbackProfiler.h"
+
+/**
+ * The ProfilerOverlay class shows the audio callback timings of a CallbackProfiler
+ * on top of the decks, refreshed a few times a second.
+ *
+ * It only reads the profiler on the message thread. The Reset button clears the
+ * statistics and the Save button dumps the current report to CallbackProfile.txt.
+ */
+class ProfilerOverlay : public Component,
+                        public Button::Listener,
+                        private Timer
+{
+public:
+    /**
+     * Constructor for ProfilerOverlay.
+     *
+     * @param _profiler The profiler to show.
+     */
+    explicit ProfilerOverlay(CallbackProfiler& _profiler);
+
+    /**
+     * Destructor for ProfilerOverlay.
+     */
+    ~ProfilerOverlay() override;
+
+    /**
+     * Override of the paint method to draw the report.
+     *
+     * @param g Graphics context for performing drawing operations.
+     */
+    void paint(Graphics& g) override;
+
+    /**
+     * Override of the resized method to place the buttons.
+     */
+    void resized() override;
+
+    /**
+     * Override of the visibilityChanged method to refresh only while the overlay is shown.
+     */
+    void visibilityChanged() override;
+
+    /**
+     * Override of the buttonClicked method to reset or save the statistics.
+     *
+     * @param button Pointer to the clicked button.
+     */
+    void buttonClicked(Button* button) override;
+
+    /**
+     * Get the file the Save button writes.
+     *
+     * @return The report file in the working directory.
+     */
+    static File getReportFile();
+
+private:
+    /**
+     * Read the latest report and repaint.
+     */
+    void timerCallback() override;
+
+    /**
+     * The profiler being shown
+     */
+    CallbackProfiler& profiler;
+
+    /**
+     * The report as of the last refresh, and the result of the last save
+     */
+    String report;
+    String status;
+
+    /**
+     * Buttons to clear the statistics and write them to a file
+     */
+    TextButton resetBtn{ "Reset" }, saveBtn{ "Save" };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProfilerOverlay)
+};
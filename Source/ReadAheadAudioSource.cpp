@@ -0,0 +1,32 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.cpp
+    Created: 17 Oct 2026 1:24:10pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "ReadAheadAudioSource.h"
+
+ReadAheadAudioSource::ReadAheadAudioSource(PositionableAudioSource* source,
+                                           TimeSliceThread& backgroundThread,
+                                           int numSamplesToBuffer,
+                                           int numChannels,
+                                           std::atomic<int>& _underrunCount)
+    : BufferingAudioSource(source, backgroundThread, false, numSamplesToBuffer, numChannels),
+      underrunCount(_underrunCount)
+{
+}
+
+void ReadAheadAudioSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    // A zero timeout only checks whether the block is already buffered, it never blocks
+    if (!waitForNextAudioBlockReady(bufferToFill, 0))
+    {
+        underrunCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    BufferingAudioSource::getNextAudioBlock(bufferToFill);
+}
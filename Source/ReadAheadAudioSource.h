@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    ReadAheadAudioSource.h
+    Created: 17 Oct 2026 1:24:10pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The ReadAheadAudioSource class is a BufferingAudioSource that counts underruns.
+ *
+ * A background TimeSliceThread keeps the buffer filled from the wrapped source,
+ * so the audio thread never waits on the disk or the decoder. Whenever a block is
+ * requested before the background thread has buffered it, silence is played and
+ * the shared underrun counter is incremented.
+ */
+class ReadAheadAudioSource : public BufferingAudioSource
+{
+public:
+    /**
+     * Constructor for ReadAheadAudioSource.
+     *
+     * @param source             The source to read ahead from. Not owned.
+     * @param backgroundThread   The thread that fills the buffer.
+     * @param numSamplesToBuffer The size of the read-ahead buffer in samples.
+     * @param numChannels        The number of channels to buffer.
+     * @param _underrunCount     Counter incremented every time a block is not ready in time.
+     */
+    ReadAheadAudioSource(PositionableAudioSource* source,
+        TimeSliceThread& backgroundThread,
+        int numSamplesToBuffer,
+        int numChannels,
+        std::atomic<int>& _underrunCount);
+
+    /**
+     * Override of the getNextAudioBlock method to count blocks that were not buffered in time.
+     *
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+private:
+    /**
+     * Counter shared with the owning player.
+     */
+    std::atomic<int>& underrunCount;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ReadAheadAudioSource)
+};
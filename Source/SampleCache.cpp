@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    SampleCache.cpp
+    Created: 17 Oct 2026 4:15:02pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "SampleCache.h"
+
+SampleCache::SampleCache(AudioFormatManager& _formatManager, juce::int64 memoryBudgetBytes)
+    : formatManager(_formatManager),
+      memoryBudget(memoryBudgetBytes)
+{
+}
+
+SampleCache::~SampleCache()
+{
+    preloadPool.removeAllJobs(true, 10000);
+}
+
+std::shared_ptr<SampleCache::Sample> SampleCache::getOrDecode(const URL& audioURL)
+{
+    {
+        const ScopedLock sl(lock);
+
+        if (auto sample = findLocked(audioURL.toString(false)))
+        {
+            ++numHits;
+            return sample;
+        }
+    }
+
+    ++numMisses;
+    return decodeAndInsert(audioURL);
+}
+
+void SampleCache::preload(const URL& audioURL)
+{
+    {
+        const ScopedLock sl(lock);
+
+        const juce::String key = audioURL.toString(false);
+
+        if (lookup.find(key) != lookup.end() || inFlight.find(key) != inFlight.end())
+            return;
+    }
+
+    preloadPool.addJob([this, audioURL]
+        {
+            decodeAndInsert(audioURL);
+        });
+}
+
+void SampleCache::setMemoryBudget(juce::int64 memoryBudgetBytes)
+{
+    const ScopedLock sl(lock);
+    memoryBudget = memoryBudgetBytes;
+    evictLocked();
+}
+
+juce::int64 SampleCache::getMemoryBudget() const
+{
+    const ScopedLock sl(lock);
+    return memoryBudget;
+}
+
+juce::int64 SampleCache::getResidentBytes() const
+{
+    const ScopedLock sl(lock);
+    return residentBytes;
+}
+
+double SampleCache::getHitRate() const
+{
+    const auto hits = numHits.load();
+    const auto total = hits + numMisses.load();
+
+    return total > 0 ? static_cast<double>(hits) / static_cast<double>(total) : 0.0;
+}
+
+std::shared_ptr<SampleCache::Sample> SampleCache::findLocked(const juce::String& key)
+{
+    auto found = lookup.find(key);
+
+    if (found == lookup.end())
+        return nullptr;
+
+    // Move to the front of the LRU list
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->sample;
+}
+
+std::shared_ptr<SampleCache::Sample> SampleCache::decodeAndInsert(const URL& audioURL)
+{
+    const juce::String key = audioURL.toString(false);
+    std::promise<std::shared_ptr<Sample>> result;
+
+    {
+        const ScopedLock sl(lock);
+
+        // Another thread may have decoded it since the caller looked
+        if (auto sample = findLocked(key))
+            return sample;
+
+        auto pending = inFlight.find(key);
+
+        if (pending != inFlight.end())
+        {
+            // Wait for the thread already decoding it, outside the lock
+            auto decoding = pending->second;
+            const ScopedUnlock su(lock);
+            return decoding.get();
+        }
+
+        inFlight.emplace(key, result.get_future().share());
+    }
+
+    auto sample = decode(audioURL, key);
+
+    {
+        const ScopedLock sl(lock);
+
+        if (sample != nullptr)
+        {
+            const juce::int64 numBytes = static_cast<juce::int64>(sample->buffer.getNumChannels())
+                                         * sample->buffer.getNumSamples() * (juce::int64) sizeof(float);
+
+            entries.push_front(Entry{ key, sample, numBytes });
+            lookup[key] = entries.begin();
+            residentBytes += numBytes;
+            evictLocked();
+        }
+
+        inFlight.erase(key);
+    }
+
+    result.set_value(sample);
+    return sample;
+}
+
+std::shared_ptr<SampleCache::Sample> SampleCache::decode(const URL& audioURL, const juce::String& key)
+{
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(audioURL.createInputStream(false)));
+
+    if (reader == nullptr || reader->lengthInSamples <= 0
+        || reader->lengthInSamples > std::numeric_limits<int>::max())
+        return nullptr;
+
+    const int numChannels = jmax(2, static_cast<int>(reader->numChannels));
+    const int numSamples = static_cast<int>(reader->lengthInSamples);
+    const juce::int64 numBytes = static_cast<juce::int64>(numChannels) * numSamples * (juce::int64) sizeof(float);
+
+    if (numBytes > getMemoryBudget())
+    {
+        DBG("SampleCache: " << key << " is larger than the memory budget");
+        return nullptr;
+    }
+
+    auto sample = std::make_shared<Sample>();
+    sample->sampleRate = reader->sampleRate;
+    sample->buffer.setSize(numChannels, numSamples);
+
+    // Reading with both reader channels enabled copies mono into both outputs
+    reader->read(&sample->buffer, 0, numSamples, 0, true, true);
+
+    return sample;
+}
+
+void SampleCache::evictLocked()
+{
+    while (residentBytes > memoryBudget && !entries.empty())
+    {
+        const Entry& oldest = entries.back();
+        residentBytes -= oldest.numBytes;
+        lookup.erase(oldest.key);
+        entries.pop_back();
+    }
+}
@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+    SampleCache.h
+    Created: 17 Oct 2026 4:15:02pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <future>
+#include <list>
+#include <unordered_map>
+
+/**
+ * The SampleCache class keeps fully decoded tracks in RAM, shared by both decks.
+ *
+ * Tracks are decoded on demand by a deck in RAM-resident mode, or ahead of time
+ * by preload() when they are queued in the playlist. Resident tracks are kept in
+ * least-recently-used order and evicted once the memory budget is exceeded. A deck
+ * keeps its shared reference, so an evicted track stays playable until unloaded.
+ */
+class SampleCache
+{
+public:
+    /**
+     * A decoded track. Mono files are decoded to two identical channels.
+     */
+    struct Sample
+    {
+        AudioBuffer<float> buffer;
+        double sampleRate = 0.0;
+    };
+
+    /**
+     * Constructor for SampleCache.
+     *
+     * @param _formatManager     Reference to the AudioFormatManager used to decode tracks.
+     * @param memoryBudgetBytes  The maximum number of bytes of decoded audio to keep resident.
+     */
+    SampleCache(AudioFormatManager& _formatManager, juce::int64 memoryBudgetBytes);
+
+    /**
+     * Destructor for SampleCache. Waits for the preload in progress, if any.
+     */
+    ~SampleCache();
+
+    /**
+     * Get a decoded track, decoding it on the calling thread if it is not resident.
+     *
+     * @param audioURL The URL of the track.
+     * @return         The decoded track, or nullptr if it cannot be read or is larger than the budget.
+     */
+    std::shared_ptr<Sample> getOrDecode(const URL& audioURL);
+
+    /**
+     * Decode a track on the background preload thread if it is not resident yet.
+     *
+     * @param audioURL The URL of the track.
+     */
+    void preload(const URL& audioURL);
+
+    /**
+     * Change the memory budget, evicting tracks if the new budget is smaller.
+     *
+     * @param memoryBudgetBytes The maximum number of bytes of decoded audio to keep resident.
+     */
+    void setMemoryBudget(juce::int64 memoryBudgetBytes);
+
+    /**
+     * Get the memory budget.
+     * @return The maximum number of bytes of decoded audio kept resident.
+     */
+    juce::int64 getMemoryBudget() const;
+
+    /**
+     * Get the number of bytes of decoded audio currently resident.
+     * @return The resident bytes.
+     */
+    juce::int64 getResidentBytes() const;
+
+    /**
+     * Get the fraction of getOrDecode() calls that were served without decoding.
+     * @return The hit rate between 0 and 1, or 0 if nothing has been requested yet.
+     */
+    double getHitRate() const;
+
+private:
+    struct Entry
+    {
+        juce::String key;
+        std::shared_ptr<Sample> sample;
+        juce::int64 numBytes = 0;
+    };
+
+    /**
+     * Look up a resident track and mark it as most recently used. Caller holds lock.
+     */
+    std::shared_ptr<Sample> findLocked(const juce::String& key);
+
+    /**
+     * Decode a track and make it resident, unless it already is. If another thread
+     * is already decoding the same track, waits for that decode instead.
+     */
+    std::shared_ptr<Sample> decodeAndInsert(const URL& audioURL);
+
+    /**
+     * Decode a whole track without holding any lock.
+     */
+    std::shared_ptr<Sample> decode(const URL& audioURL, const juce::String& key);
+
+    /**
+     * Evict least recently used tracks until the resident size fits the budget. Caller holds lock.
+     */
+    void evictLocked();
+
+    AudioFormatManager& formatManager;
+
+    /**
+     * Guards entries, lookup, inFlight, residentBytes and memoryBudget.
+     * Never held while decoding.
+     */
+    CriticalSection lock;
+
+    /**
+     * Tracks being decoded right now, so a track requested twice is decoded once
+     * while different tracks decode in parallel.
+     */
+    std::unordered_map<juce::String, std::shared_future<std::shared_ptr<Sample>>> inFlight;
+
+    /**
+     * Resident tracks, most recently used first.
+     */
+    std::list<Entry> entries;
+    std::unordered_map<juce::String, std::list<Entry>::iterator> lookup;
+
+    juce::int64 residentBytes = 0;
+    juce::int64 memoryBudget;
+
+    std::atomic<juce::int64> numHits{ 0 };
+    std::atomic<juce::int64> numMisses{ 0 };
+
+    /**
+     * Single background thread that decodes queued tracks.
+     */
+    ThreadPool preloadPool{ 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SampleCache)
+};
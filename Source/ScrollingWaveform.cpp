@@ -0,0 +1,211 @@
+/*
+  ==============================================================================
+
+    ScrollingWaveform.cpp
+    Created: 20 Oct 2026 9:18:52am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "ScrollingWaveform.h"
+
+//==============================================================================
+ScrollingWaveform::ScrollingWaveform(WaveformCache& cacheToUse, bool isDeck1) :
+    waveformCache(cacheToUse),
+    isDeck1(isDeck1)
+{
+    setOpaque(true);
+    waveformCache.addListener(this);
+}
+
+ScrollingWaveform::~ScrollingWaveform()
+{
+    waveformCache.removeListener(this);
+}
+
+void ScrollingWaveform::paint(juce::Graphics& g)
+{
+    const juce::int64 startTicks = Time::getHighResolutionTicks();
+
+    g.fillAll(Colours::black);
+
+    const int centreX = getWidth() / 2;
+
+    if (overview != nullptr)
+    {
+        // The track pixel under the left edge, tiles are placed relative to it
+        const juce::int64 leftPixel = playheadPixel - centreX;
+        const juce::int64 firstTile = leftPixel >= 0 ? leftPixel / tileWidth : (leftPixel - tileWidth + 1) / tileWidth;
+        const juce::int64 lastTile = (leftPixel + getWidth() - 1) / tileWidth;
+        const juce::int64 numTiles = static_cast<juce::int64>(std::ceil(
+            overview->getLengthInSeconds() * getPixelsPerSecond() / tileWidth));
+
+        for (juce::int64 tileIndex = jmax<juce::int64>(0, firstTile); tileIndex <= lastTile && tileIndex < numTiles; ++tileIndex)
+        {
+            g.drawImageAt(getTile(tileIndex), static_cast<int>(tileIndex * tileWidth - leftPixel), 0);
+        }
+
+        // Keep only the tiles in view and their neighbours
+        for (auto it = tiles.begin(); it != tiles.end();)
+        {
+            if (it->first < firstTile - 1 || it->first > lastTile + 1)
+                it = tiles.erase(it);
+            else
+                ++it;
+        }
+    }
+    else
+    {
+        g.setColour(isDeck1 ? Colours::orange.withAlpha(0.5f) : Colours::deepskyblue.withAlpha(0.7f));
+        g.setFont(Font(14.0f).withTypefaceStyle("Bold"));
+        g.drawText(currentURL.isEmpty() ? "" : "Loading waveform...", getLocalBounds(),
+            juce::Justification::centred, true);
+    }
+
+    // Playhead overlay
+    g.setColour(Colours::white);
+    g.fillRect(centreX - 1, 0, 2, getHeight());
+
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds(), 1);
+
+    const double micros = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - startTicks) * 1.0e6;
+    averagePaintMicroseconds += (micros - averagePaintMicroseconds) * 0.1;
+}
+
+void ScrollingWaveform::resized()
+{
+    invalidateTiles();
+    playheadPixel = static_cast<juce::int64>(playheadSeconds * getPixelsPerSecond());
+}
+
+void ScrollingWaveform::mouseWheelMove(const MouseEvent&, const MouseWheelDetails& wheel)
+{
+    // Scrolling up zooms in
+    setVisibleSeconds(visibleSeconds * std::pow(2.0, -wheel.deltaY * 2.0));
+}
+
+void ScrollingWaveform::loadURL(URL audioURL)
+{
+    currentURL = audioURL;
+    setOverview(nullptr);
+
+    waveformCache.request(audioURL);
+}
+
+void ScrollingWaveform::waveformReady(const URL& audioURL, std::shared_ptr<const WaveformCache::Overview> newOverview)
+{
+    // The cache is shared by both decks, ignore overviews of the other deck's track
+    if (audioURL == currentURL)
+        setOverview(std::move(newOverview));
+}
+
+void ScrollingWaveform::setOverview(std::shared_ptr<const WaveformCache::Overview> newOverview)
+{
+    overview = std::move(newOverview);
+    invalidateTiles();
+    repaint();
+}
+
+void ScrollingWaveform::setPlayheadSeconds(double seconds)
+{
+    playheadSeconds = seconds;
+    const auto newPixel = static_cast<juce::int64>(seconds * getPixelsPerSecond());
+
+    if (newPixel != playheadPixel)
+    {
+        playheadPixel = newPixel;
+        repaint();
+    }
+}
+
+void ScrollingWaveform::setVisibleSeconds(double seconds)
+{
+    seconds = jlimit(1.0, 60.0, seconds);
+
+    if (seconds != visibleSeconds)
+    {
+        visibleSeconds = seconds;
+        invalidateTiles();
+        playheadPixel = static_cast<juce::int64>(playheadSeconds * getPixelsPerSecond());
+        repaint();
+    }
+}
+
+double ScrollingWaveform::getVisibleSeconds() const
+{
+    return visibleSeconds;
+}
+
+void ScrollingWaveform::invalidateTiles()
+{
+    tiles.clear();
+}
+
+double ScrollingWaveform::getAveragePaintMicroseconds() const
+{
+    return averagePaintMicroseconds;
+}
+
+const Image& ScrollingWaveform::getTile(juce::int64 tileIndex)
+{
+    auto it = tiles.find(tileIndex);
+
+    if (it == tiles.end())
+    {
+        Image tile(Image::RGB, tileWidth, jmax(1, getHeight()), true);
+        renderTile(tile, tileIndex);
+        it = tiles.emplace(tileIndex, tile).first;
+    }
+
+    return it->second;
+}
+
+void ScrollingWaveform::renderTile(Image& tile, juce::int64 tileIndex) const
+{
+    Graphics g(tile);
+
+    const double samplesPerPixel = overview->sampleRate / getPixelsPerSecond();
+    const auto* level = overview->getLevelFor(samplesPerPixel);
+
+    if (level == nullptr)
+        return;
+
+    const float midY = tile.getHeight() * 0.5f;
+    const float scale = midY / 127.0f;
+    const auto numPeaks = static_cast<juce::int64>(level->peaks.size());
+
+    for (int x = 0; x < tileWidth; ++x)
+    {
+        const double firstSample = (tileIndex * tileWidth + x) * samplesPerPixel;
+        const juce::int64 first = static_cast<juce::int64>(firstSample / level->samplesPerPeak);
+        const juce::int64 last = jmin(numPeaks, jmax(first + 1,
+            static_cast<juce::int64>((firstSample + samplesPerPixel) / level->samplesPerPeak)));
+
+        if (first >= numPeaks)
+            break;
+
+        int minimum = 0, maximum = 0, low = 0, mid = 0, high = 0;
+
+        for (juce::int64 i = first; i < last; ++i)
+        {
+            const auto& peak = level->peaks[(size_t) i];
+            minimum = jmin(minimum, (int) peak.minimum);
+            maximum = jmax(maximum, (int) peak.maximum);
+            low = jmax(low, (int) peak.low);
+            mid = jmax(mid, (int) peak.mid);
+            high = jmax(high, (int) peak.high);
+        }
+
+        // The loudest band sets the hue, bass-heavy columns are red and hi-hats are blue
+        const float strongest = static_cast<float>(jmax(1, low, mid, high));
+        g.setColour(Colour::fromFloatRGBA(low / strongest, mid / strongest, high / strongest, 1.0f));
+        g.drawVerticalLine(x, midY - maximum * scale, midY - minimum * scale + 1.0f);
+    }
+}
+
+double ScrollingWaveform::getPixelsPerSecond() const
+{
+    return jmax(1, getWidth()) / visibleSeconds;
+}
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    ScrollingWaveform.h
+    Created: 20 Oct 2026 9:18:52am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <map>
+#include "WaveformCache.h"
+
+//==============================================================================
+/**
+ * The ScrollingWaveform class shows a zoomed waveform that scrolls past a
+ * fixed playhead in the middle of the component.
+ *
+ * The waveform is rendered once into tiles of tileWidth pixels, coloured by the
+ * low (red), mid (green) and high (blue) band levels of the overview. Each frame
+ * only blits the tiles in view at the new offset and draws the playhead, so a
+ * tile is rendered when it scrolls into view and never again until the zoom or
+ * the size changes. The mouse wheel zooms.
+ */
+class ScrollingWaveform : public juce::Component,
+                          public WaveformCache::Listener
+{
+public:
+    /**
+     * Constructor for ScrollingWaveform.
+     *
+     * @param cacheToUse Reference to the WaveformCache providing the overviews.
+     * @param isDeck1    True if the view belongs to Deck 1.
+     */
+    ScrollingWaveform(WaveformCache& cacheToUse, bool isDeck1);
+
+    /**
+     * Destructor for ScrollingWaveform.
+     */
+    ~ScrollingWaveform() override;
+
+    /**
+     * Blits the visible tiles and draws the playhead.
+     *
+     * @param g The Graphics object used for rendering.
+     */
+    void paint(juce::Graphics& g) override;
+
+    /**
+     * Called when the size of the ScrollingWaveform is changed. Drops the tiles.
+     */
+    void resized() override;
+
+    /**
+     * Zoom in or out with the mouse wheel.
+     *
+     * @param event The mouse event.
+     * @param wheel The wheel movement.
+     */
+    void mouseWheelMove(const MouseEvent& event, const MouseWheelDetails& wheel) override;
+
+    /**
+     * Show the waveform of a track once its overview is ready.
+     *
+     * @param audioURL The URL of the audio file.
+     */
+    void loadURL(URL audioURL);
+
+    /**
+     * Callback function for overviews finished by the waveform cache.
+     *
+     * @param audioURL    The URL the overview belongs to.
+     * @param newOverview The overview of that track.
+     */
+    void waveformReady(const URL& audioURL, std::shared_ptr<const WaveformCache::Overview> newOverview) override;
+
+    /**
+     * Show an overview directly, without going through the cache.
+     *
+     * @param newOverview The overview to draw.
+     */
+    void setOverview(std::shared_ptr<const WaveformCache::Overview> newOverview);
+
+    /**
+     * Move the waveform under the playhead. Repaints only when it moves by at least a pixel.
+     *
+     * @param seconds The playhead position in seconds.
+     */
+    void setPlayheadSeconds(double seconds);
+
+    /**
+     * Set the zoom.
+     *
+     * @param seconds The length of audio visible across the width, between 1 and 60 seconds.
+     */
+    void setVisibleSeconds(double seconds);
+
+    /**
+     * Get the zoom.
+     *
+     * @return The length of audio visible across the width in seconds.
+     */
+    double getVisibleSeconds() const;
+
+    /**
+     * Drop every rendered tile so the next paint renders them again.
+     */
+    void invalidateTiles();
+
+    /**
+     * Get the smoothed time spent in paint().
+     *
+     * @return The average paint time in microseconds.
+     */
+    double getAveragePaintMicroseconds() const;
+
+    /**
+     * The width of a tile in pixels.
+     */
+    static constexpr int tileWidth = 256;
+
+private:
+    /**
+     * Get a tile, rendering it first if it is not cached.
+     *
+     * @param tileIndex The tile index, counted in tileWidth steps from the start of the track.
+     * @return          The rendered tile.
+     */
+    const Image& getTile(juce::int64 tileIndex);
+
+    /**
+     * Draw the waveform columns of one tile.
+     *
+     * @param tile      The image to draw into.
+     * @param tileIndex The index of the tile.
+     */
+    void renderTile(Image& tile, juce::int64 tileIndex) const;
+
+    /**
+     * Get the zoom as a scale.
+     *
+     * @return The number of pixels per second of audio.
+     */
+    double getPixelsPerSecond() const;
+
+    WaveformCache& waveformCache;
+    URL currentURL;
+    std::shared_ptr<const WaveformCache::Overview> overview;
+    bool isDeck1;
+
+    double playheadSeconds = 0.0;
+    juce::int64 playheadPixel = 0;
+    double visibleSeconds = 8.0;
+
+    /**
+     * Rendered tiles by index. Tiles that leave the view are dropped after each paint.
+     */
+    std::map<juce::int64, Image> tiles;
+
+    double averagePaintMicroseconds = 0.0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScrollingWaveform)
+};
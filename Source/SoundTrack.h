@@ -1,36 +1,81 @@
-/*
-  ==============================================================================
-
-    SoundTrack.h
-    Created: 16 Feb 2024 11:58:46am
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-class SoundTrack
-{
-public:
-    /**
-     * Constructor to initialize the SoundTrack with a name and URL.
-     *
-     * @param musicName The name of the music track.
-     * @param musicUrl The URL of the music track.
-     */
-    SoundTrack(juce::String _MusicName, juce::String _MusicUrl);
-
-    /**
-     * Destructor.
-     */
-    ~SoundTrack();
-
-    /**
-     * Public member variables to store the music name and URL
-     */
-    juce::String MusicName;
-    juce::String MusicUrl;
+/*
+  ==============================================================================
+
+    SoundTrack.h
+    Created: 16 Feb 2024 11:58:46am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+class SoundTrack
+{
+public:
+    /**
+     * Constructor to initialize the SoundTrack with a name and URL.
+     *
+     * @param musicName The name of the music track.
+     * @param musicUrl The URL of the music track.
+     */
+    SoundTrack(juce::String _MusicName, juce::String _MusicUrl);
+
+    /**
+     * Destructor.
+     */
+    ~SoundTrack();
+
+    /**
+     * Public member variables to store the music name and URL
+     */
+    juce::String MusicName;
+    juce::String MusicUrl;
+
+    /**
+     * Metadata filled in by the TrackAnalyser once the file has been probed,
+     * persisted in the library index so it survives restarts
+     */
+    double LengthInSeconds = 0.0;
+    double SampleRate = 0.0;
+    int NumChannels = 0;
+    juce::int64 FileSize = 0;
+    juce::int64 ModificationTime = 0;
+    juce::int64 ContentHash = 0;
+    bool IsAnalysed = false;
+
+    /**
+     * Beat grid filled in by the ContentAnalyser: the tempo, 0 until analysed, and the
+     * time of the first downbeat. Beats fall every 60 / Bpm seconds from there on.
+     */
+    double Bpm = 0.0;
+    double FirstBeatSeconds = 0.0;
+
+    /**
+     * Musical key filled in by the ContentAnalyser: 0 to 11 for the major keys from C,
+     * 12 to 23 for the minor keys from C minor, -1 until analysed
+     */
+    int MusicalKey = -1;
+
+    /**
+     * Loudness filled in by the ContentAnalyser: the integrated loudness in LUFS and
+     * the true peak in dBTP, valid once HasLoudness is set
+     */
+    double LoudnessLufs = 0.0;
+    double TruePeakDb = 0.0;
+    bool HasLoudness = false;
+
+    /**
+     * The ModificationTime of the file when the ContentAnalyser last finished it, 0 if it
+     * never has. Set even when no beat, key or loudness was found, so such tracks are not
+     * decoded again until the file changes.
+     */
+    juce::int64 ContentAnalysedTime = 0;
+
+    /**
+     * Stable id assigned when the track joins the playlist, not persisted
+     */
+    juce::uint32 Id = 0;
 };
\ No newline at end of file
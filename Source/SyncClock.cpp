@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    SyncClock.cpp
+    Created: 25 Oct 2026 2:21:08pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "SyncClock.h"
+
+void SyncClock::publish(int deck, juce::int64 startSample, juce::int64 endSample,
+                        double beatPosition, double beatsPerSample) noexcept
+{
+    const int master = masterDeck.load(std::memory_order_relaxed);
+
+    // A master that played through the previous block has published up to at least our start
+    if (master != deck && master >= 0 && masterEndSample.load(std::memory_order_relaxed) >= startSample)
+        return;
+
+    masterBeatPosition.store(beatPosition, std::memory_order_relaxed);
+    masterBeatsPerSample.store(beatsPerSample, std::memory_order_relaxed);
+    masterEndSample.store(endSample, std::memory_order_relaxed);
+    masterDeck.store(deck, std::memory_order_relaxed);
+}
+
+void SyncClock::release(int deck) noexcept
+{
+    int master = deck;
+    masterDeck.compare_exchange_strong(master, -1, std::memory_order_relaxed);
+}
+
+bool SyncClock::getMasterBeat(int deck, juce::int64 sampleTime, double& beatPosition, double& beatsPerSample) const noexcept
+{
+    const int master = masterDeck.load(std::memory_order_relaxed);
+    const juce::int64 endSample = masterEndSample.load(std::memory_order_relaxed);
+
+    if (master < 0 || master == deck || endSample < sampleTime)
+        return false;
+
+    // The master has rendered this block already, or is about to: either way it moves at a steady rate
+    beatsPerSample = masterBeatsPerSample.load(std::memory_order_relaxed);
+    beatPosition = masterBeatPosition.load(std::memory_order_relaxed) - (endSample - sampleTime) * beatsPerSample;
+    return true;
+}
+
+int SyncClock::getMasterDeck() const noexcept
+{
+    return masterDeck.load(std::memory_order_relaxed);
+}
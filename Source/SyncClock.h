@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    SyncClock.h
+    Created: 25 Oct 2026 2:21:08pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The SyncClock class is the shared master clock that synced decks follow.
+ *
+ * The master is the first deck that plays with a beat grid and without SYNC.
+ * At the end of every block it publishes where it is on its grid, in beats, and
+ * how many beats it moves per output sample. A synced deck reads the clock at the
+ * start of its own block and extrapolates the master to that exact sample, so
+ * tempo and phase are matched sample-accurately whichever deck renders first.
+ *
+ * Time is counted in output samples rendered by each deck. Decks must therefore be
+ * rendered in lockstep on the same audio thread, as the DeckMixer does.
+ */
+class SyncClock
+{
+public:
+    /**
+     * Publish the position of a deck playing without SYNC. The deck becomes the master
+     * if there is none, or if the master did not play through the previous block.
+     * Called on the audio thread at the end of every block.
+     *
+     * @param deck           The deck publishing.
+     * @param startSample    The deck's sample time at the start of the block.
+     * @param endSample      The deck's sample time at the end of the block.
+     * @param beatPosition   The deck's position on its grid at the end of the block, in beats.
+     * @param beatsPerSample The number of beats the deck moves per output sample.
+     */
+    void publish(int deck, juce::int64 startSample, juce::int64 endSample,
+                 double beatPosition, double beatsPerSample) noexcept;
+
+    /**
+     * Give up the master role, if the deck holds it. Called on the audio thread when
+     * the master stops, loses its beat grid or turns SYNC on.
+     *
+     * @param deck The deck releasing the clock.
+     */
+    void release(int deck) noexcept;
+
+    /**
+     * Get the position of the master at a sample time. Called on the audio thread.
+     *
+     * @param deck           The deck asking, which is never its own master.
+     * @param sampleTime     The sample time of the deck asking.
+     * @param beatPosition   Receives the master's position on its grid, in beats.
+     * @param beatsPerSample Receives the number of beats the master moves per output sample.
+     * @return               False if no other deck is playing as the master.
+     */
+    bool getMasterBeat(int deck, juce::int64 sampleTime, double& beatPosition, double& beatsPerSample) const noexcept;
+
+    /**
+     * Get the deck holding the master role.
+     *
+     * @return The deck, or -1 if there is no master.
+     */
+    int getMasterDeck() const noexcept;
+
+private:
+    std::atomic<int> masterDeck{ -1 };
+    std::atomic<juce::int64> masterEndSample{ 0 };
+    std::atomic<double> masterBeatPosition{ 0.0 };
+    std::atomic<double> masterBeatsPerSample{ 0.0 };
+};
@@ -0,0 +1,241 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.cpp
+    Created: 18 Oct 2026 2:31:08pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "TimeStretcher.h"
+
+namespace
+{
+    // Number of samples compared when scoring a candidate frame
+    constexpr int correlationLength = 256;
+}
+
+TimeStretcher::TimeStretcher(AudioSource* _input)
+    : input(_input)
+{
+    window.allocate(frameSize, false);
+
+    for (int i = 0; i < frameSize; ++i)
+    {
+        window[i] = 0.5f - 0.5f * std::cos(MathConstants<float>::twoPi * i / frameSize);
+    }
+}
+
+TimeStretcher::~TimeStretcher()
+{
+}
+
+void TimeStretcher::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    const int maxBlockSize = jmax(1, samplesPerBlockExpected);
+
+    // Pull input in chunks no larger than the resampler does, so both stages can share an input
+    inputChunkSize = static_cast<int>(std::ceil(maxBlockSize * maxTempo));
+    input->prepareToPlay(inputChunkSize, sampleRate);
+
+    const int maxAnalysisHop = static_cast<int>(std::ceil(synthesisHop * maxTempo));
+    inputBuffer.setSize(2, frameSize + 2 * searchTolerance + maxAnalysisHop + 16);
+    overlapBuffer.setSize(2, frameSize);
+    outputBuffer.setSize(2, maxBlockSize + synthesisHop);
+
+    reset();
+}
+
+void TimeStretcher::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    const int numChannels = jmin(2, bufferToFill.buffer->getNumChannels());
+    const int maxChunk = outputBuffer.getNumSamples() - synthesisHop;
+
+    for (int done = 0; done < bufferToFill.numSamples; )
+    {
+        const int numSamples = jmin(maxChunk, bufferToFill.numSamples - done);
+
+        while (numOutputSamples < numSamples)
+        {
+            processFrame();
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            bufferToFill.buffer->copyFrom(channel, bufferToFill.startSample + done, outputBuffer, channel, 0, numSamples);
+        }
+
+        // Keep the remainder for the next block
+        numOutputSamples -= numSamples;
+
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            float* data = outputBuffer.getWritePointer(channel);
+            std::memmove(data, data + numSamples, sizeof(float) * (size_t) numOutputSamples);
+        }
+
+        done += numSamples;
+    }
+
+    for (int channel = numChannels; channel < bufferToFill.buffer->getNumChannels(); ++channel)
+    {
+        bufferToFill.buffer->clear(channel, bufferToFill.startSample, bufferToFill.numSamples);
+    }
+}
+
+void TimeStretcher::releaseResources()
+{
+    input->releaseResources();
+    inputBuffer.setSize(2, 0);
+    overlapBuffer.setSize(2, 0);
+    outputBuffer.setSize(2, 0);
+}
+
+void TimeStretcher::setTempo(double newTempo)
+{
+    jassert(newTempo > 0.0);
+    tempo = jlimit(0.0001, maxTempo, newTempo);
+}
+
+double TimeStretcher::getTempo() const
+{
+    return tempo;
+}
+
+void TimeStretcher::reset() noexcept
+{
+    inputStart = 0;
+    numInputSamples = 0;
+    analysisPos = 0.0;
+    previousFrameStart = 0;
+    hasPreviousFrame = false;
+    numOutputSamples = 0;
+    overlapBuffer.clear();
+}
+
+double TimeStretcher::getLatencySamples() const noexcept
+{
+    if (!hasPreviousFrame)
+        return 0.0;
+
+    // The newest finished hop was read straight from the last frame, older hops were one tempo step per sample apart
+    const int newerSamples = synthesisHop - numOutputSamples;
+    const double nextOutputPosition = newerSamples >= 0
+        ? static_cast<double>(previousFrameStart + newerSamples)
+        : previousFrameStart + newerSamples * tempo.load(std::memory_order_relaxed);
+
+    return static_cast<double>(inputStart + numInputSamples) - nextOutputPosition;
+}
+
+void TimeStretcher::processFrame() noexcept
+{
+    const int64 nominal = static_cast<int64>(analysisPos);
+    const int64 target = previousFrameStart + synthesisHop;
+
+    int64 requiredEnd = nominal + searchTolerance + frameSize;
+
+    if (hasPreviousFrame)
+    {
+        requiredEnd = jmax(requiredEnd, target + correlationLength);
+    }
+
+    fillInput(requiredEnd);
+
+    const int64 chosen = hasPreviousFrame ? findBestMatch(nominal, target) : nominal;
+    const int offset = static_cast<int>(chosen - inputStart);
+
+    // Overlap-add the windowed frame
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        FloatVectorOperations::addWithMultiply(overlapBuffer.getWritePointer(channel),
+            inputBuffer.getReadPointer(channel, offset), window, frameSize);
+    }
+
+    // The first hop is now complete, move it to the output
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        outputBuffer.copyFrom(channel, numOutputSamples, overlapBuffer, channel, 0, synthesisHop);
+
+        float* data = overlapBuffer.getWritePointer(channel);
+        std::memmove(data, data + synthesisHop, sizeof(float) * (size_t) (frameSize - synthesisHop));
+        FloatVectorOperations::clear(data + frameSize - synthesisHop, synthesisHop);
+    }
+
+    numOutputSamples += synthesisHop;
+
+    previousFrameStart = chosen;
+    hasPreviousFrame = true;
+    analysisPos += synthesisHop * tempo.load(std::memory_order_relaxed);
+
+    discardInput(jmin(static_cast<int64>(analysisPos) - searchTolerance, previousFrameStart + synthesisHop));
+}
+
+void TimeStretcher::fillInput(int64 end) noexcept
+{
+    while (inputStart + numInputSamples < end)
+    {
+        const int numToRead = static_cast<int>(jmin(static_cast<int64>(inputChunkSize),
+                                                    end - (inputStart + numInputSamples)));
+
+        jassert(numInputSamples + numToRead <= inputBuffer.getNumSamples());
+
+        AudioSourceChannelInfo info(&inputBuffer, numInputSamples, numToRead);
+        input->getNextAudioBlock(info);
+        numInputSamples += numToRead;
+    }
+}
+
+void TimeStretcher::discardInput(int64 start) noexcept
+{
+    const int numToDrop = static_cast<int>(jlimit(static_cast<int64>(0), static_cast<int64>(numInputSamples),
+                                                  start - inputStart));
+
+    if (numToDrop == 0)
+        return;
+
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        float* data = inputBuffer.getWritePointer(channel);
+        std::memmove(data, data + numToDrop, sizeof(float) * (size_t) (numInputSamples - numToDrop));
+    }
+
+    inputStart += numToDrop;
+    numInputSamples -= numToDrop;
+}
+
+int64 TimeStretcher::findBestMatch(int64 nominal, int64 target) const noexcept
+{
+    const float* left = inputBuffer.getReadPointer(0);
+    const float* right = inputBuffer.getReadPointer(1);
+    const int targetOffset = static_cast<int>(target - inputStart);
+
+    int64 best = nominal;
+    float bestScore = std::numeric_limits<float>::lowest();
+
+    // Every other candidate over a fixed range keeps the cost of a frame constant
+    for (int delta = -searchTolerance; delta <= searchTolerance; delta += 2)
+    {
+        const int64 candidate = nominal + delta;
+
+        if (candidate < inputStart)
+            continue;
+
+        const int candidateOffset = static_cast<int>(candidate - inputStart);
+        float score = 0.0f;
+
+        for (int i = 0; i < correlationLength; ++i)
+        {
+            score += (left[candidateOffset + i] + right[candidateOffset + i])
+                   * (left[targetOffset + i] + right[targetOffset + i]);
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            best = candidate;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    TimeStretcher.h
+    Created: 18 Oct 2026 2:31:08pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The TimeStretcher class changes the tempo of its input without changing its pitch.
+ *
+ * It uses WSOLA (waveform-similarity overlap-add): 1024-sample Hann-windowed
+ * frames are overlap-added every 512 output samples, and each frame is taken from
+ * wherever within +/-256 samples of its nominal input position best continues the
+ * previous frame. The search uses a fixed number of candidates and a fixed
+ * correlation length, so one frame always costs the same, whatever the tempo. A
+ * block of up to 512 samples never needs more than one frame, which bounds the
+ * worst-case cost of a block.
+ */
+class TimeStretcher : public AudioSource
+{
+public:
+    /**
+     * Constructor for TimeStretcher.
+     * @param _input The source to read from. Not owned.
+     */
+    TimeStretcher(AudioSource* _input);
+
+    /**
+     * Destructor for TimeStretcher.
+     */
+    ~TimeStretcher() override;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Override of the getNextAudioBlock method to fill the buffer with time-stretched audio.
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Set the tempo. Values above 1 play faster, values below 1 play slower, the pitch stays the same.
+     * @param newTempo The tempo ratio, between 0 and maxTempo.
+     */
+    void setTempo(double newTempo);
+
+    /**
+     * Get the tempo ratio.
+     * @return The tempo ratio.
+     */
+    double getTempo() const;
+
+    /**
+     * Forget all buffered input and output. Call on the audio thread, it does not allocate.
+     */
+    void reset() noexcept;
+
+    /**
+     * Get how far the input has been read ahead of the next output sample: the search
+     * range and frame lookahead, plus the output waiting to be played. Call on the audio thread.
+     * @return The latency in input samples.
+     */
+    double getLatencySamples() const noexcept;
+
+    /**
+     * The highest tempo the input buffer is sized for.
+     */
+    static constexpr double maxTempo = 5.0;
+
+    /**
+     * Frame length, synthesis hop and search tolerance in samples.
+     */
+    static constexpr int frameSize = 1024;
+    static constexpr int synthesisHop = frameSize / 2;
+    static constexpr int searchTolerance = 256;
+
+private:
+    /**
+     * Produce synthesisHop more output samples.
+     */
+    void processFrame() noexcept;
+
+    /**
+     * Pull input until the sample at stream position `end` - 1 is buffered.
+     */
+    void fillInput(int64 end) noexcept;
+
+    /**
+     * Drop buffered input before stream position `start`.
+     */
+    void discardInput(int64 start) noexcept;
+
+    /**
+     * Offset within the input frame that best continues the previous frame.
+     */
+    int64 findBestMatch(int64 nominal, int64 target) const noexcept;
+
+    AudioSource* input;
+
+    std::atomic<double> tempo{ 1.0 };
+
+    /**
+     * Buffered input. inputStart is the stream position of its first sample.
+     */
+    AudioBuffer<float> inputBuffer;
+    int64 inputStart = 0;
+    int numInputSamples = 0;
+    int inputChunkSize = 0;
+
+    /**
+     * Nominal input position of the next frame, and the start of the previous chosen frame.
+     */
+    double analysisPos = 0.0;
+    int64 previousFrameStart = 0;
+    bool hasPreviousFrame = false;
+
+    /**
+     * Overlap-add accumulator and finished output waiting to be played.
+     */
+    AudioBuffer<float> overlapBuffer;
+    AudioBuffer<float> outputBuffer;
+    int numOutputSamples = 0;
+
+    /**
+     * Periodic Hann window, sums to one at 50% overlap.
+     */
+    HeapBlock<float> window;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TimeStretcher)
+};
@@ -0,0 +1,228 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.cpp
+    Created: 17 Oct 2026 10:12:31am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "TrackAnalyser.h"
+
+//==============================================================================
+class TrackAnalyser::ProbeJob : public ThreadPoolJob
+{
+public:
+    ProbeJob(TrackAnalyser& _owner, const juce::String& _musicUrl,
+             bool _onlyIfModified, juce::int64 _knownFileSize, juce::int64 _knownModificationTime)
+        : ThreadPoolJob("Probe " + _musicUrl),
+          owner(_owner),
+          musicUrl(_musicUrl),
+          onlyIfModified(_onlyIfModified),
+          knownFileSize(_knownFileSize),
+          knownModificationTime(_knownModificationTime)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (shouldExit())
+            return jobHasFinished;
+
+        if (onlyIfModified)
+        {
+            // A stat is far cheaper than opening a reader, so skip unchanged files
+            juce::File musicFile = juce::URL{ musicUrl }.getLocalFile();
+
+            if (musicFile.getSize() == knownFileSize
+                && musicFile.getLastModificationTime().toMilliseconds() == knownModificationTime)
+                return jobHasFinished;
+        }
+
+        owner.addResult(TrackAnalyser::probe(owner.formatManager, musicUrl));
+        return jobHasFinished;
+    }
+
+private:
+    TrackAnalyser& owner;
+    juce::String musicUrl;
+    bool onlyIfModified;
+    juce::int64 knownFileSize;
+    juce::int64 knownModificationTime;
+};
+
+//==============================================================================
+class TrackAnalyser::CompareJob : public ThreadPoolJob
+{
+public:
+    CompareJob(TrackAnalyser& _owner, const TrackAnalyser::Duplicate& _candidate)
+        : ThreadPoolJob("Compare " + _candidate.MusicUrl),
+          owner(_owner),
+          candidate(_candidate)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (shouldExit())
+            return jobHasFinished;
+
+        const juce::File musicFile = juce::URL{ candidate.MusicUrl }.getLocalFile();
+        const juce::File originalFile = juce::URL{ candidate.OriginalUrl }.getLocalFile();
+
+        // Checks the sizes first, then reads both files to the end
+        if (musicFile != originalFile && musicFile.hasIdenticalContentTo(originalFile))
+            owner.addDuplicate(candidate);
+
+        return jobHasFinished;
+    }
+
+private:
+    TrackAnalyser& owner;
+    TrackAnalyser::Duplicate candidate;
+};
+
+//==============================================================================
+TrackAnalyser::TrackAnalyser(AudioFormatManager& _formatManager, Listener& _listener)
+    : formatManager(_formatManager),
+      listener(_listener),
+      pool(jmax(1, SystemStats::getNumCpus()))
+{
+}
+
+TrackAnalyser::~TrackAnalyser()
+{
+    pool.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+}
+
+void TrackAnalyser::analyse(const juce::String& musicUrl)
+{
+    pool.addJob(new ProbeJob(*this, musicUrl, false, 0, 0), true);
+}
+
+void TrackAnalyser::analyseIfModified(const juce::String& musicUrl, juce::int64 fileSize, juce::int64 modificationTime)
+{
+    pool.addJob(new ProbeJob(*this, musicUrl, true, fileSize, modificationTime), true);
+}
+
+void TrackAnalyser::cancelAll()
+{
+    pool.removeAllJobs(true, 5000);
+
+    const ScopedLock sl(resultLock);
+    finishedResults.clear();
+    foundDuplicates.clear();
+}
+
+void TrackAnalyser::confirmDuplicate(const juce::String& musicUrl, const juce::String& originalUrl)
+{
+    pool.addJob(new CompareJob(*this, { musicUrl, originalUrl }), true);
+}
+
+TrackAnalyser::Result TrackAnalyser::probe(AudioFormatManager& formatManager, const juce::String& musicUrl)
+{
+    Result result;
+    result.MusicUrl = musicUrl;
+
+    juce::File musicFile = juce::URL{ musicUrl }.getLocalFile();
+    result.FileSize = musicFile.getSize();
+    result.ModificationTime = musicFile.getLastModificationTime().toMilliseconds();
+    result.ContentHash = computeContentHash(musicFile);
+
+    // Only the header is needed, the reader never decodes any samples here
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(
+        juce::URL{ musicUrl }.createInputStream(false)));
+
+    if (reader != nullptr && reader->sampleRate > 0)
+    {
+        result.LengthInSeconds = reader->lengthInSamples / reader->sampleRate;
+        result.SampleRate = reader->sampleRate;
+        result.NumChannels = static_cast<int>(reader->numChannels);
+        result.WasReadable = true;
+    }
+
+    return result;
+}
+
+juce::int64 TrackAnalyser::computeContentHash(const juce::File& file)
+{
+    constexpr juce::uint64 fnvOffsetBasis = 14695981039346656037ull;
+    constexpr juce::uint64 fnvPrime = 1099511628211ull;
+    constexpr int chunkSize = 64 * 1024;
+
+    FileInputStream stream(file);
+
+    if (!stream.openedOk())
+        return 0;
+
+    juce::uint64 hash = fnvOffsetBasis;
+
+    auto hashBytes = [&hash](const void* data, size_t numBytes)
+    {
+        auto* bytes = static_cast<const juce::uint8*>(data);
+
+        for (size_t i = 0; i < numBytes; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= fnvPrime;
+        }
+    };
+
+    juce::int64 totalSize = stream.getTotalLength();
+    hashBytes(&totalSize, sizeof(totalSize));
+
+    HeapBlock<char> chunk(chunkSize);
+
+    // Hash the head of the file
+    int numRead = stream.read(chunk, chunkSize);
+    hashBytes(chunk, (size_t) jmax(0, numRead));
+
+    // Hash the tail of the file when it does not overlap the head
+    if (totalSize > 2 * chunkSize && stream.setPosition(totalSize - chunkSize))
+    {
+        numRead = stream.read(chunk, chunkSize);
+        hashBytes(chunk, (size_t) jmax(0, numRead));
+    }
+
+    return static_cast<juce::int64>(hash);
+}
+
+void TrackAnalyser::addResult(const Result& result)
+{
+    {
+        const ScopedLock sl(resultLock);
+        finishedResults.add(result);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void TrackAnalyser::addDuplicate(const Duplicate& duplicate)
+{
+    {
+        const ScopedLock sl(resultLock);
+        foundDuplicates.add(duplicate);
+    }
+
+    triggerAsyncUpdate();
+}
+
+void TrackAnalyser::handleAsyncUpdate()
+{
+    Array<Result> results;
+    Array<Duplicate> duplicates;
+
+    {
+        const ScopedLock sl(resultLock);
+        results.swapWith(finishedResults);
+        duplicates.swapWith(foundDuplicates);
+    }
+
+    if (!results.isEmpty())
+        listener.tracksAnalysed(results);
+
+    if (!duplicates.isEmpty())
+        listener.duplicatesFound(duplicates);
+}
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+    TrackAnalyser.h
+    Created: 17 Oct 2026 10:12:31am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * The TrackAnalyser class probes audio files in the background so the playlist
+ * never has to open an AudioFormatReader on the message thread.
+ *
+ * Every call to analyse() becomes a job on a ThreadPool with one worker per CPU.
+ * Finished results are collected and handed to the Listener in batches on the
+ * message thread, so the table can update incrementally as tracks are probed.
+ *
+ * The content hash only covers the ends of a file, so two tracks with the same hash
+ * are only candidates. confirmDuplicate() compares the whole files on the pool and
+ * reports the pairs that really are the same.
+ */
+class TrackAnalyser : private AsyncUpdater
+{
+public:
+    /**
+     * The metadata gathered for a single track.
+     */
+    struct Result
+    {
+        juce::String MusicUrl;
+        double LengthInSeconds = 0.0;
+        double SampleRate = 0.0;
+        int NumChannels = 0;
+        juce::int64 FileSize = 0;
+        juce::int64 ModificationTime = 0;
+        juce::int64 ContentHash = 0;
+        bool WasReadable = false;
+    };
+
+    /**
+     * A track whose whole file is the same as a track already loaded.
+     */
+    struct Duplicate
+    {
+        juce::String MusicUrl;
+        juce::String OriginalUrl;
+    };
+
+    /**
+     * Receives finished results on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called with every result that finished since the previous call.
+         *
+         * @param results The finished results, in completion order.
+         */
+        virtual void tracksAnalysed(const Array<Result>& results) = 0;
+
+        /**
+         * Called with every duplicate confirmed since the previous call.
+         *
+         * @param duplicates The confirmed duplicates, in completion order.
+         */
+        virtual void duplicatesFound(const Array<Duplicate>& duplicates) = 0;
+    };
+
+    /**
+     * Constructor for TrackAnalyser.
+     *
+     * @param _formatManager Reference to the AudioFormatManager used to open the files.
+     * @param _listener      The listener that receives the results.
+     */
+    TrackAnalyser(AudioFormatManager& _formatManager, Listener& _listener);
+
+    /**
+     * Destructor for TrackAnalyser. Waits for running jobs and drops pending ones.
+     */
+    ~TrackAnalyser() override;
+
+    /**
+     * Queue a track to be probed on a worker thread.
+     *
+     * @param musicUrl The URL of the audio file to probe.
+     */
+    void analyse(const juce::String& musicUrl);
+
+    /**
+     * Queue a previously probed track to be checked on a worker thread.
+     * The file is only probed again, and a result only delivered, when its
+     * size or modification time no longer match the stored values.
+     *
+     * @param musicUrl         The URL of the audio file to check.
+     * @param fileSize         The file size recorded when it was last probed.
+     * @param modificationTime The modification time (ms since epoch) recorded when it was last probed.
+     */
+    void analyseIfModified(const juce::String& musicUrl, juce::int64 fileSize, juce::int64 modificationTime);
+
+    /**
+     * Queue two tracks with the same content hash to be compared byte for byte on a worker thread.
+     * A Duplicate is only delivered if the files are identical.
+     *
+     * @param musicUrl    The URL of the track that would be removed.
+     * @param originalUrl The URL of the track that would be kept.
+     */
+    void confirmDuplicate(const juce::String& musicUrl, const juce::String& originalUrl);
+
+    /**
+     * Drop every job that has not started yet and discard undelivered results.
+     */
+    void cancelAll();
+
+    /**
+     * Probe a track on the calling thread.
+     *
+     * @param formatManager The AudioFormatManager used to open the file.
+     * @param musicUrl      The URL of the audio file to probe.
+     * @return              The gathered metadata.
+     */
+    static Result probe(AudioFormatManager& formatManager, const juce::String& musicUrl);
+
+    /**
+     * Compute a 64-bit FNV-1a fingerprint of a file's contents.
+     * Only the size and the first and last 64 KB are hashed, which is enough to
+     * tell files apart without reading whole tracks.
+     *
+     * @param file The file to fingerprint.
+     * @return     The fingerprint, or 0 if the file cannot be read.
+     */
+    static juce::int64 computeContentHash(const juce::File& file);
+
+private:
+    class ProbeJob;
+    class CompareJob;
+
+    /**
+     * Store a finished result and schedule its delivery. Called from worker threads.
+     *
+     * @param result The finished result.
+     */
+    void addResult(const Result& result);
+
+    /**
+     * Store a confirmed duplicate and schedule its delivery. Called from worker threads.
+     *
+     * @param duplicate The confirmed duplicate.
+     */
+    void addDuplicate(const Duplicate& duplicate);
+
+    /**
+     * Deliver the collected results to the listener on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    AudioFormatManager& formatManager;
+    Listener& listener;
+
+    /**
+     * Worker pool, one thread per CPU.
+     */
+    ThreadPool pool;
+
+    /**
+     * Results waiting to be delivered, guarded by resultLock.
+     */
+    CriticalSection resultLock;
+    Array<Result> finishedResults;
+    Array<Duplicate> foundDuplicates;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackAnalyser)
+};
@@ -0,0 +1,150 @@
+/*
+  ==============================================================================
+
+    TrackHandoffSource.cpp
+    Created: 17 Oct 2026 2:58:20pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "TrackHandoffSource.h"
+
+TrackHandoffSource::TrackHandoffSource()
+{
+}
+
+TrackHandoffSource::~TrackHandoffSource()
+{
+    // The audio device is stopped, so every retired track can go
+    endedBlock = currentBlock;
+    collectGarbage();
+    delete pendingTrack.exchange(nullptr);
+    delete activeTrack.exchange(nullptr);
+}
+
+void TrackHandoffSource::prepareToPlay(int samplesPerBlockExpected, double sampleRate)
+{
+    blockSize = samplesPerBlockExpected;
+    deviceSampleRate = sampleRate;
+
+    // The audio callback is not running, so this is a block of its own that ends straight away
+    beginBlock();
+    endBlock();
+
+    if (auto* track = activeTrack.load())
+    {
+        track->transportSource.prepareToPlay(samplesPerBlockExpected, sampleRate);
+    }
+}
+
+void TrackHandoffSource::getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill)
+{
+    if (auto* track = activeTrack.load(std::memory_order_acquire))
+    {
+        const juce::int64 start = Time::getHighResolutionTicks();
+        track->transportSource.getNextAudioBlock(bufferToFill);
+        readTicks += Time::getHighResolutionTicks() - start;
+    }
+    else
+    {
+        bufferToFill.clearActiveBufferRegion();
+    }
+}
+
+juce::int64 TrackHandoffSource::takeReadTicks() noexcept
+{
+    const juce::int64 ticks = readTicks;
+    readTicks = 0;
+    return ticks;
+}
+
+void TrackHandoffSource::releaseResources()
+{
+    if (auto* track = activeTrack.load())
+    {
+        track->transportSource.releaseResources();
+    }
+}
+
+void TrackHandoffSource::publish(std::unique_ptr<DeckTrack> track)
+{
+    // Prepare here so the audio thread never allocates when it swaps the track in
+    if (blockSize > 0 && deviceSampleRate > 0)
+    {
+        track->transportSource.prepareToPlay(blockSize, deviceSampleRate);
+    }
+
+    // A displaced pending track was never seen by the audio thread, so it can go now
+    delete pendingTrack.exchange(track.release(), std::memory_order_acq_rel);
+}
+
+DeckTrack* TrackHandoffSource::getActiveTrack() const
+{
+    if (auto* track = pendingTrack.load(std::memory_order_acquire))
+        return track;
+
+    return activeTrack.load(std::memory_order_acquire);
+}
+
+DeckTrack* TrackHandoffSource::getRenderingTrack() const
+{
+    return activeTrack.load(std::memory_order_acquire);
+}
+
+void TrackHandoffSource::collectGarbage()
+{
+    const juce::int64 ended = endedBlock.load(std::memory_order_acquire);
+
+    // Tracks are retired in block order, so the first one still in use stops the sweep
+    while (retireFifo.getNumReady() > 0)
+    {
+        int start1, size1, start2, size2;
+        retireFifo.prepareToRead(1, start1, size1, start2, size2);
+
+        const RetiredTrack& retired = retiredTracks[(size_t) (size1 > 0 ? start1 : start2)];
+
+        if (retired.block > ended)
+            break;
+
+        delete retired.track;
+        retireFifo.finishedRead(1);
+    }
+}
+
+void TrackHandoffSource::beginBlock()
+{
+    ++currentBlock;
+    activatePendingTrack();
+}
+
+void TrackHandoffSource::endBlock() noexcept
+{
+    endedBlock.store(currentBlock, std::memory_order_release);
+}
+
+void TrackHandoffSource::activatePendingTrack()
+{
+    if (pendingTrack.load(std::memory_order_relaxed) == nullptr)
+        return;
+
+    // Keep the current track until there is room to retire it
+    if (retireFifo.getFreeSpace() == 0)
+        return;
+
+    auto* next = pendingTrack.exchange(nullptr, std::memory_order_acq_rel);
+
+    if (next == nullptr)
+        return;
+
+    if (auto* previous = activeTrack.exchange(next, std::memory_order_acq_rel))
+    {
+        const auto scope = retireFifo.write(1);
+        const RetiredTrack retired{ previous, currentBlock };
+
+        if (scope.blockSize1 > 0)
+            retiredTracks[(size_t) scope.startIndex1] = retired;
+        else
+            retiredTracks[(size_t) scope.startIndex2] = retired;
+    }
+}
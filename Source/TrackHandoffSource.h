@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    TrackHandoffSource.h
+    Created: 17 Oct 2026 2:58:20pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DeckTrack.h"
+
+/**
+ * The TrackHandoffSource class plays whichever DeckTrack is currently active and
+ * hands newly loaded tracks to the audio thread without locking.
+ *
+ * The message thread publishes a fully prepared track into a pending slot. The owner
+ * calls beginBlock() at the start of every audio block, the only place the audio
+ * thread swaps a pending track in, with a single atomic exchange. The track it
+ * replaced goes onto a lock-free retire queue, stamped with the block that retired it.
+ *
+ * The owner calls endBlock() once the block is finished with every track pointer it
+ * fetched. The timer-driven collectGarbage() on the message thread only deletes
+ * tracks retired by a block that has ended, so no reader is ever torn down on the
+ * audio thread or while the audio thread may still hold it.
+ *
+ * Tracks are only ever deleted on the message thread, so a pointer returned by
+ * getActiveTrack() stays valid for the rest of the message-thread call that fetched it.
+ */
+class TrackHandoffSource : public AudioSource
+{
+public:
+    /**
+     * Constructor for TrackHandoffSource.
+     */
+    TrackHandoffSource();
+
+    /**
+     * Destructor for TrackHandoffSource. The audio device must already be stopped.
+     */
+    ~TrackHandoffSource() override;
+
+    /**
+     * Called to signal that the audio device is ready to start processing audio.
+     * Any pending track is activated straight away so it is prepared with the new settings.
+     * @param samplesPerBlockExpected The number of samples in each block of audio.
+     * @param sampleRate The sample rate of the audio stream.
+     */
+    void prepareToPlay(int samplesPerBlockExpected, double sampleRate) override;
+
+    /**
+     * Render the track activated by the last beginBlock().
+     * @param bufferToFill The buffer that will be filled with audio data.
+     */
+    void getNextAudioBlock(const AudioSourceChannelInfo& bufferToFill) override;
+
+    /**
+     * Override of the releaseResources method to release audio resources.
+     */
+    void releaseResources() override;
+
+    /**
+     * Prepare a track with the current device settings and queue it for the audio thread.
+     * A pending track that the audio thread has not picked up yet is discarded; tracks
+     * the audio thread has seen are left to collectGarbage().
+     * Must be called on the message thread.
+     * @param track The track to hand over.
+     */
+    void publish(std::unique_ptr<DeckTrack> track);
+
+    /**
+     * Get the most recently published track, whether or not the audio thread has picked it up yet.
+     * Must be called on the message thread.
+     * @return The newest track, or nullptr if no track has been loaded.
+     */
+    DeckTrack* getActiveTrack() const;
+
+    /**
+     * Delete the tracks retired by audio blocks that have ended. Must be called on the message thread.
+     */
+    void collectGarbage();
+
+    /**
+     * Start an audio block: swap the pending track in, if there is one and the retire
+     * queue has room. Must be called on the audio thread before the block touches any track.
+     */
+    void beginBlock();
+
+    /**
+     * End an audio block: the audio thread holds no pointer to a track retired before now.
+     * Must be called on the audio thread once the block is finished with its tracks.
+     */
+    void endBlock() noexcept;
+
+    /**
+     * Get the track the audio thread is rendering. Must be called on the audio thread.
+     * @return The rendered track, or nullptr if no track has been swapped in yet.
+     */
+    DeckTrack* getRenderingTrack() const;
+
+    /**
+     * Get the time spent reading the active track since the last call, and start counting again.
+     * Must be called on the audio thread.
+     * @return The read time in high resolution ticks.
+     */
+    juce::int64 takeReadTicks() noexcept;
+
+private:
+    /**
+     * Swap the pending track in, if there is one and the retire queue has room.
+     */
+    void activatePendingTrack();
+
+    /**
+     * A track taken off the audio thread, and the block that took it off.
+     */
+    struct RetiredTrack
+    {
+        DeckTrack* track = nullptr;
+        juce::int64 block = 0;
+    };
+
+    /**
+     * Track published by the message thread and not yet picked up by the audio thread.
+     */
+    std::atomic<DeckTrack*> pendingTrack{ nullptr };
+
+    /**
+     * Track rendered by the audio thread.
+     */
+    std::atomic<DeckTrack*> activeTrack{ nullptr };
+
+    /**
+     * Single-producer single-consumer queue of tracks retired by the audio thread.
+     */
+    static constexpr int retireQueueSize = 16;
+    AbstractFifo retireFifo{ retireQueueSize };
+    std::array<RetiredTrack, retireQueueSize> retiredTracks{};
+
+    /**
+     * The block the audio thread is in, only written by the audio thread, and the last
+     * block it has finished with.
+     */
+    juce::int64 currentBlock = 0;
+    std::atomic<juce::int64> endedBlock{ 0 };
+
+    /**
+     * Device settings that newly published tracks are prepared with.
+     */
+    std::atomic<int> blockSize{ 0 };
+    std::atomic<double> deviceSampleRate{ 0.0 };
+
+    /**
+     * Time spent in the transport of the active track, only touched by the audio thread.
+     */
+    juce::int64 readTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TrackHandoffSource)
+};
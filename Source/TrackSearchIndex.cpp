@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    TrackSearchIndex.cpp
+    Created: 21 Oct 2026 11:26:04am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "TrackSearchIndex.h"
+#include <algorithm>
+
+void TrackSearchIndex::add(juce::uint32 trackId, const juce::String& text)
+{
+    if (documents.find(trackId) != documents.end())
+        remove(trackId);
+
+    const juce::String normalisedText = normalise(text);
+    documents[trackId] = normalisedText;
+
+    for (auto trigram : getTrigrams(normalisedText, true))
+    {
+        auto& ids = postings[trigram];
+
+        // Ids arrive in increasing order, so appending keeps the list sorted
+        if (ids.empty() || ids.back() < trackId)
+            ids.push_back(trackId);
+        else
+            ids.insert(std::lower_bound(ids.begin(), ids.end(), trackId), trackId);
+    }
+
+    if (matchCounts.size() <= trackId)
+        matchCounts.resize(static_cast<size_t>(trackId) + 1, 0);
+}
+
+void TrackSearchIndex::remove(juce::uint32 trackId)
+{
+    auto document = documents.find(trackId);
+
+    if (document == documents.end())
+        return;
+
+    for (auto trigram : getTrigrams(document->second, true))
+    {
+        auto posting = postings.find(trigram);
+
+        if (posting == postings.end())
+            continue;
+
+        auto& ids = posting->second;
+        auto it = std::lower_bound(ids.begin(), ids.end(), trackId);
+
+        if (it != ids.end() && *it == trackId)
+            ids.erase(it);
+
+        if (ids.empty())
+            postings.erase(posting);
+    }
+
+    documents.erase(document);
+}
+
+void TrackSearchIndex::clear()
+{
+    postings.clear();
+    documents.clear();
+    matchCounts.clear();
+    touchedIds.clear();
+}
+
+std::vector<juce::uint32> TrackSearchIndex::search(const juce::String& query) const
+{
+    const juce::String normalisedQuery = normalise(query);
+    std::vector<std::pair<float, juce::uint32>> ranked;
+
+    if (normalisedQuery.isEmpty())
+        return {};
+
+    if (normalisedQuery.length() < 2)
+    {
+        // A single character has no useful trigrams, fall back to a plain prefix scan
+        for (const auto& document : documents)
+        {
+            if (document.second.startsWith(normalisedQuery) || document.second.contains(" " + normalisedQuery))
+                ranked.emplace_back(1.0f, document.first);
+        }
+    }
+    else
+    {
+        // The last word may still be being typed, so it is not padded at the end
+        const auto queryTrigrams = getTrigrams(normalisedQuery, false);
+
+        // Count the query trigrams each track shares
+        for (auto trigram : queryTrigrams)
+        {
+            auto posting = postings.find(trigram);
+
+            if (posting == postings.end())
+                continue;
+
+            for (auto trackId : posting->second)
+            {
+                if (matchCounts[trackId]++ == 0)
+                    touchedIds.push_back(trackId);
+            }
+        }
+
+        const float requiredMatches = jmax(1.0f, minimumSimilarity * queryTrigrams.size());
+
+        for (auto trackId : touchedIds)
+        {
+            const float matches = matchCounts[trackId];
+            matchCounts[trackId] = 0;
+
+            if (matches < requiredMatches)
+                continue;
+
+            // Exact substrings and word prefixes rank above typo matches
+            const juce::String& text = documents.at(trackId);
+            float score = matches / queryTrigrams.size();
+
+            if (text.contains(normalisedQuery))
+                score += text.startsWith(normalisedQuery) ? 1.0f : 0.5f;
+
+            ranked.emplace_back(score, trackId);
+        }
+
+        touchedIds.clear();
+    }
+
+    // Best score first, older tracks first among equals
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b)
+        {
+            return a.first != b.first ? a.first > b.first : a.second < b.second;
+        });
+
+    std::vector<juce::uint32> result;
+    result.reserve(ranked.size());
+
+    for (const auto& entry : ranked)
+        result.push_back(entry.second);
+
+    return result;
+}
+
+size_t TrackSearchIndex::size() const
+{
+    return documents.size();
+}
+
+juce::String TrackSearchIndex::normalise(const juce::String& text)
+{
+    juce::String result;
+    result.preallocateBytes(text.getNumBytesAsUTF8());
+    bool pendingSpace = false;
+
+    for (auto character : text)
+    {
+        if (CharacterFunctions::isLetterOrDigit(character))
+        {
+            if (pendingSpace && result.isNotEmpty())
+                result << ' ';
+
+            result << CharacterFunctions::toLowerCase(character);
+            pendingSpace = false;
+        }
+        else
+        {
+            pendingSpace = true;
+        }
+    }
+
+    return result;
+}
+
+std::vector<juce::uint64> TrackSearchIndex::getTrigrams(const juce::String& normalisedText, bool padEnd)
+{
+    std::vector<juce::uint64> trigrams;
+
+    // Pad the text with a space on both sides so word boundaries get trigrams of their own
+    std::vector<juce::juce_wchar> characters{ ' ' };
+
+    for (auto character : normalisedText)
+        characters.push_back(character);
+
+    if (padEnd)
+        characters.push_back(' ');
+
+    for (size_t i = 0; i + 2 < characters.size(); ++i)
+    {
+        // Code points fit in 21 bits, so three of them pack into one key
+        trigrams.push_back((static_cast<juce::uint64>(characters[i]) << 42)
+                         | (static_cast<juce::uint64>(characters[i + 1]) << 21)
+                         | static_cast<juce::uint64>(characters[i + 2]));
+    }
+
+    std::sort(trigrams.begin(), trigrams.end());
+    trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+    return trigrams;
+}
@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    TrackSearchIndex.h
+    Created: 21 Oct 2026 11:26:04am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The TrackSearchIndex class is a trigram inverted index over track titles and
+ * folder names, used for fuzzy search-as-you-type in the playlist.
+ *
+ * Text is normalised to lower-case letters and digits separated by single spaces,
+ * and the text is padded with a space on both sides before it is cut into
+ * trigrams, so word boundaries get trigrams of their own. Each trigram maps to a
+ * sorted list of track ids. A query counts how many of its trigrams each track
+ * shares, keeps the tracks that share enough of them to tolerate a typo, and
+ * ranks exact and prefix matches first. Tracks are added and removed one at a
+ * time, so the index never has to be rebuilt.
+ */
+class TrackSearchIndex
+{
+public:
+    /**
+     * Add a track to the index.
+     *
+     * @param trackId The stable id of the track. Ids must be added in increasing order.
+     * @param text    The searchable text, such as the title and folder name.
+     */
+    void add(juce::uint32 trackId, const juce::String& text);
+
+    /**
+     * Remove a track from the index.
+     *
+     * @param trackId The id the track was added with.
+     */
+    void remove(juce::uint32 trackId);
+
+    /**
+     * Remove every track from the index.
+     */
+    void clear();
+
+    /**
+     * Find the tracks matching a query.
+     *
+     * @param query The text typed by the user.
+     * @return      The ids of the matching tracks, best match first.
+     */
+    std::vector<juce::uint32> search(const juce::String& query) const;
+
+    /**
+     * Get the number of indexed tracks.
+     *
+     * @return The number of tracks.
+     */
+    size_t size() const;
+
+    /**
+     * Normalise text for indexing and searching.
+     *
+     * @param text The text to normalise.
+     * @return     Lower-case letters and digits, with single spaces between words.
+     */
+    static juce::String normalise(const juce::String& text);
+
+private:
+    /**
+     * Collect the distinct trigrams of normalised text.
+     *
+     * @param normalisedText The normalised text.
+     * @param padEnd         False for queries, whose last word may be incomplete.
+     * @return               The trigrams, each packed into 64 bits.
+     */
+    static std::vector<juce::uint64> getTrigrams(const juce::String& normalisedText, bool padEnd);
+
+    /**
+     * The fraction of a query's trigrams a track must share to match.
+     */
+    static constexpr float minimumSimilarity = 0.6f;
+
+    /**
+     * Track ids by trigram, each list sorted.
+     */
+    std::unordered_map<juce::uint64, std::vector<juce::uint32>> postings;
+
+    /**
+     * The normalised text of every indexed track, used for removal and ranking.
+     */
+    std::unordered_map<juce::uint32, juce::String> documents;
+
+    /**
+     * Per-track match counters reused by every query, indexed by track id.
+     */
+    mutable std::vector<juce::uint16> matchCounts;
+    mutable std::vector<juce::uint32> touchedIds;
+};
@@ -0,0 +1,352 @@
+/*
+  ==============================================================================
+
+    TrackStore.cpp
+    Created: 23 Oct 2026 10:41:16am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "TrackStore.h"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    template <typename Column>
+    void eraseRow(Column& column, size_t index)
+    {
+        column.erase(column.begin() + static_cast<std::ptrdiff_t>(index));
+    }
+}
+
+TrackStore::TrackId TrackStore::add(const SoundTrack& track)
+{
+    // The folder is shared with the other tracks in it, only the file name is stored per track
+    const int separator = track.MusicUrl.lastIndexOfChar('/') + 1;
+
+    const TrackId id = nextId++;
+    ids.push_back(id);
+    nameOffsets.push_back(storeText(track.MusicName));
+    fileOffsets.push_back(storeText(track.MusicUrl.substring(separator)));
+    folderIndices.push_back(internFolder(track.MusicUrl.substring(0, separator)));
+    lengths.push_back(static_cast<float>(track.LengthInSeconds));
+    sampleRates.push_back(static_cast<float>(track.SampleRate));
+    channelCounts.push_back(static_cast<juce::uint8>(jlimit(0, 255, track.NumChannels)));
+    analysedFlags.push_back(track.IsAnalysed ? 1 : 0);
+    fileSizes.push_back(track.FileSize);
+    modificationTimes.push_back(track.ModificationTime);
+    contentHashes.push_back(track.ContentHash);
+    bpms.push_back(static_cast<float>(track.Bpm));
+    firstBeats.push_back(static_cast<float>(track.FirstBeatSeconds));
+    musicalKeys.push_back(static_cast<juce::int8>(jlimit(-1, 23, track.MusicalKey)));
+    loudnessFlags.push_back(track.HasLoudness ? 1 : 0);
+    loudnesses.push_back(static_cast<float>(track.LoudnessLufs));
+    truePeaks.push_back(static_cast<float>(track.TruePeakDb));
+    contentAnalysedTimes.push_back(track.ContentAnalysedTime);
+
+    return id;
+}
+
+bool TrackStore::remove(TrackId id)
+{
+    const int row = indexOf(id);
+
+    if (row < 0)
+        return false;
+
+    const size_t index = static_cast<size_t>(row);
+    unusedTextBytes += getTextSize(nameOffsets[index]) + getTextSize(fileOffsets[index]);
+
+    eraseRow(ids, index);
+    eraseRow(nameOffsets, index);
+    eraseRow(fileOffsets, index);
+    eraseRow(folderIndices, index);
+    eraseRow(lengths, index);
+    eraseRow(sampleRates, index);
+    eraseRow(channelCounts, index);
+    eraseRow(analysedFlags, index);
+    eraseRow(fileSizes, index);
+    eraseRow(modificationTimes, index);
+    eraseRow(contentHashes, index);
+    eraseRow(bpms, index);
+    eraseRow(firstBeats, index);
+    eraseRow(musicalKeys, index);
+    eraseRow(loudnessFlags, index);
+    eraseRow(loudnesses, index);
+    eraseRow(truePeaks, index);
+    eraseRow(contentAnalysedTimes, index);
+
+    // Keep the text buffer bounded by the tracks that are still in the store
+    if (unusedTextBytes > text.size() / 2)
+        compactText();
+
+    return true;
+}
+
+void TrackStore::clear()
+{
+    ids.clear();
+    nameOffsets.clear();
+    fileOffsets.clear();
+    folderIndices.clear();
+    lengths.clear();
+    sampleRates.clear();
+    channelCounts.clear();
+    analysedFlags.clear();
+    fileSizes.clear();
+    modificationTimes.clear();
+    contentHashes.clear();
+    bpms.clear();
+    firstBeats.clear();
+    musicalKeys.clear();
+    loudnessFlags.clear();
+    loudnesses.clear();
+    truePeaks.clear();
+    contentAnalysedTimes.clear();
+
+    text.clear();
+    unusedTextBytes = 0;
+    folders.clear();
+    folderIndexByUrl.clear();
+}
+
+size_t TrackStore::size() const
+{
+    return ids.size();
+}
+
+void TrackStore::reserve(size_t numTracks)
+{
+    ids.reserve(numTracks);
+    nameOffsets.reserve(numTracks);
+    fileOffsets.reserve(numTracks);
+    folderIndices.reserve(numTracks);
+    lengths.reserve(numTracks);
+    sampleRates.reserve(numTracks);
+    channelCounts.reserve(numTracks);
+    analysedFlags.reserve(numTracks);
+    fileSizes.reserve(numTracks);
+    modificationTimes.reserve(numTracks);
+    contentHashes.reserve(numTracks);
+    bpms.reserve(numTracks);
+    firstBeats.reserve(numTracks);
+    musicalKeys.reserve(numTracks);
+    loudnessFlags.reserve(numTracks);
+    loudnesses.reserve(numTracks);
+    truePeaks.reserve(numTracks);
+    contentAnalysedTimes.reserve(numTracks);
+}
+
+int TrackStore::indexOf(TrackId id) const
+{
+    // Ids are handed out in row order, so the id column is always sorted
+    auto it = std::lower_bound(ids.begin(), ids.end(), id);
+
+    if (it == ids.end() || *it != id)
+        return -1;
+
+    return static_cast<int>(it - ids.begin());
+}
+
+TrackStore::TrackId TrackStore::getId(size_t index) const
+{
+    return ids[index];
+}
+
+juce::String TrackStore::getName(size_t index) const
+{
+    return getText(nameOffsets[index]);
+}
+
+juce::String TrackStore::getUrl(size_t index) const
+{
+    return folders[static_cast<int>(folderIndices[index])] + getText(fileOffsets[index]);
+}
+
+double TrackStore::getLengthInSeconds(size_t index) const
+{
+    return lengths[index];
+}
+
+juce::int64 TrackStore::getContentHash(size_t index) const
+{
+    return contentHashes[index];
+}
+
+bool TrackStore::isAnalysed(size_t index) const
+{
+    return analysedFlags[index] != 0;
+}
+
+double TrackStore::getBpm(size_t index) const
+{
+    return bpms[index];
+}
+
+double TrackStore::getFirstBeatSeconds(size_t index) const
+{
+    return firstBeats[index];
+}
+
+bool TrackStore::hasBeatGrid(size_t index) const
+{
+    return bpms[index] > 0.0f;
+}
+
+int TrackStore::getMusicalKey(size_t index) const
+{
+    return musicalKeys[index];
+}
+
+bool TrackStore::hasLoudness(size_t index) const
+{
+    return loudnessFlags[index] != 0;
+}
+
+double TrackStore::getLoudnessLufs(size_t index) const
+{
+    return loudnesses[index];
+}
+
+double TrackStore::getTruePeakDb(size_t index) const
+{
+    return truePeaks[index];
+}
+
+bool TrackStore::needsContentAnalysis(size_t index) const
+{
+    return contentAnalysedTimes[index] == 0 || contentAnalysedTimes[index] != modificationTimes[index];
+}
+
+SoundTrack TrackStore::getTrack(size_t index) const
+{
+    SoundTrack track{ getName(index), getUrl(index) };
+    track.LengthInSeconds = lengths[index];
+    track.SampleRate = sampleRates[index];
+    track.NumChannels = channelCounts[index];
+    track.FileSize = fileSizes[index];
+    track.ModificationTime = modificationTimes[index];
+    track.ContentHash = contentHashes[index];
+    track.IsAnalysed = analysedFlags[index] != 0;
+    track.Bpm = bpms[index];
+    track.FirstBeatSeconds = firstBeats[index];
+    track.MusicalKey = musicalKeys[index];
+    track.HasLoudness = loudnessFlags[index] != 0;
+    track.LoudnessLufs = loudnesses[index];
+    track.TruePeakDb = truePeaks[index];
+    track.ContentAnalysedTime = contentAnalysedTimes[index];
+    track.Id = ids[index];
+    return track;
+}
+
+void TrackStore::setAnalysis(size_t index, const TrackAnalyser::Result& result)
+{
+    // A file with new contents needs its beats, key and loudness analysed again
+    if (contentHashes[index] != result.ContentHash)
+    {
+        bpms[index] = 0.0f;
+        firstBeats[index] = 0.0f;
+        musicalKeys[index] = -1;
+        loudnessFlags[index] = 0;
+        contentAnalysedTimes[index] = 0;
+    }
+
+    lengths[index] = static_cast<float>(result.LengthInSeconds);
+    sampleRates[index] = static_cast<float>(result.SampleRate);
+    channelCounts[index] = static_cast<juce::uint8>(jlimit(0, 255, result.NumChannels));
+    fileSizes[index] = result.FileSize;
+    modificationTimes[index] = result.ModificationTime;
+    contentHashes[index] = result.ContentHash;
+    analysedFlags[index] = 1;
+}
+
+void TrackStore::setBeatGrid(size_t index, double bpm, double firstBeatSeconds)
+{
+    bpms[index] = static_cast<float>(bpm);
+    firstBeats[index] = static_cast<float>(firstBeatSeconds);
+}
+
+void TrackStore::setMusicalKey(size_t index, int key)
+{
+    musicalKeys[index] = static_cast<juce::int8>(jlimit(-1, 23, key));
+}
+
+void TrackStore::setLoudness(size_t index, double integratedLufs, double truePeakDb)
+{
+    loudnessFlags[index] = 1;
+    loudnesses[index] = static_cast<float>(integratedLufs);
+    truePeaks[index] = static_cast<float>(truePeakDb);
+}
+
+void TrackStore::setContentAnalysed(size_t index)
+{
+    contentAnalysedTimes[index] = modificationTimes[index];
+}
+
+size_t TrackStore::getMemoryUsage() const
+{
+    const size_t bytesPerRow = sizeof(TrackId) + 3 * sizeof(juce::uint32) + 6 * sizeof(float)
+                             + 4 * sizeof(juce::uint8) + 4 * sizeof(juce::int64);
+
+    size_t folderBytes = 0;
+
+    for (const auto& folder : folders)
+        folderBytes += folder.getNumBytesAsUTF8() + 1;
+
+    return ids.capacity() * bytesPerRow + text.capacity() + folderBytes;
+}
+
+juce::uint32 TrackStore::storeText(const juce::String& textToStore)
+{
+    const auto offset = static_cast<juce::uint32>(text.size());
+    const char* utf8 = textToStore.toRawUTF8();
+    text.insert(text.end(), utf8, utf8 + std::strlen(utf8) + 1);
+    return offset;
+}
+
+juce::String TrackStore::getText(juce::uint32 offset) const
+{
+    return juce::String::fromUTF8(text.data() + offset);
+}
+
+size_t TrackStore::getTextSize(juce::uint32 offset) const
+{
+    return std::strlen(text.data() + offset) + 1;
+}
+
+juce::uint32 TrackStore::internFolder(const juce::String& folderUrl)
+{
+    auto found = folderIndexByUrl.find(folderUrl);
+
+    if (found != folderIndexByUrl.end())
+        return found->second;
+
+    const auto index = static_cast<juce::uint32>(folders.size());
+    folders.add(folderUrl);
+    folderIndexByUrl.emplace(folderUrl, index);
+    return index;
+}
+
+void TrackStore::compactText()
+{
+    std::vector<char> compacted;
+    compacted.reserve(text.size() - unusedTextBytes);
+
+    auto move = [&](juce::uint32& offset)
+    {
+        const char* start = text.data() + offset;
+        offset = static_cast<juce::uint32>(compacted.size());
+        compacted.insert(compacted.end(), start, start + std::strlen(start) + 1);
+    };
+
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+        move(nameOffsets[i]);
+        move(fileOffsets[i]);
+    }
+
+    text.swap(compacted);
+    unusedTextBytes = 0;
+}
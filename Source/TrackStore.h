@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+    TrackStore.h
+    Created: 23 Oct 2026 10:41:16am
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <unordered_map>
+#include <vector>
+#include "SoundTrack.h"
+#include "TrackAnalyser.h"
+
+/**
+ * The TrackStore class holds the playlist as columns rather than as one object
+ * per track, so a million tracks stay compact and cache friendly.
+ *
+ * Every field lives in its own array, indexed by row. Titles and file names are
+ * stored as UTF-8 in one shared text buffer. The folder part of every URL is
+ * interned, so tracks in the same folder share a single copy. Each track has a
+ * stable id that never changes or gets reused. Ids grow with the row order, so
+ * a row is found from its id with a binary search and no extra map.
+ */
+class TrackStore
+{
+public:
+    using TrackId = juce::uint32;
+
+    /**
+     * Append a track.
+     *
+     * @param track The track to append. Its Id is ignored.
+     * @return      The id given to the track.
+     */
+    TrackId add(const SoundTrack& track);
+
+    /**
+     * Remove a track.
+     *
+     * @param id The id of the track.
+     * @return   False if there is no track with that id.
+     */
+    bool remove(TrackId id);
+
+    /**
+     * Remove every track. Ids are not reused afterwards.
+     */
+    void clear();
+
+    /**
+     * Get the number of tracks.
+     *
+     * @return The number of rows.
+     */
+    size_t size() const;
+
+    /**
+     * Reserve room for more tracks.
+     *
+     * @param numTracks The total number of tracks expected.
+     */
+    void reserve(size_t numTracks);
+
+    /**
+     * Find the row of a track.
+     *
+     * @param id The id of the track.
+     * @return   The row, or -1 if there is no track with that id.
+     */
+    int indexOf(TrackId id) const;
+
+    /**
+     * Get the stable id of a row.
+     */
+    TrackId getId(size_t index) const;
+
+    /**
+     * Get the title of a row.
+     */
+    juce::String getName(size_t index) const;
+
+    /**
+     * Get the URL of a row, rebuilt from its interned folder and file name.
+     */
+    juce::String getUrl(size_t index) const;
+
+    /**
+     * Get the probed length of a row in seconds.
+     */
+    double getLengthInSeconds(size_t index) const;
+
+    /**
+     * Get the content hash of a row, 0 until it has been probed.
+     */
+    juce::int64 getContentHash(size_t index) const;
+
+    /**
+     * Check whether a row has been probed.
+     */
+    bool isAnalysed(size_t index) const;
+
+    /**
+     * Get the tempo of a row, 0 until its beats have been analysed.
+     */
+    double getBpm(size_t index) const;
+
+    /**
+     * Get the time of the first downbeat of a row in seconds.
+     */
+    double getFirstBeatSeconds(size_t index) const;
+
+    /**
+     * Check whether a row has a beat grid.
+     */
+    bool hasBeatGrid(size_t index) const;
+
+    /**
+     * Get the musical key of a row, -1 until it has been analysed.
+     */
+    int getMusicalKey(size_t index) const;
+
+    /**
+     * Check whether the loudness of a row has been analysed.
+     */
+    bool hasLoudness(size_t index) const;
+
+    /**
+     * Get the integrated loudness of a row in LUFS.
+     */
+    double getLoudnessLufs(size_t index) const;
+
+    /**
+     * Get the true peak of a row in dBTP.
+     */
+    double getTruePeakDb(size_t index) const;
+
+    /**
+     * Check whether a row still has to go through the ContentAnalyser: it never has,
+     * or the file changed on disk since it did.
+     */
+    bool needsContentAnalysis(size_t index) const;
+
+    /**
+     * Build the full record of a track.
+     *
+     * @param index The row.
+     * @return      The track with all its metadata.
+     */
+    SoundTrack getTrack(size_t index) const;
+
+    /**
+     * Store the probed metadata of a track and mark it as analysed.
+     * The beat grid, key and loudness are cleared when the content hash changed, as they belong to the old file.
+     *
+     * @param index  The row.
+     * @param result The probe result.
+     */
+    void setAnalysis(size_t index, const TrackAnalyser::Result& result);
+
+    /**
+     * Store the beat grid of a track.
+     *
+     * @param index            The row.
+     * @param bpm              The tempo.
+     * @param firstBeatSeconds The time of the first downbeat.
+     */
+    void setBeatGrid(size_t index, double bpm, double firstBeatSeconds);
+
+    /**
+     * Store the musical key of a track.
+     *
+     * @param index The row.
+     * @param key   The key, as numbered by the KeyAnalyser.
+     */
+    void setMusicalKey(size_t index, int key);
+
+    /**
+     * Store the loudness of a track.
+     *
+     * @param index          The row.
+     * @param integratedLufs The integrated loudness.
+     * @param truePeakDb     The true peak.
+     */
+    void setLoudness(size_t index, double integratedLufs, double truePeakDb);
+
+    /**
+     * Record that the ContentAnalyser finished a track at its current modification time,
+     * whether or not it found a beat grid, key or loudness.
+     *
+     * @param index The row.
+     */
+    void setContentAnalysed(size_t index);
+
+    /**
+     * Estimate the memory held by the store.
+     *
+     * @return The number of bytes allocated for the columns and the text.
+     */
+    size_t getMemoryUsage() const;
+
+private:
+    /**
+     * Append a string to the text buffer.
+     *
+     * @return The offset of the string.
+     */
+    juce::uint32 storeText(const juce::String& text);
+
+    /**
+     * Read a string from the text buffer.
+     */
+    juce::String getText(juce::uint32 offset) const;
+
+    /**
+     * Get the number of bytes a stored string takes, including its terminator.
+     */
+    size_t getTextSize(juce::uint32 offset) const;
+
+    /**
+     * Look up or add a folder URL in the interned folder table.
+     */
+    juce::uint32 internFolder(const juce::String& folderUrl);
+
+    /**
+     * Rewrite the text buffer without the strings of removed tracks.
+     */
+    void compactText();
+
+    // Columns, one entry per row
+    std::vector<TrackId> ids;
+    std::vector<juce::uint32> nameOffsets;
+    std::vector<juce::uint32> fileOffsets;
+    std::vector<juce::uint32> folderIndices;
+    std::vector<float> lengths;
+    std::vector<float> sampleRates;
+    std::vector<juce::uint8> channelCounts;
+    std::vector<juce::uint8> analysedFlags;
+    std::vector<juce::int64> fileSizes;
+    std::vector<juce::int64> modificationTimes;
+    std::vector<juce::int64> contentHashes;
+    std::vector<float> bpms;
+    std::vector<float> firstBeats;
+    std::vector<juce::int8> musicalKeys;
+    std::vector<juce::uint8> loudnessFlags;
+    std::vector<float> loudnesses;
+    std::vector<float> truePeaks;
+    std::vector<juce::int64> contentAnalysedTimes;
+
+    /**
+     * UTF-8 titles and file names, each followed by a null terminator.
+     */
+    std::vector<char> text;
+    size_t unusedTextBytes = 0;
+
+    /**
+     * Interned folder URLs, ending with a slash.
+     */
+    StringArray folders;
+    std::unordered_map<juce::String, juce::uint32> folderIndexByUrl;
+
+    TrackId nextId = 1;
+};
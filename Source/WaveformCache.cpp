@@ -0,0 +1,391 @@
+/*
+  ==============================================================================
+
+    WaveformCache.cpp
+    Created: 19 Oct 2026 3:42:18pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include "WaveformCache.h"
+#include "TrackAnalyser.h"
+
+static_assert(sizeof(WaveformCache::Peak) == 6, "Peaks are written to disk as packed bytes");
+
+//==============================================================================
+class WaveformCache::OverviewJob : public ThreadPoolJob
+{
+public:
+    OverviewJob(WaveformCache& _owner, const juce::URL& _audioURL)
+        : ThreadPoolJob("Waveform " + _audioURL.toString(false)),
+          owner(_owner),
+          audioURL(_audioURL)
+    {
+    }
+
+    JobStatus runJob() override
+    {
+        if (shouldExit())
+            return jobHasFinished;
+
+        const juce::int64 contentHash = TrackAnalyser::computeContentHash(audioURL.getLocalFile());
+        std::shared_ptr<Overview> overview;
+
+        // Previously seen tracks only cost one file read
+        if (contentHash != 0)
+            overview = WaveformCache::load(owner.getCacheFileFor(contentHash), contentHash);
+
+        if (overview == nullptr)
+        {
+            overview = WaveformCache::generate(owner.formatManager, audioURL, [this] { return shouldExit(); });
+
+            if (overview != nullptr && contentHash != 0)
+            {
+                overview->contentHash = contentHash;
+                WaveformCache::save(owner.getCacheFileFor(contentHash), *overview);
+            }
+        }
+
+        if (!shouldExit())
+            owner.addResult(audioURL, overview);
+
+        return jobHasFinished;
+    }
+
+private:
+    WaveformCache& owner;
+    juce::URL audioURL;
+};
+
+//==============================================================================
+const WaveformCache::Level* WaveformCache::Overview::getLevelFor(double samplesPerPixel) const
+{
+    const Level* best = levels.empty() ? nullptr : &levels.front();
+
+    for (const auto& level : levels)
+    {
+        if (level.samplesPerPeak <= samplesPerPixel)
+            best = &level;
+    }
+
+    return best;
+}
+
+double WaveformCache::Overview::getLengthInSeconds() const
+{
+    return sampleRate > 0.0 ? lengthInSamples / sampleRate : 0.0;
+}
+
+//==============================================================================
+WaveformCache::WaveformCache(AudioFormatManager& _formatManager, const juce::File& _cacheDirectory)
+    : formatManager(_formatManager),
+      cacheDirectory(_cacheDirectory)
+{
+}
+
+WaveformCache::~WaveformCache()
+{
+    pool.removeAllJobs(true, 5000);
+    cancelPendingUpdate();
+}
+
+void WaveformCache::addListener(Listener* listener)
+{
+    listeners.add(listener);
+}
+
+void WaveformCache::removeListener(Listener* listener)
+{
+    listeners.remove(listener);
+}
+
+void WaveformCache::request(const juce::URL& audioURL)
+{
+    const juce::String key = audioURL.toString(false);
+    auto recent = recentOverviews.find(key);
+
+    if (recent != recentOverviews.end())
+    {
+        auto overview = recent->second;
+        listeners.call([&](Listener& l) { l.waveformReady(audioURL, overview); });
+        return;
+    }
+
+    // Both decks may ask for the same track, one job serves them both
+    if (pendingRequests.insert(key).second)
+        pool.addJob(new OverviewJob(*this, audioURL), true);
+}
+
+std::shared_ptr<WaveformCache::Overview> WaveformCache::generate(AudioFormatManager& formatManager,
+                                                                  const juce::URL& audioURL,
+                                                                  const std::function<bool()>& shouldAbort)
+{
+    std::unique_ptr<AudioFormatReader> reader(formatManager.createReaderFor(audioURL.createInputStream(false)));
+
+    if (reader == nullptr || reader->sampleRate <= 0 || reader->lengthInSamples <= 0)
+        return nullptr;
+
+    auto overview = std::make_shared<Overview>();
+    overview->sampleRate = reader->sampleRate;
+    overview->lengthInSamples = reader->lengthInSamples;
+
+    Level base;
+    base.samplesPerPeak = baseSamplesPerPeak;
+    base.peaks.reserve(static_cast<size_t>(reader->lengthInSamples / baseSamplesPerPeak + 1));
+
+    // Decode in large blocks, every block holds a whole number of peaks
+    constexpr int blockSize = baseSamplesPerPeak * 512;
+    const int numChannels = reader->numChannels > 1 ? 2 : 1;
+    AudioBuffer<float> block(numChannels, blockSize);
+
+    // The mono mix is split into bands with a low pass and a high pass, mid is the remainder
+    AudioBuffer<float> bands(3, blockSize);
+    IIRFilter lowFilter, highFilter;
+    lowFilter.setCoefficients(IIRCoefficients::makeLowPass(reader->sampleRate, 200.0));
+    highFilter.setCoefficients(IIRCoefficients::makeHighPass(reader->sampleRate, 2000.0));
+
+    auto quantiseRms = [](double sumOfSquares, int count)
+    {
+        return static_cast<juce::uint8>(jlimit(0, 255, roundToInt(std::sqrt(sumOfSquares / count) * 255.0)));
+    };
+
+    auto sumOfSquares = [](const float* samples, int count)
+    {
+        double sum = 0.0;
+
+        for (int i = 0; i < count; ++i)
+            sum += samples[i] * samples[i];
+
+        return sum;
+    };
+
+    for (juce::int64 start = 0; start < reader->lengthInSamples; start += blockSize)
+    {
+        if (shouldAbort != nullptr && shouldAbort())
+            return nullptr;
+
+        const int numSamples = static_cast<int>(jmin<juce::int64>(blockSize, reader->lengthInSamples - start));
+        reader->read(&block, 0, numSamples, start, true, numChannels > 1);
+
+        float* low = bands.getWritePointer(0);
+        float* mid = bands.getWritePointer(1);
+        float* high = bands.getWritePointer(2);
+
+        FloatVectorOperations::copyWithMultiply(mid, block.getReadPointer(0), 1.0f / numChannels, numSamples);
+
+        if (numChannels > 1)
+            FloatVectorOperations::addWithMultiply(mid, block.getReadPointer(1), 0.5f, numSamples);
+
+        FloatVectorOperations::copy(low, mid, numSamples);
+        FloatVectorOperations::copy(high, mid, numSamples);
+        lowFilter.processSamples(low, numSamples);
+        highFilter.processSamples(high, numSamples);
+        FloatVectorOperations::subtract(mid, low, numSamples);
+        FloatVectorOperations::subtract(mid, high, numSamples);
+
+        for (int offset = 0; offset < numSamples; offset += baseSamplesPerPeak)
+        {
+            const int span = jmin(baseSamplesPerPeak, numSamples - offset);
+            float minimum = 0.0f, maximum = 0.0f;
+            double signalSquares = 0.0;
+
+            for (int channel = 0; channel < numChannels; ++channel)
+            {
+                const float* samples = block.getReadPointer(channel, offset);
+                auto range = FloatVectorOperations::findMinAndMax(samples, span);
+                minimum = jmin(minimum, range.getStart());
+                maximum = jmax(maximum, range.getEnd());
+                signalSquares += sumOfSquares(samples, span);
+            }
+
+            Peak peak;
+            peak.minimum = static_cast<juce::int8>(jlimit(-127, 127, roundToInt(minimum * 127.0f)));
+            peak.maximum = static_cast<juce::int8>(jlimit(-127, 127, roundToInt(maximum * 127.0f)));
+            peak.rms = quantiseRms(signalSquares, span * numChannels);
+            peak.low = quantiseRms(sumOfSquares(low + offset, span), span);
+            peak.mid = quantiseRms(sumOfSquares(mid + offset, span), span);
+            peak.high = quantiseRms(sumOfSquares(high + offset, span), span);
+            base.peaks.push_back(peak);
+        }
+    }
+
+    overview->levels.push_back(std::move(base));
+
+    // Each coarser level merges pairs of peaks from the level below
+    auto mergeRms = [](juce::uint8 a, juce::uint8 b)
+    {
+        return static_cast<juce::uint8>(roundToInt(std::sqrt((a * a + b * b) * 0.5)));
+    };
+
+    while (overview->levels.back().peaks.size() > 256)
+    {
+        const Level& finer = overview->levels.back();
+
+        Level coarser;
+        coarser.samplesPerPeak = finer.samplesPerPeak * 2;
+        coarser.peaks.reserve((finer.peaks.size() + 1) / 2);
+
+        for (size_t i = 0; i < finer.peaks.size(); i += 2)
+        {
+            const Peak& a = finer.peaks[i];
+            const Peak& b = i + 1 < finer.peaks.size() ? finer.peaks[i + 1] : a;
+
+            Peak merged;
+            merged.minimum = jmin(a.minimum, b.minimum);
+            merged.maximum = jmax(a.maximum, b.maximum);
+            merged.rms = mergeRms(a.rms, b.rms);
+            merged.low = mergeRms(a.low, b.low);
+            merged.mid = mergeRms(a.mid, b.mid);
+            merged.high = mergeRms(a.high, b.high);
+            coarser.peaks.push_back(merged);
+        }
+
+        overview->levels.push_back(std::move(coarser));
+    }
+
+    return overview;
+}
+
+bool WaveformCache::save(const juce::File& file, const Overview& overview)
+{
+    if (!file.getParentDirectory().createDirectory())
+        return false;
+
+    TemporaryFile tempFile(file);
+
+    {
+        FileOutputStream stream(tempFile.getFile());
+
+        if (!stream.openedOk())
+        {
+            DBG("WaveformCache::save could not open " << tempFile.getFile().getFullPathName());
+            return false;
+        }
+
+        // Header
+        stream.writeInt(magicNumber);
+        stream.writeInt(formatVersion);
+        stream.writeInt64(overview.contentHash);
+        stream.writeDouble(overview.sampleRate);
+        stream.writeInt64(overview.lengthInSamples);
+        stream.writeInt(static_cast<int>(overview.levels.size()));
+
+        // Levels, finest first, peaks as packed bytes
+        for (const auto& level : overview.levels)
+        {
+            stream.writeInt(level.samplesPerPeak);
+            stream.writeInt(static_cast<int>(level.peaks.size()));
+            stream.write(level.peaks.data(), level.peaks.size() * sizeof(Peak));
+        }
+
+        stream.flush();
+
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
+
+std::shared_ptr<WaveformCache::Overview> WaveformCache::load(const juce::File& file, juce::int64 contentHash)
+{
+    MemoryMappedFile mappedFile(file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr)
+        return nullptr;
+
+    MemoryInputStream stream(mappedFile.getData(), mappedFile.getSize(), false);
+
+    if (stream.readInt() != magicNumber || stream.readInt() != formatVersion)
+    {
+        DBG("WaveformCache::load unsupported overview " << file.getFullPathName());
+        return nullptr;
+    }
+
+    auto overview = std::make_shared<Overview>();
+    overview->contentHash = stream.readInt64();
+    overview->sampleRate = stream.readDouble();
+    overview->lengthInSamples = stream.readInt64();
+
+    if (overview->contentHash != contentHash || overview->sampleRate <= 0.0)
+        return nullptr;
+
+    const int numLevels = stream.readInt();
+
+    if (numLevels <= 0 || numLevels > 64)
+        return nullptr;
+
+    for (int i = 0; i < numLevels; ++i)
+    {
+        Level level;
+        level.samplesPerPeak = stream.readInt();
+        const int numPeaks = stream.readInt();
+        const size_t numBytes = static_cast<size_t>(jmax(0, numPeaks)) * sizeof(Peak);
+
+        if (level.samplesPerPeak <= 0 || numPeaks <= 0 || stream.getNumBytesRemaining() < (juce::int64) numBytes)
+            return nullptr;
+
+        level.peaks.resize(static_cast<size_t>(numPeaks));
+        stream.read(level.peaks.data(), static_cast<int>(numBytes));
+        overview->levels.push_back(std::move(level));
+    }
+
+    return overview;
+}
+
+juce::File WaveformCache::getDefaultDirectory()
+{
+    return juce::File::getCurrentWorkingDirectory().getChildFile("WaveformCache");
+}
+
+juce::File WaveformCache::getCacheFileFor(juce::int64 contentHash) const
+{
+    return cacheDirectory.getChildFile(juce::String::toHexString(contentHash) + ".peaks");
+}
+
+void WaveformCache::addResult(const juce::URL& audioURL, std::shared_ptr<const Overview> overview)
+{
+    {
+        const ScopedLock sl(resultLock);
+        finishedResults.emplace_back(audioURL, std::move(overview));
+    }
+
+    triggerAsyncUpdate();
+}
+
+void WaveformCache::handleAsyncUpdate()
+{
+    std::vector<std::pair<juce::URL, std::shared_ptr<const Overview>>> results;
+
+    {
+        const ScopedLock sl(resultLock);
+        results.swap(finishedResults);
+    }
+
+    for (auto& result : results)
+    {
+        const juce::String key = result.first.toString(false);
+        pendingRequests.erase(key);
+
+        if (result.second == nullptr)
+        {
+            DBG("WaveformCache could not read " << key);
+            continue;
+        }
+
+        // Keep the most recent overviews so reloading a track is instant
+        if (recentOverviews.find(key) == recentOverviews.end())
+            recentOrder.add(key);
+
+        recentOverviews[key] = result.second;
+
+        while (recentOrder.size() > (int) maxRecentOverviews)
+        {
+            recentOverviews.erase(recentOrder[0]);
+            recentOrder.remove(0);
+        }
+
+        listeners.call([&](Listener& l) { l.waveformReady(result.first, result.second); });
+    }
+}
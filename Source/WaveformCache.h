@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+    WaveformCache.h
+    Created: 19 Oct 2026 3:42:18pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * The WaveformCache class keeps waveform overviews on disk so they do not
+ * have to be recomputed every time the application starts.
+ *
+ * An overview is a pyramid of min/max/RMS peaks with per-band levels. The finest level has one peak
+ * per baseSamplesPerPeak samples, and each coarser level halves the one below,
+ * so any zoom can be drawn from about one peak per pixel. Files are keyed by the
+ * track's content hash. Missing overviews are generated on a worker thread, and
+ * finished overviews are handed to the listeners on the message thread.
+ */
+class WaveformCache : private AsyncUpdater
+{
+public:
+    /**
+     * One quantised peak: the signal range and RMS level of a span of samples,
+     * plus the RMS level of its low (below 200 Hz), mid and high (above 2 kHz) bands.
+     */
+    struct Peak
+    {
+        juce::int8 minimum = 0;
+        juce::int8 maximum = 0;
+        juce::uint8 rms = 0;
+        juce::uint8 low = 0;
+        juce::uint8 mid = 0;
+        juce::uint8 high = 0;
+    };
+
+    /**
+     * One zoom level of the pyramid.
+     */
+    struct Level
+    {
+        int samplesPerPeak = 0;
+        std::vector<Peak> peaks;
+    };
+
+    /**
+     * The complete overview of one track.
+     */
+    struct Overview
+    {
+        juce::int64 contentHash = 0;
+        double sampleRate = 0.0;
+        juce::int64 lengthInSamples = 0;
+
+        /**
+         * The levels, finest first.
+         */
+        std::vector<Level> levels;
+
+        /**
+         * Pick the coarsest level that still has at least one peak per pixel.
+         *
+         * @param samplesPerPixel The number of source samples covered by one pixel.
+         * @return                The level to draw from, or nullptr if there are none.
+         */
+        const Level* getLevelFor(double samplesPerPixel) const;
+
+        /**
+         * Get the length of the track.
+         *
+         * @return The length in seconds.
+         */
+        double getLengthInSeconds() const;
+    };
+
+    /**
+     * Receives finished overviews on the message thread.
+     */
+    class Listener
+    {
+    public:
+        virtual ~Listener() = default;
+
+        /**
+         * Called when the overview of a requested track is available.
+         *
+         * @param audioURL The URL that was requested.
+         * @param overview The overview of that track.
+         */
+        virtual void waveformReady(const juce::URL& audioURL, std::shared_ptr<const Overview> overview) = 0;
+    };
+
+    /**
+     * The number of samples summarised by each peak of the finest level.
+     */
+    static constexpr int baseSamplesPerPeak = 128;
+
+    /**
+     * Constructor for WaveformCache.
+     *
+     * @param _formatManager  Reference to the AudioFormatManager used to decode tracks.
+     * @param _cacheDirectory The directory the overview files are kept in.
+     */
+    WaveformCache(AudioFormatManager& _formatManager, const juce::File& _cacheDirectory = getDefaultDirectory());
+
+    /**
+     * Destructor for WaveformCache. Abandons unfinished jobs.
+     */
+    ~WaveformCache() override;
+
+    /**
+     * Register a listener for finished overviews.
+     *
+     * @param listener The listener to add.
+     */
+    void addListener(Listener* listener);
+
+    /**
+     * Unregister a listener.
+     *
+     * @param listener The listener to remove.
+     */
+    void removeListener(Listener* listener);
+
+    /**
+     * Ask for the overview of a track. Recently used overviews are delivered
+     * straight away, others are read from disk or generated in the background.
+     *
+     * @param audioURL The URL of the audio file.
+     */
+    void request(const juce::URL& audioURL);
+
+    /**
+     * Decode a track and build its overview on the calling thread.
+     *
+     * @param formatManager The AudioFormatManager used to decode the track.
+     * @param audioURL      The URL of the audio file.
+     * @param shouldAbort   Optional check, polled between blocks, that abandons the scan.
+     * @return              The overview, or nullptr if the track cannot be read or the scan was abandoned.
+     */
+    static std::shared_ptr<Overview> generate(AudioFormatManager& formatManager, const juce::URL& audioURL,
+                                              const std::function<bool()>& shouldAbort = nullptr);
+
+    /**
+     * Write an overview to disk.
+     *
+     * @param file     The file to write.
+     * @param overview The overview to store.
+     * @return         True if the file was written.
+     */
+    static bool save(const juce::File& file, const Overview& overview);
+
+    /**
+     * Read an overview from disk.
+     *
+     * @param file         The file to read.
+     * @param contentHash  The content hash the overview must belong to.
+     * @return             The overview, or nullptr if the file is missing, stale or corrupt.
+     */
+    static std::shared_ptr<Overview> load(const juce::File& file, juce::int64 contentHash);
+
+    /**
+     * Get the default cache directory, next to the playlist files.
+     *
+     * @return The WaveformCache directory in the current working directory.
+     */
+    static juce::File getDefaultDirectory();
+
+private:
+    class OverviewJob;
+
+    /**
+     * Get the file an overview is stored in.
+     *
+     * @param contentHash The content hash of the track.
+     * @return            The overview file.
+     */
+    juce::File getCacheFileFor(juce::int64 contentHash) const;
+
+    /**
+     * Store a finished overview and schedule its delivery. Called from worker threads.
+     */
+    void addResult(const juce::URL& audioURL, std::shared_ptr<const Overview> overview);
+
+    /**
+     * Deliver finished overviews to the listeners on the message thread.
+     */
+    void handleAsyncUpdate() override;
+
+    static constexpr int magicNumber = 0x4346574f; // "OWFC"
+    static constexpr int formatVersion = 2;
+
+    /**
+     * The number of overviews kept in memory.
+     */
+    static constexpr size_t maxRecentOverviews = 16;
+
+    AudioFormatManager& formatManager;
+    juce::File cacheDirectory;
+
+    ListenerList<Listener> listeners;
+
+    /**
+     * Recently delivered overviews by URL, oldest first in recentOrder. Message thread only.
+     */
+    std::unordered_map<juce::String, std::shared_ptr<const Overview>> recentOverviews;
+    StringArray recentOrder;
+
+    /**
+     * URLs with a job queued or running. Message thread only.
+     */
+    std::unordered_set<juce::String> pendingRequests;
+
+    /**
+     * Finished jobs waiting to be delivered, guarded by resultLock.
+     */
+    CriticalSection resultLock;
+    std::vector<std::pair<juce::URL, std::shared_ptr<const Overview>>> finishedResults;
+
+    ThreadPool pool{ 2 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(WaveformCache)
+};
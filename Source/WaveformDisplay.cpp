@@ -1,90 +1,183 @@
-/*
-  ==============================================================================
-
-    WaveformDisplay.cpp
-    Created: 31 Jan 2024 2:14:44pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#include <JuceHeader.h>
-#include "WaveformDisplay.h"
-
-//==============================================================================
-WaveformDisplay::WaveformDisplay(AudioFormatManager& formatManagerToUse,
-                                 AudioThumbnailCache& cacheToUse,
-                                 bool isDeck1) :
-                                 audioThumb(1000, formatManagerToUse, cacheToUse),
-                                 isDeck1(isDeck1),
-                                 // "file not loaded" is not being printed,
-                                 // thus adding fileLoaded(false)
-                                 fileLoaded(false),
-                                 position(0)
-{
-    audioThumb.addChangeListener(this);
-}
-
-WaveformDisplay::~WaveformDisplay()
-{
-}
-
-void WaveformDisplay::paint (juce::Graphics& g)
-{
-    g.fillAll(getLookAndFeel().findColour(
-        juce::ResizableWindow::backgroundColourId));   // clear the background
-
-    g.setColour(juce::Colours::grey);
-    g.drawRect(getLocalBounds(), 1);   // draw an outline around the component
-
-    if (fileLoaded)
-    {
-        if (isDeck1)
-            g.setColour(Colours::orange);
-        else
-            g.setColour(Colours::deepskyblue);
-
-        audioThumb.drawChannel(g, getLocalBounds(), 0, 
-            audioThumb.getTotalLength(), 0, 1.0f);
-    }
-    else
-    {
-        if (isDeck1)
-            g.setColour(Colours::orange.withAlpha(0.5f));
-        else
-            g.setColour(Colours::deepskyblue.withAlpha(0.7f).brighter());
-
-        g.setFont(Font(20.0f).withTypefaceStyle("Bold"));
-        
-        g.drawText("Load Music Files :3", getLocalBounds(),
-            juce::Justification::centred, true);   // draw some placeholder text
-    }
-}
-
-void WaveformDisplay::resized()
-{
-    // This method is where you should set the bounds of any child
-    // components that your component contains..
-
-}
-
-void WaveformDisplay::loadURL(URL audioURL) {
-    DBG("WaveformDisplay::loadURL");
-
-    // clear any existing data it holds
-    audioThumb.clear();
-    fileLoaded = audioThumb.setSource(new URLInputSource(audioURL));
-}
-
-void WaveformDisplay::changeListenerCallback(ChangeBroadcaster *source){
-    DBG("wfd: change received!");
-    repaint();
-}
-
-// set position as isnan to prevent activation of breakpoint
-void WaveformDisplay::setPositionRelative(double pos) {
-    if (pos != position && !isnan(pos)) {
-        position = pos;
-        repaint();
-    }
+/*
+  ==============================================================================
+
+    WaveformDisplay.cpp
+    Created: 31 Jan 2024 2:14:44pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "WaveformDisplay.h"
+
+//==============================================================================
+WaveformDisplay::WaveformDisplay(WaveformCache& cacheToUse,
+                                 bool isDeck1) :
+                                 waveformCache(cacheToUse),
+                                 isDeck1(isDeck1),
+                                 // "file not loaded" is not being printed,
+                                 // thus adding fileLoaded(false)
+                                 fileLoaded(false),
+                                 position(0)
+{
+    waveformCache.addListener(this);
+}
+
+WaveformDisplay::~WaveformDisplay()
+{
+    waveformCache.removeListener(this);
+}
+
+void WaveformDisplay::paint (juce::Graphics& g)
+{
+    g.fillAll(getLookAndFeel().findColour(
+        juce::ResizableWindow::backgroundColourId));   // clear the background
+
+    g.setColour(juce::Colours::grey);
+    g.drawRect(getLocalBounds(), 1);   // draw an outline around the component
+
+    if (fileLoaded)
+    {
+        if (overview != nullptr)
+        {
+            // The overview only changes with the track or the size, so it is drawn once into an image
+            if (overviewImage.getWidth() != getWidth() || overviewImage.getHeight() != getHeight())
+                renderOverview();
+
+            g.drawImageAt(overviewImage, 0, 0);
+
+            // Loop overlay
+            if (loopEnd > loopStart)
+            {
+                const int startX = roundToInt(jlimit(0.0, 1.0, loopStart) * getWidth());
+                const int endX = roundToInt(jlimit(0.0, 1.0, loopEnd) * getWidth());
+                g.setColour(Colours::white.withAlpha(0.2f));
+                g.fillRect(startX, 0, jmax(1, endX - startX), getHeight());
+            }
+
+            // Playhead overlay
+            g.setColour(Colours::white);
+            g.fillRect(getPlayheadX(), 0, 2, getHeight());
+        }
+    }
+    else
+    {
+        if (isDeck1)
+            g.setColour(Colours::orange.withAlpha(0.5f));
+        else
+            g.setColour(Colours::deepskyblue.withAlpha(0.7f).brighter());
+
+        g.setFont(Font(20.0f).withTypefaceStyle("Bold"));
+        
+        g.drawText("Load Music Files :3", getLocalBounds(),
+            juce::Justification::centred, true);   // draw some placeholder text
+    }
+}
+
+void WaveformDisplay::resized()
+{
+    // This method is where you should set the bounds of any child
+    // components that your component contains..
+
+    // The overview image is redrawn at the new size on the next paint
+    overviewImage = Image();
+}
+
+void WaveformDisplay::renderOverview()
+{
+    overviewImage = Image(Image::ARGB, jmax(1, getWidth()), jmax(1, getHeight()), true);
+    Graphics g(overviewImage);
+
+    const Colour peakColour = isDeck1 ? Colours::orange : Colours::deepskyblue;
+    const Colour rmsColour = peakColour.brighter(0.6f);
+
+    // One peak per pixel or more, taken from the matching level of the pyramid
+    const auto* level = overview->getLevelFor(
+        static_cast<double>(overview->lengthInSamples) / overviewImage.getWidth());
+
+    if (level == nullptr)
+        return;
+
+    const double peaksPerPixel = static_cast<double>(level->peaks.size()) / overviewImage.getWidth();
+    const float midY = overviewImage.getHeight() * 0.5f;
+    const float scale = midY / 127.0f;
+
+    for (int x = 0; x < overviewImage.getWidth(); ++x)
+    {
+        const size_t first = static_cast<size_t>(x * peaksPerPixel);
+        const size_t last = jmin(level->peaks.size(), jmax(first + 1, static_cast<size_t>((x + 1) * peaksPerPixel)));
+
+        int minimum = 0, maximum = 0, rms = 0;
+
+        for (size_t i = first; i < last; ++i)
+        {
+            minimum = jmin(minimum, (int) level->peaks[i].minimum);
+            maximum = jmax(maximum, (int) level->peaks[i].maximum);
+            rms = jmax(rms, (int) level->peaks[i].rms);
+        }
+
+        g.setColour(peakColour);
+        g.drawVerticalLine(x, midY - maximum * scale, midY - minimum * scale + 1.0f);
+
+        // RMS is stored on a 0..255 scale
+        const float rmsHeight = rms * 0.5f * scale;
+        g.setColour(rmsColour);
+        g.drawVerticalLine(x, midY - rmsHeight, midY + rmsHeight + 1.0f);
+    }
+}
+
+int WaveformDisplay::getPlayheadX() const
+{
+    return roundToInt(jlimit(0.0, 1.0, position) * (getWidth() - 2));
+}
+
+void WaveformDisplay::loadURL(URL audioURL) {
+    DBG("WaveformDisplay::loadURL");
+
+    // clear any existing data it holds, the overview arrives through waveformReady
+    currentURL = audioURL;
+    overview.reset();
+    overviewImage = Image();
+    fileLoaded = true;
+    repaint();
+
+    waveformCache.request(audioURL);
+}
+
+void WaveformDisplay::waveformReady(const URL& audioURL, std::shared_ptr<const WaveformCache::Overview> newOverview)
+{
+    // The cache is shared by both decks, ignore overviews of the other deck's track
+    if (audioURL != currentURL)
+        return;
+
+    DBG("wfd: overview received!");
+    overview = std::move(newOverview);
+    overviewImage = Image();
+    repaint();
+}
+
+void WaveformDisplay::setLoopRelative(double start, double end)
+{
+    if (start != loopStart || end != loopEnd)
+    {
+        loopStart = start;
+        loopEnd = end;
+        repaint();
+    }
+}
+
+// set position as isnan to prevent activation of breakpoint
+void WaveformDisplay::setPositionRelative(double pos) {
+    if (pos != position && !isnan(pos)) {
+        const int oldX = getPlayheadX();
+        position = pos;
+        const int newX = getPlayheadX();
+
+        // Only the strips under the old and new playhead need repainting
+        if (newX != oldX) {
+            repaint(oldX, 0, 2, getHeight());
+            repaint(newX, 0, 2, getHeight());
+        }
+    }
 }
\ No newline at end of file
@@ -1,96 +1,138 @@
-/*
-  ==============================================================================
-
-    WaveformDisplay.h
-    Created: 31 Jan 2024 2:14:44pm
-    Author:  arcsl
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-//==============================================================================
-/**
- * The WaveformDisplay class represents a graphical display of an audio waveform.
- * It utilizes the JUCE library's AudioThumbnail to visualize the waveform.
- */
-class WaveformDisplay  : public juce::Component,
-                         public ChangeListener
-{
-public:
-    /**
-    * Constructor for WaveformDisplay.
-    *
-    * @param formatManagerToUse Reference to the AudioFormatManager.
-    * @param cacheToUse Reference to the AudioThumbnailCache.
-    */
-    WaveformDisplay(AudioFormatManager& formatManagerToUse,
-        AudioThumbnailCache& cacheToUse,
-        bool isDeck1);
-
-    /**
-     * Destructor for WaveformDisplay.
-     */
-    ~WaveformDisplay() override;
-
-    /**
-     * Paints the graphical user interface of the WaveformDisplay.
-     *
-     * @param g The Graphics object used for rendering.
-     */
-    void paint (juce::Graphics&) override;
-
-    /**
-     * Called when the size of the WaveformDisplay is changed.
-     * Adjusts the size and position of the components to fit the new dimensions.
-     */
-    void resized() override;
-
-    /**
-     * Callback function for change events in the audio thumbnail.
-     *
-     * @param source Pointer to the ChangeBroadcaster that triggered the change.
-     */
-    void changeListenerCallback(ChangeBroadcaster* source) override;
-
-    /**
-     * Load an audio file from a URL and update the waveform display.
-     *
-     * @param audioURL The URL of the audio file to be loaded.
-     */
-    void loadURL(URL audioURL);
-
-    /**
-     * Set the playhead position relative to the audio waveform.
-     *
-     * @param pos The relative position of the playhead (0.0 to 1.0).
-     */
-    void setPositionRelative(double pos);
-
-private:
-    /**
-     * The AudioThumbnail object used to visualize the audio waveform in the WaveformDisplay.
-     */
-    AudioThumbnail audioThumb;
-
-    /**
-     * A flag indicating whether an audio file has been successfully loaded into the WaveformDisplay.
-     */
-    bool fileLoaded;
-
-    /**
-     * The relative position of the playhead within the loaded audio file.
-     */
-    double position;
-
-    /**
-     * A boolean flag indicating the type of deck.
-     * If true, it represents Deck 1; if false, it represents Deck 2.
-     */
-    bool isDeck1;
-
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformDisplay)
-};
+/*
+  ==============================================================================
+
+    WaveformDisplay.h
+    Created: 31 Jan 2024 2:14:44pm
+    Author:  arcsl
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "WaveformCache.h"
+
+//==============================================================================
+/**
+ * The WaveformDisplay class represents a graphical display of an audio waveform.
+ * It draws the min/max peak overview provided by the shared WaveformCache into a
+ * cached image, with the playhead drawn on top.
+ */
+class WaveformDisplay  : public juce::Component,
+                         public WaveformCache::Listener
+{
+public:
+    /**
+    * Constructor for WaveformDisplay.
+    *
+    * @param cacheToUse Reference to the WaveformCache providing the overviews.
+    */
+    WaveformDisplay(WaveformCache& cacheToUse,
+        bool isDeck1);
+
+    /**
+     * Destructor for WaveformDisplay.
+     */
+    ~WaveformDisplay() override;
+
+    /**
+     * Paints the graphical user interface of the WaveformDisplay.
+     *
+     * @param g The Graphics object used for rendering.
+     */
+    void paint (juce::Graphics&) override;
+
+    /**
+     * Called when the size of the WaveformDisplay is changed.
+     * Adjusts the size and position of the components to fit the new dimensions.
+     */
+    void resized() override;
+
+    /**
+     * Callback function for overviews finished by the waveform cache.
+     *
+     * @param audioURL The URL the overview belongs to.
+     * @param newOverview The overview of that track.
+     */
+    void waveformReady(const URL& audioURL, std::shared_ptr<const WaveformCache::Overview> newOverview) override;
+
+    /**
+     * Load an audio file from a URL and update the waveform display.
+     *
+     * @param audioURL The URL of the audio file to be loaded.
+     */
+    void loadURL(URL audioURL);
+
+    /**
+     * Set the playhead position relative to the audio waveform.
+     *
+     * @param pos The relative position of the playhead (0.0 to 1.0).
+     */
+    void setPositionRelative(double pos);
+
+    /**
+     * Set the loop drawn over the waveform, relative to the length of the track.
+     *
+     * @param start The relative position of the loop start (0.0 to 1.0).
+     * @param end   The relative position of the loop end, not after the start when there is no loop.
+     */
+    void setLoopRelative(double start, double end);
+
+private:
+    /**
+     * Draw the whole overview into overviewImage at the current size.
+     */
+    void renderOverview();
+
+    /**
+     * Get the horizontal position of the playhead.
+     *
+     * @return The x coordinate of the playhead's left edge.
+     */
+    int getPlayheadX() const;
+
+    /**
+     * The shared cache the overviews are requested from.
+     */
+    WaveformCache& waveformCache;
+
+    /**
+     * The URL of the track currently shown.
+     */
+    URL currentURL;
+
+    /**
+     * The overview of the current track, or nullptr until it is ready.
+     */
+    std::shared_ptr<const WaveformCache::Overview> overview;
+
+    /**
+     * The overview rendered at the component's size, empty when it must be redrawn.
+     */
+    Image overviewImage;
+
+    /**
+     * A flag indicating whether an audio file has been successfully loaded into the WaveformDisplay.
+     */
+    bool fileLoaded;
+
+    /**
+     * The relative position of the playhead within the loaded audio file.
+     */
+    double position;
+
+    /**
+     * The relative positions of the loop shown over the waveform.
+     */
+    double loopStart = 0.0;
+    double loopEnd = 0.0;
+
+    /**
+     * A boolean flag indicating the type of deck.
+     * If true, it represents Deck 1; if false, it represents Deck 2.
+     */
+    bool isDeck1;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WaveformDisplay)
+};